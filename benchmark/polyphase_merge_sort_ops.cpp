@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <merge_sort.hpp>
+#include <optional>
+#include <polyphase_merge_sort.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+// Tape operations of MergeSort and PolyphaseMergeSort sorting the same input
+// on memory tapes. MergeSort takes four temporary tapes, polyphase merge sort
+// takes tapesCnt working tapes with the output one.
+
+namespace {
+
+constexpr auto inFilename = "polyphase_merge_sort_ops_in";
+constexpr auto outFilename = "polyphase_merge_sort_ops_out";
+constexpr auto tmpDirectory = "polyphase_merge_sort_ops_tmp";
+constexpr std::size_t defaultCellsCnt = 1 << 16;
+constexpr std::size_t defaultTapesCnt = 3;
+
+TapePool::IOStatistics sort(const std::vector<std::int32_t>& values,
+                            std::optional<std::size_t> tapesCnt) {
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  {
+    auto inTape = tapePool.createTape(inFilename, values.size());
+    copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+    inTape.seek(0);
+  }
+  const auto before = tapePool.getStatistics();
+  if (tapesCnt.has_value()) {
+    PolyphaseMergeSort(tapePool, inFilename, tmpDirectory, true, *tapesCnt)
+        .perform(outFilename);
+  } else {
+    MergeSort(tapePool, inFilename, tmpDirectory, true).perform(outFilename);
+  }
+  auto stats = tapePool.getStatistics();
+  stats.readCnt -= before.readCnt;
+  stats.writeCnt -= before.writeCnt;
+  stats.moveCnt -= before.moveCnt;
+  return stats;
+}
+
+void printStats(const std::string& name,
+                const TapePool::IOStatistics& stats) {
+  std::cout << name << "\treads: " << stats.readCnt
+            << "\twrites: " << stats.writeCnt << "\tmoves: " << stats.moveCnt
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const std::size_t cellsCnt =
+      (argc > 1) ? std::stoull(argv[1]) : defaultCellsCnt;  // NOLINT
+  const std::size_t tapesCnt =
+      (argc > 2) ? std::stoull(argv[2]) : defaultTapesCnt;  // NOLINT
+
+  auto generator = std::mt19937(42);  // NOLINT
+  auto values = std::vector<std::int32_t>(cellsCnt);
+  for (auto& value : values) {
+    value = static_cast<std::int32_t>(generator());
+  }
+
+  std::cout << "Cells:\t\t" << cellsCnt << std::endl;
+  printStats("MergeSort (4 tmp tapes):\t\t", sort(values, std::nullopt));
+  printStats("PolyphaseMergeSort (" + std::to_string(tapesCnt) +
+                 " working tapes):",
+             sort(values, tapesCnt));
+  std::filesystem::remove_all(tmpDirectory);
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tape.hpp>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+// Sequential write and read scans over a file tape without a read window or
+// a write buffer. Every cell access reaches the stream. The file tape backend
+// used to seek before each one, that path is replayed on a plain stream for
+// comparison. File seeks are counted by the backend, lseek system calls by
+// wrappers below.
+
+namespace {
+
+constexpr auto filename = "sequential_scan_seeks_tape";
+constexpr std::size_t defaultCellsCnt = 1 << 20;
+constexpr std::size_t cellSize = sizeof(std::int32_t);
+
+std::atomic<std::size_t> lseekCnt{0};
+
+struct ScanResult {
+  std::size_t streamSeekCnt;
+  std::size_t lseekCnt;
+  double elapsed;
+  std::int64_t checksum;
+};
+
+/// Scan as the file tape backend did before: a seek before every access.
+ScanResult scanAlwaysSeeking(std::size_t cellsCnt) {
+  std::filesystem::remove(filename);
+  const std::size_t lseekCntBefore = lseekCnt;
+  const auto start = std::chrono::steady_clock::now();
+  auto ret = ScanResult{};
+  {
+    auto file = std::fstream(filename, std::ios_base::in | std::ios_base::out |
+                                           std::ios_base::trunc |
+                                           std::ios_base::binary);
+    std::filesystem::resize_file(filename, cellsCnt * cellSize);
+    for (std::size_t i = 0; i < cellsCnt; ++i) {
+      const auto cell = static_cast<std::int32_t>(i);
+      file.seekp(static_cast<std::streamoff>(i * cellSize));
+      file.write(reinterpret_cast<const char*>(&cell), cellSize);  // NOLINT
+      ++ret.streamSeekCnt;
+    }
+    for (std::size_t i = 0; i < cellsCnt; ++i) {
+      auto cell = std::int32_t{};
+      file.seekg(static_cast<std::streamoff>(i * cellSize));
+      file.read(reinterpret_cast<char*>(&cell), cellSize);  // NOLINT
+      ++ret.streamSeekCnt;
+      ret.checksum += cell;
+    }
+  }
+  ret.elapsed = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  ret.lseekCnt = lseekCnt - lseekCntBefore;
+  std::filesystem::remove(filename);
+  return ret;
+}
+
+/// Scan through a file tape, which seeks only when the stream is elsewhere.
+ScanResult scanTape(std::size_t cellsCnt) {
+  std::filesystem::remove(filename);
+  const std::size_t lseekCntBefore = lseekCnt;
+  const auto start = std::chrono::steady_clock::now();
+  auto ret = ScanResult{};
+  {
+    auto tape = Tape(filename, cellsCnt, TapeBackendType::File, 0, 0);
+    for (std::size_t i = 0; i < cellsCnt; ++i) {
+      tape.write(static_cast<std::int32_t>(i));
+      if (i + 1 != cellsCnt) {
+        tape.moveRight();
+      }
+    }
+    for (std::size_t i = 0; i + 1 < cellsCnt; ++i) {
+      tape.moveLeft();
+    }
+    for (std::size_t i = 0; i < cellsCnt; ++i) {
+      ret.checksum += tape.read();
+      if (i + 1 != cellsCnt) {
+        tape.moveRight();
+      }
+    }
+    ret.streamSeekCnt = tape.getCacheStatistics().seekCnt;
+  }
+  ret.elapsed = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  ret.lseekCnt = lseekCnt - lseekCntBefore;
+  std::filesystem::remove(filename);
+  return ret;
+}
+
+void print(const std::string& name, const ScanResult& result) {
+  std::cout << name << std::endl;
+  std::cout << "  File seeks:\t" << result.streamSeekCnt << std::endl;
+#ifdef __linux__
+  std::cout << "  lseek calls:\t" << result.lseekCnt << std::endl;
+#endif
+  std::cout << "  Elapsed:\t" << result.elapsed << " s" << std::endl;
+  std::cout << "  Checksum:\t" << result.checksum << std::endl;
+}
+
+}  // namespace
+
+#ifdef __linux__
+// File streams reach the system through these, the next definitions are the
+// ones of the C library.
+
+extern "C" off_t lseek(int fd, off_t offset, int whence) {
+  static auto* const next =
+      reinterpret_cast<off_t (*)(int, off_t, int)>(  // NOLINT
+          ::dlsym(RTLD_NEXT, "lseek"));
+  ++lseekCnt;
+  return next(fd, offset, whence);
+}
+
+extern "C" off64_t lseek64(int fd, off64_t offset, int whence) {
+  static auto* const next =
+      reinterpret_cast<off64_t (*)(int, off64_t, int)>(  // NOLINT
+          ::dlsym(RTLD_NEXT, "lseek64"));
+  ++lseekCnt;
+  return next(fd, offset, whence);
+}
+#endif
+
+int main(int argc, char* argv[]) {
+  const std::size_t cellsCnt =
+      (argc > 1) ? std::stoull(argv[1]) : defaultCellsCnt;  // NOLINT
+
+  const auto before = scanAlwaysSeeking(cellsCnt);
+  const auto after = scanTape(cellsCnt);
+
+  std::cout << "Cells:\t\t" << cellsCnt << std::endl;
+  std::cout << "Cell accesses:\t" << 2 * cellsCnt << std::endl;
+  print("Seek before every access (before):", before);
+  print("Seek only on a jump (after):", after);
+  return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef APP_RECORD_HPP
+#define APP_RECORD_HPP
+
+#include <keyed_record.hpp>
+
+/// Record of record tapes: 8-byte key and 56-byte payload.
+using AppRecord = KeyedRecord<56>;
+
+#endif
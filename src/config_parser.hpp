@@ -1,3 +1,6 @@
+#ifndef CONFIG_PARSER_HPP
+#define CONFIG_PARSER_HPP
+
 #include <fstream>
 #include <sstream>
 #include <string_view>
@@ -37,4 +40,6 @@ class ConfigParser {
 
  public:
   std::ifstream txtFile_;
-};
\ No newline at end of file
+};
+
+#endif  // CONFIG_PARSER_HPP
@@ -3,6 +3,7 @@
 #include <random>
 #include <tape.hpp>
 
+#include "app_record.hpp"
 #include "base_app.hpp"
 
 class GenerateTape : BaseApp {
@@ -12,6 +13,8 @@ class GenerateTape : BaseApp {
     parser_.add_argument("--out").required();
     parser_.add_argument("--size").required();
     parser_.add_argument("--seed").default_value("42");
+    parser_.add_argument("--header").default_value(false).implicit_value(true);
+    parser_.add_argument("--records").default_value(false).implicit_value(true);
 
     try {
       parser_.parse_args(argc_, argv_);
@@ -32,13 +35,20 @@ class GenerateTape : BaseApp {
 
       auto gen = std::mt19937(seed);
 
-      auto tape = Tape(filename, size);
-
-      for (std::size_t i = 0; i < size; ++i) {
-        tape.write(static_cast<std::int32_t>(gen()));
-        if (i+1 != size) {
-          tape.moveRight();
-        }
+      const auto format = parser_.get<bool>("--header") ? TapeFormat::WithHeader
+                                                         : TapeFormat::Raw;
+      if (parser_.get<bool>("--records")) {
+        generate_<AppRecord>(filename, size, format, [&gen]() {
+          auto record = AppRecord{static_cast<std::int64_t>(gen()), {}};
+          for (auto& byte : record.payload) {
+            byte = static_cast<std::byte>(gen());
+          }
+          return record;
+        });
+      } else {
+        generate_<std::int32_t>(filename, size, format, [&gen]() {
+          return static_cast<std::int32_t>(gen());
+        });
       }
     } catch (const std::exception& e) {
       std::cerr << e.what() << std::endl;
@@ -48,6 +58,22 @@ class GenerateTape : BaseApp {
     return 0;
   }
 
+ private:
+  template <class T, class Generator>
+  static void generate_(const std::string& filename, std::size_t size,
+                        TapeFormat format, Generator generator) {
+    auto tape = BasicTape<T>(filename, size, TapeBackendType::File,
+                             Tape::defaultReadWindowSize,
+                             Tape::defaultWriteBufferSize, format);
+
+    for (std::size_t i = 0; i < size; ++i) {
+      tape.write(generator());
+      if (i+1 != size) {
+        tape.moveRight();
+      }
+    }
+  }
+
  private:
   argparse::ArgumentParser parser_{};
 };
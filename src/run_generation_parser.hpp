@@ -0,0 +1,25 @@
+#ifndef RUN_GENERATION_PARSER_HPP
+#define RUN_GENERATION_PARSER_HPP
+
+#include <run_generation.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+inline RunGeneration parseRunGeneration(std::string_view name) {
+  if (name == "blocks") {
+    return RunGeneration::FixedBlocks;
+  }
+  if (name == "replacement") {
+    return RunGeneration::ReplacementSelection;
+  }
+  if (name == "natural") {
+    return RunGeneration::NaturalRuns;
+  }
+  std::stringstream messageStream;
+  messageStream << "Unknown run generation \"" << name
+                << "\". Expected one of: blocks, replacement, natural.";
+  throw std::invalid_argument(messageStream.str());
+}
+
+#endif  // RUN_GENERATION_PARSER_HPP
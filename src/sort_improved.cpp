@@ -1,20 +1,53 @@
 #include <argparse/argparse.hpp>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <improved_merge_sort.hpp>
+#include <k_way_merge_sort.hpp>
+#include <merge_pipeline.hpp>
+#include <merge_sort.hpp>
+#include <optional>
+#include <parallel_tape_sort.hpp>
+#include <sort_planner.hpp>
 #include <tape_pool.hpp>
 
 #include "base_app.hpp"
 #include "config_parser.hpp"
+#include "run_generation_parser.hpp"
+#include "sort_options.hpp"
+#include "sort_planning.hpp"
+#include "tape_backend_type_parser.hpp"
 
 class SortSimple : BaseApp {
  public:
   SortSimple(int argc, const char* const* argv) : BaseApp(argc, argv) {
   }
   int run() && {
-    parser_.add_argument("--in").required();
-    parser_.add_argument("--out").required();
+    parser_.add_argument("--in");
+    parser_.add_argument("--out");
     parser_.add_argument("--config").required();
+    parser_.add_argument("--backend").default_value("file");
+    parser_.add_argument("--tmp-backend").default_value("file");
+    parser_.add_argument("--k").default_value("2");
+    parser_.add_argument("--run-generation").default_value("blocks");
+    parser_.add_argument("--pre-scan").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--dry-run").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--parallel-passes")
+        .default_value(false)
+        .implicit_value(true);
+    parser_.add_argument("--pipeline").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--pipeline-ring").default_value("4096");
+    parser_.add_argument("--sort-threads").default_value("1");
+    parser_.add_argument("--workers").default_value("1");
+    parser_.add_argument("--speedup").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--size");
     parser_.add_argument("--m").required();
+    parser_.add_argument("--plan").default_value(false).implicit_value(true);
+    parser_.add_argument("--tapes").default_value("6");
 
     try {
       parser_.parse_args(argc_, argv_);
@@ -24,18 +57,88 @@ class SortSimple : BaseApp {
     }
 
     try {
+      const auto config = ConfigParser(parser_.get("--config")).read();
+
+      const auto m = parseCount("--m", parser_.get("--m"));
+      if (parser_.get<bool>("--plan")) {
+        // Planned sorts run with default settings.
+        checkNotUsedWith(parser_, "--plan",
+                         {"--workers", "--sort-threads", "--parallel-passes",
+                          "--pipeline", "--pipeline-ring"});
+      }
+
+      if (parser_.get<bool>("--dry-run")) {
+        printDryRun(config, planDryRun_(m / 4, config));
+        return 0;
+      }
+
       const auto inFilename = parser_.get("--in");
       const auto outFilename = parser_.get("--out");
-      const auto configFilename = parser_.get("--config");
 
-      auto m = std::size_t{};
-      std::stringstream mStream(parser_.get("--m"));
-      mStream >> m;
+      const auto k = parseCount("--k", parser_.get("--k"));
+      checkTwoWayOnly(parser_, k,
+                      {"--run-generation", "--pre-scan", "--parallel-passes",
+                       "--pipeline", "--pipeline-ring", "--sort-threads",
+                       "--workers"});
+      const auto workersCnt =
+          parseCount("--workers", parser_.get("--workers"));
+      if (workersCnt > 1) {
+        // Workers sort their parts with default settings.
+        checkNotUsedWith(parser_, "--workers greater than 1",
+                         {"--sort-threads", "--run-generation", "--pre-scan",
+                          "--parallel-passes", "--pipeline",
+                          "--pipeline-ring"});
+      }
+      const auto tmpBackendType =
+          parseTapeBackendType(parser_.get("--tmp-backend"));
+      checkParallelPasses(parser_, tmpBackendType);
 
-      auto tapePool = TapePool();
-      auto config = ConfigParser(configFilename).read();
-      ImprovedMergeSortImproved(tapePool, inFilename, "tmp", true, m / 4).perform(outFilename);
-      printReport_(config, tapePool.getStatistics());
+      auto tapePool = TapePool(parseTapeBackendType(parser_.get("--backend")),
+                               tmpBackendType);
+      auto mergePipeline = std::optional<MergePipeline>{};
+      if (parser_.get<bool>("--pipeline")) {
+        mergePipeline.emplace(
+            parseCount("--pipeline-ring", parser_.get("--pipeline-ring")));
+      }
+      auto plan = std::optional<SortPlanner::Plan>{};
+      auto parallelReport = std::optional<ParallelTapeSort::Report>{};
+      if (parser_.get<bool>("--plan")) {
+        plan = runPlanned_(tapePool, inFilename, outFilename, m / 4, config);
+      } else if (k == 2 && workersCnt > 1) {
+        // Workers share the memory limit.
+        parallelReport = ParallelTapeSort(tapePool, inFilename, "tmp", true,
+                                          m / 4 / workersCnt, workersCnt)
+                             .perform(outFilename);
+      } else if (k == 2) {
+        const auto sortThreadsCnt =
+            parseCount("--sort-threads", parser_.get("--sort-threads"));
+        ImprovedMergeSortImproved(
+            tapePool, inFilename, "tmp", true, m / 4,
+            parseRunGeneration(parser_.get("--run-generation")),
+            parser_.get<bool>("--pre-scan"),
+            parser_.get<bool>("--parallel-passes"),
+            mergePipeline.has_value() ? &*mergePipeline : nullptr,
+            sortThreadsCnt)
+            .perform(outFilename);
+      } else {
+        KWayMergeSort(tapePool, inFilename, "tmp", true, k, m / 4)
+            .perform(outFilename);
+      }
+      printReport_(config, tapePool.getStatistics(),
+                   tapePool.getCacheStatistics());
+      if (mergePipeline.has_value()) {
+        printPipelineReport_(*mergePipeline);
+      }
+      if (plan.has_value()) {
+        printPlan_(config, *plan, tapePool.getStatistics());
+      }
+      if (parallelReport.has_value()) {
+        printParallelReport_(*parallelReport);
+        if (parser_.get<bool>("--speedup")) {
+          printSpeedup_(*parallelReport,
+                        timeSingleThread_(inFilename, outFilename, m / 4));
+        }
+      }
     } catch (const std::exception& e) {
       std::cerr << e.what() << std::endl;
       return 1;
@@ -45,8 +148,70 @@ class SortSimple : BaseApp {
   }
 
  private:
+  SortPlanner makePlanner_(std::size_t elementsCnt, std::size_t memoryLimit,
+                           const ConfigParser::Config& config) {
+    checkPlannable(parser_.get("--k"), parser_.get("--run-generation"),
+                   parser_.get<bool>("--pre-scan"));
+    const auto tapesCnt = parseCount("--tapes", parser_.get("--tapes"));
+    return {elementsCnt, memoryLimit, tapesCnt, toOperationTimes(config)};
+  }
+
+  SortPlanner::Plan planDryRun_(std::size_t memoryLimit,
+                                const ConfigParser::Config& config) {
+    const auto elementsCnt = parseCount("--size", parser_.get("--size"));
+    const auto planner = makePlanner_(elementsCnt, memoryLimit, config);
+    return parser_.get<bool>("--plan")
+               ? planner.choose()
+               : planner.getPlan(SortPlanner::Algorithm::ImprovedMergeSort);
+  }
+
+  SortPlanner::Plan runPlanned_(TapePool& tapePool,
+                                const std::string& inFilename,
+                                const std::string& outFilename,
+                                std::size_t memoryLimit,
+                                const ConfigParser::Config& config) {
+    const auto elementsCnt = tapePool.getOrOpenTape(inFilename).getSize();
+    const auto plan =
+        makePlanner_(elementsCnt, memoryLimit, config).choose();
+    if (plan.algorithm == SortPlanner::Algorithm::MergeSort) {
+      MergeSort(tapePool, inFilename, "tmp", true).perform(outFilename);
+    } else {
+      ImprovedMergeSortImproved(tapePool, inFilename, "tmp", true,
+                                memoryLimit)
+          .perform(outFilename);
+    }
+    return plan;
+  }
+
+  static void printPlan_(const ConfigParser::Config& config,
+                         const SortPlanner::Plan& plan,
+                         const TapePool::IOStatistics& ioStats) {
+    const auto& predicted = plan.statistics;
+    std::cout << "Planned algorithm:\t" << SortPlanner::getName(plan.algorithm)
+              << std::endl;
+    std::cout << "Operation\tPredicted\tActual" << std::endl;
+    std::cout << "Read\t" << predicted.readCnt << "\t" << ioStats.readCnt
+              << std::endl;
+    std::cout << "Write\t" << predicted.writeCnt << "\t" << ioStats.writeCnt
+              << std::endl;
+    std::cout << "Move\t" << predicted.moveCnt << "\t" << ioStats.moveCnt
+              << std::endl;
+    std::cout << "Create\t" << predicted.createCnt << "\t"
+              << ioStats.createCnt << std::endl;
+    std::cout << "Open\t" << predicted.openCnt << "\t" << ioStats.openCnt
+              << std::endl;
+    std::cout << "Close\t" << predicted.closeCnt << "\t" << ioStats.closeCnt
+              << std::endl;
+    std::cout << "Remove\t" << predicted.removeCnt << "\t"
+              << ioStats.removeCnt << std::endl;
+    std::cout << "Time\t" << plan.time << "\t"
+              << SortPlanner::calcTime(ioStats, toOperationTimes(config))
+              << std::endl;
+  }
+
   void printReport_(const ConfigParser::Config& config,
-                    const TapePool::IOStatistics& ioStats) {
+                    const TapePool::IOStatistics& ioStats,
+                    const TapePool::CacheStatistics& cacheStats) {
     std::cout << "Read count:\t" << ioStats.readCnt << std::endl;
     std::cout << "Write count:\t" << ioStats.writeCnt << std::endl;
     std::cout << "Move count:\t" << ioStats.moveCnt << std::endl;
@@ -54,6 +219,8 @@ class SortSimple : BaseApp {
     std::cout << "Open count:\t" << ioStats.openCnt << std::endl;
     std::cout << "Close count:\t" << ioStats.closeCnt << std::endl;
     std::cout << "Remove count:\t" << ioStats.removeCnt << std::endl;
+    std::cout << "Scan read count:\t" << ioStats.scanReadCnt << std::endl;
+    std::cout << "Scan move count:\t" << ioStats.scanMoveCnt << std::endl;
     std::cout << "Read time:\t" << ioStats.readCnt * config.readTime
               << std::endl;
     std::cout << "Write time:\t" << ioStats.writeCnt * config.writeTime
@@ -68,6 +235,78 @@ class SortSimple : BaseApp {
               << std::endl;
     std::cout << "Remove time:\t" << ioStats.removeCnt * config.removeTime
               << std::endl;
+    std::cout << "Scan time:\t"
+              << ioStats.scanReadCnt * config.readTime +
+                     ioStats.scanMoveCnt * config.moveTime
+              << std::endl;
+    std::cout << "Cache hits:\t" << cacheStats.hitCnt << std::endl;
+    std::cout << "Cache misses:\t" << cacheStats.missCnt << std::endl;
+    std::cout << "File seeks:\t" << cacheStats.seekCnt << std::endl;
+  }
+
+  std::chrono::steady_clock::duration timeSingleThread_(
+      const std::string& inFilename, const std::string& outFilename,
+      std::size_t memoryLimit) {
+    auto tapePool =
+        TapePool(parseTapeBackendType(parser_.get("--backend")),
+                 parseTapeBackendType(parser_.get("--tmp-backend")));
+    const auto singleOutFilename = outFilename + "_single_thread";
+    const auto start = std::chrono::steady_clock::now();
+    ImprovedMergeSortImproved(tapePool, inFilename, "tmp", true, memoryLimit)
+        .perform(singleOutFilename);
+    const auto time = std::chrono::steady_clock::now() - start;
+    std::filesystem::remove(singleOutFilename);
+    return time;
+  }
+
+  static void printIOStatistics_(const TapePool::IOStatistics& ioStats) {
+    std::cout << ioStats.readCnt << "\t" << ioStats.writeCnt << "\t"
+              << ioStats.moveCnt << "\t" << ioStats.createCnt << "\t"
+              << ioStats.openCnt << "\t" << ioStats.closeCnt << "\t"
+              << ioStats.removeCnt << std::endl;
+  }
+
+  static void printParallelReport_(const ParallelTapeSort::Report& report) {
+    std::cout << "Part\tRead\tWrite\tMove\tCreate\tOpen\tClose\tRemove"
+              << std::endl;
+    for (std::size_t i = 0; i < report.workerStatistics.size(); ++i) {
+      std::cout << "Worker " << i << "\t";
+      printIOStatistics_(report.workerStatistics[i]);
+    }
+    std::cout << "Merge\t";
+    printIOStatistics_(report.mergeStatistics);
+    std::cout << "Total\t";
+    printIOStatistics_(report.aggregateStatistics);
+    std::cout << "Segments sort time:\t"
+              << std::chrono::duration<double>(report.sortTime).count()
+              << std::endl;
+    std::cout << "Final merge time:\t"
+              << std::chrono::duration<double>(report.mergeTime).count()
+              << std::endl;
+  }
+
+  static void printSpeedup_(
+      const ParallelTapeSort::Report& report,
+      std::chrono::steady_clock::duration singleThreadTime) {
+    const auto parallelTime = std::chrono::duration<double>(
+        report.sortTime + report.mergeTime);
+    const auto singleTime =
+        std::chrono::duration<double>(singleThreadTime);
+    std::cout << "Single thread time:\t" << singleTime.count() << std::endl;
+    std::cout << "Speedup:\t" << singleTime / parallelTime << std::endl;
+  }
+
+  static void printPipelineReport_(const MergePipeline& mergePipeline) {
+    const auto stalls = mergePipeline.getStatistics();
+    std::cout << "Pipelined merges:\t" << mergePipeline.getMergesCnt()
+              << std::endl;
+    std::cout << "Reader 0 stalls:\t" << stalls.readerStallCnt0 << std::endl;
+    std::cout << "Reader 1 stalls:\t" << stalls.readerStallCnt1 << std::endl;
+    std::cout << "Merger input stalls:\t" << stalls.mergerInputStallCnt
+              << std::endl;
+    std::cout << "Merger output stalls:\t" << stalls.mergerOutputStallCnt
+              << std::endl;
+    std::cout << "Writer stalls:\t" << stalls.writerStallCnt << std::endl;
   }
 
  private:
@@ -0,0 +1,100 @@
+#ifndef SORT_OPTIONS_HPP
+#define SORT_OPTIONS_HPP
+
+#include <argparse/argparse.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tape_backend.hpp>
+
+/**
+ * @brief Parse a non-negative integer value of an option.
+ *
+ * @param option option name for error messages.
+ * @param value option value.
+ * @return parsed value.
+ */
+inline std::size_t parseCount(std::string_view option,
+                              const std::string& value) {
+  auto ret = std::size_t{};
+  std::stringstream valueStream(value);
+  if (value.empty() || value.front() == '-' || !(valueStream >> ret) ||
+      !(valueStream >> std::ws).eof()) {
+    std::stringstream messageStream;
+    messageStream << "Invalid value \"" << value << "\" of " << option
+                  << ". Expected a non-negative integer.";
+    throw std::invalid_argument(messageStream.str());
+  }
+  return ret;
+}
+
+/**
+ * @brief Check that options of two way merge sorts are not used with another
+ * count of ways.
+ *
+ * @param parser parsed arguments.
+ * @param k count of ways.
+ * @param options options supported by two way sorts only.
+ */
+inline void checkTwoWayOnly(const argparse::ArgumentParser& parser,
+                            std::size_t k,
+                            std::initializer_list<std::string_view> options) {
+  if (k == 2) {
+    return;
+  }
+  for (const auto option : options) {
+    if (parser.is_used(std::string(option))) {
+      std::stringstream messageStream;
+      messageStream << "Option " << option
+                    << " is supported by two way merge sorts only, --k is "
+                    << k << ".";
+      throw std::invalid_argument(messageStream.str());
+    }
+  }
+}
+
+/**
+ * @brief Check that options ignored by the chosen sort are not used.
+ *
+ * @param parser parsed arguments.
+ * @param reason what chose the sort, e.g. "--plan".
+ * @param options options the sort ignores.
+ */
+inline void checkNotUsedWith(const argparse::ArgumentParser& parser,
+                             std::string_view reason,
+                             std::initializer_list<std::string_view> options) {
+  for (const auto option : options) {
+    if (parser.is_used(std::string(option))) {
+      std::stringstream messageStream;
+      messageStream << "Option " << option << " can not be used with "
+                    << reason << ".";
+      throw std::invalid_argument(messageStream.str());
+    }
+  }
+}
+
+/**
+ * @brief Check that parallel passes are asked for with temporary tapes which
+ * can be read by a second head. Other tapes would merge on a single thread.
+ *
+ * @param parser parsed arguments.
+ * @param tmpBackendType backend of temporary tapes.
+ */
+inline void checkParallelPasses(const argparse::ArgumentParser& parser,
+                                TapeBackendType tmpBackendType) {
+  if (!parser.get<bool>("--parallel-passes") ||
+      tmpBackendType == TapeBackendType::Mmap ||
+      tmpBackendType == TapeBackendType::Memory) {
+    return;
+  }
+  std::stringstream messageStream;
+  messageStream << "Option --parallel-passes needs mmap or memory temporary "
+                   "tapes, --tmp-backend is "
+                << parser.get("--tmp-backend") << ".";
+  throw std::invalid_argument(messageStream.str());
+}
+
+#endif  // SORT_OPTIONS_HPP
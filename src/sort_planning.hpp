@@ -0,0 +1,59 @@
+#ifndef SORT_PLANNING_HPP
+#define SORT_PLANNING_HPP
+
+#include <iostream>
+#include <sort_planner.hpp>
+#include <stdexcept>
+#include <string_view>
+
+#include "config_parser.hpp"
+
+inline SortPlanner::OperationTimes toOperationTimes(
+    const ConfigParser::Config& config) {
+  return {config.moveTime,   config.readTime,   config.writeTime,
+          config.openTime,   config.createTime, config.closeTime,
+          config.removeTime};
+}
+
+/**
+ * @brief Check that the sort asked for is predicted by SortPlanner.
+ */
+inline void checkPlannable(std::string_view k, std::string_view runGeneration,
+                           bool preScan) {
+  if (k != "2" || runGeneration != "blocks" || preScan) {
+    throw std::invalid_argument(
+        "Only two way merge sorts of fixed blocks can be planned.");
+  }
+}
+
+/**
+ * @brief Print operations counts and times predicted by a planner instead of
+ * running a sort. Times of the config are in microseconds.
+ */
+inline void printDryRun(const ConfigParser::Config& config,
+                        const SortPlanner::Plan& plan) {
+  const auto& stats = plan.statistics;
+  std::cout << "Algorithm:\t" << SortPlanner::getName(plan.algorithm)
+            << std::endl;
+  std::cout << "Read count:\t" << stats.readCnt << std::endl;
+  std::cout << "Write count:\t" << stats.writeCnt << std::endl;
+  std::cout << "Move count:\t" << stats.moveCnt << std::endl;
+  std::cout << "Create count:\t" << stats.createCnt << std::endl;
+  std::cout << "Open count:\t" << stats.openCnt << std::endl;
+  std::cout << "Close count:\t" << stats.closeCnt << std::endl;
+  std::cout << "Remove count:\t" << stats.removeCnt << std::endl;
+  std::cout << "Read time:\t" << stats.readCnt * config.readTime << std::endl;
+  std::cout << "Write time:\t" << stats.writeCnt * config.writeTime
+            << std::endl;
+  std::cout << "Move time:\t" << stats.moveCnt * config.moveTime << std::endl;
+  std::cout << "Create time:\t" << stats.createCnt * config.createTime
+            << std::endl;
+  std::cout << "Open time:\t" << stats.openCnt * config.openTime << std::endl;
+  std::cout << "Close time:\t" << stats.closeCnt * config.closeTime
+            << std::endl;
+  std::cout << "Remove time:\t" << stats.removeCnt * config.removeTime
+            << std::endl;
+  std::cout << "Total time (us):\t" << plan.time << std::endl;
+}
+
+#endif  // SORT_PLANNING_HPP
@@ -0,0 +1,132 @@
+#include <argparse/argparse.hpp>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <record_sort.hpp>
+#include <tape_pool.hpp>
+
+#include "app_record.hpp"
+#include "base_app.hpp"
+#include "config_parser.hpp"
+#include "sort_options.hpp"
+#include "tape_backend_type_parser.hpp"
+
+class SortRecords : BaseApp {
+ public:
+  SortRecords(int argc, const char* const* argv) : BaseApp(argc, argv) {
+  }
+  int run() && {
+    parser_.add_argument("--in").required();
+    parser_.add_argument("--out").required();
+    parser_.add_argument("--config").required();
+    parser_.add_argument("--backend").default_value("file");
+    parser_.add_argument("--tmp-backend").default_value("file");
+    parser_.add_argument("--m").required();
+    parser_.add_argument("--strategy").default_value("both");
+
+    try {
+      parser_.parse_args(argc_, argv_);
+    } catch (const std::runtime_error& e) {
+      std::cerr << "Invalid arguments. " << e.what() << std::endl;
+      return 1;
+    }
+
+    try {
+      const std::string inFilename = parser_.get("--in");
+      const std::string outFilename = parser_.get("--out");
+      const auto config = ConfigParser(parser_.get("--config")).read();
+
+      const auto m = parseCount("--m", parser_.get("--m"));
+
+      const auto strategy = parseStrategy_(parser_.get("--strategy"));
+      if (strategy.has_value()) {
+        sort_(inFilename, outFilename, m, *strategy, config);
+        return 0;
+      }
+
+      // Both strategies are run and the cheaper result is kept.
+      const auto fullFilename = outFilename + "_full";
+      const auto tagFilename = outFilename + "_tag";
+      std::cout << "Full records:" << std::endl;
+      const auto fullTime = sort_(inFilename, fullFilename, m,
+                                  RecordSortStrategy::FullRecords, config);
+      std::cout << "Tag sort:" << std::endl;
+      const auto tagTime = sort_(inFilename, tagFilename, m,
+                                 RecordSortStrategy::TagSort, config);
+      const bool tagCheaper = tagTime < fullTime;
+      std::cout << "Cheaper strategy:\t" << (tagCheaper ? "tag" : "full")
+                << std::endl;
+      std::filesystem::rename(tagCheaper ? tagFilename : fullFilename,
+                              outFilename);
+      std::filesystem::remove(tagCheaper ? fullFilename : tagFilename);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+
+    return 0;
+  }
+
+ private:
+  std::size_t sort_(const std::string& inFilename,
+                    const std::string& outFilename, std::size_t m,
+                    RecordSortStrategy strategy,
+                    const ConfigParser::Config& config) {
+    auto tapePool =
+        TapePool(parseTapeBackendType(parser_.get("--backend")),
+                 parseTapeBackendType(parser_.get("--tmp-backend")));
+    RecordSort<sizeof(AppRecord::payload)>(tapePool, inFilename, "tmp", true,
+                                           m)
+        .perform(outFilename, strategy);
+    return printReport_(config, tapePool.getStatistics(),
+                        tapePool.getCacheStatistics());
+  }
+
+  static std::optional<RecordSortStrategy> parseStrategy_(
+      std::string_view name) {
+    if (name == "full") {
+      return RecordSortStrategy::FullRecords;
+    }
+    if (name == "tag") {
+      return RecordSortStrategy::TagSort;
+    }
+    if (name == "both") {
+      return std::nullopt;
+    }
+    std::stringstream messageStream;
+    messageStream << "Unknown strategy \"" << name
+                  << "\". Expected one of: full, tag, both.";
+    throw std::invalid_argument(messageStream.str());
+  }
+
+  static std::size_t printReport_(const ConfigParser::Config& config,
+                                  const TapePool::IOStatistics& ioStats,
+                                  const TapePool::CacheStatistics& cacheStats) {
+    const std::size_t totalTime = ioStats.readCnt * config.readTime +
+                                  ioStats.writeCnt * config.writeTime +
+                                  ioStats.moveCnt * config.moveTime +
+                                  ioStats.createCnt * config.createTime +
+                                  ioStats.openCnt * config.openTime +
+                                  ioStats.closeCnt * config.closeTime +
+                                  ioStats.removeCnt * config.removeTime;
+    std::cout << "Read count:\t" << ioStats.readCnt << std::endl;
+    std::cout << "Write count:\t" << ioStats.writeCnt << std::endl;
+    std::cout << "Move count:\t" << ioStats.moveCnt << std::endl;
+    std::cout << "Create count:\t" << ioStats.createCnt << std::endl;
+    std::cout << "Open count:\t" << ioStats.openCnt << std::endl;
+    std::cout << "Close count:\t" << ioStats.closeCnt << std::endl;
+    std::cout << "Remove count:\t" << ioStats.removeCnt << std::endl;
+    std::cout << "Total time:\t" << totalTime << std::endl;
+    std::cout << "Cache hits:\t" << cacheStats.hitCnt << std::endl;
+    std::cout << "Cache misses:\t" << cacheStats.missCnt << std::endl;
+    std::cout << "File seeks:\t" << cacheStats.seekCnt << std::endl;
+    return totalTime;
+  }
+
+ private:
+  argparse::ArgumentParser parser_{};
+};
+
+int main(int argc, char* argv[]) {
+  return SortRecords(argc, argv).run();
+}
@@ -1,19 +1,41 @@
 #include <argparse/argparse.hpp>
 #include <iostream>
+#include <k_way_merge_sort.hpp>
+#include <merge_pipeline.hpp>
 #include <merge_sort.hpp>
+#include <optional>
 #include <tape_pool.hpp>
 
 #include "base_app.hpp"
 #include "config_parser.hpp"
+#include "run_generation_parser.hpp"
+#include "sort_options.hpp"
+#include "sort_planning.hpp"
+#include "tape_backend_type_parser.hpp"
 
 class SortSimple : BaseApp {
  public:
   SortSimple(int argc, const char* const* argv) : BaseApp(argc, argv) {
   }
   int run() && {
-    parser_.add_argument("--in").required();
-    parser_.add_argument("--out").required();
+    parser_.add_argument("--in");
+    parser_.add_argument("--out");
     parser_.add_argument("--config").required();
+    parser_.add_argument("--backend").default_value("file");
+    parser_.add_argument("--tmp-backend").default_value("file");
+    parser_.add_argument("--k").default_value("2");
+    parser_.add_argument("--run-generation").default_value("blocks");
+    parser_.add_argument("--pre-scan").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--dry-run").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--parallel-passes")
+        .default_value(false)
+        .implicit_value(true);
+    parser_.add_argument("--pipeline").default_value(false).implicit_value(
+        true);
+    parser_.add_argument("--pipeline-ring").default_value("4096");
+    parser_.add_argument("--size");
 
     try {
       parser_.parse_args(argc_, argv_);
@@ -23,14 +45,46 @@ class SortSimple : BaseApp {
     }
 
     try {
+      const auto config = ConfigParser(parser_.get("--config")).read();
+      if (parser_.get<bool>("--dry-run")) {
+        printDryRun(config, planDryRun_(config));
+        return 0;
+      }
+
       const auto inFilename = parser_.get("--in");
       const auto outFilename = parser_.get("--out");
-      const auto configFilename = parser_.get("--config");
 
-      auto tapePool = TapePool();
-      auto config = ConfigParser(configFilename).read();
-      MergeSort(tapePool, inFilename, "tmp", true).perform(outFilename);
-      printReport_(config, tapePool.getStatistics());
+      const auto k = parseCount("--k", parser_.get("--k"));
+      checkTwoWayOnly(parser_, k,
+                      {"--run-generation", "--pre-scan", "--parallel-passes",
+                       "--pipeline", "--pipeline-ring"});
+      const auto tmpBackendType =
+          parseTapeBackendType(parser_.get("--tmp-backend"));
+      checkParallelPasses(parser_, tmpBackendType);
+
+      auto tapePool = TapePool(parseTapeBackendType(parser_.get("--backend")),
+                               tmpBackendType);
+      auto mergePipeline = std::optional<MergePipeline>{};
+      if (parser_.get<bool>("--pipeline")) {
+        mergePipeline.emplace(
+            parseCount("--pipeline-ring", parser_.get("--pipeline-ring")));
+      }
+      if (k == 2) {
+        MergeSort(tapePool, inFilename, "tmp", true,
+                  parseRunGeneration(parser_.get("--run-generation")),
+                  parser_.get<bool>("--pre-scan"),
+                  parser_.get<bool>("--parallel-passes"),
+                  mergePipeline.has_value() ? &*mergePipeline : nullptr)
+            .perform(outFilename);
+      } else {
+        KWayMergeSort(tapePool, inFilename, "tmp", true, k)
+            .perform(outFilename);
+      }
+      printReport_(config, tapePool.getStatistics(),
+                   tapePool.getCacheStatistics());
+      if (mergePipeline.has_value()) {
+        printPipelineReport_(*mergePipeline);
+      }
     } catch (const std::exception& e) {
       std::cerr << e.what() << std::endl;
       return 1;
@@ -40,8 +94,18 @@ class SortSimple : BaseApp {
   }
 
  private:
+  SortPlanner::Plan planDryRun_(const ConfigParser::Config& config) {
+    checkPlannable(parser_.get("--k"), parser_.get("--run-generation"),
+                   parser_.get<bool>("--pre-scan"));
+    const auto elementsCnt = parseCount("--size", parser_.get("--size"));
+    return SortPlanner(elementsCnt, 0, SortPlanner::requiredTapesCnt,
+                       toOperationTimes(config))
+        .getPlan(SortPlanner::Algorithm::MergeSort);
+  }
+
   void printReport_(const ConfigParser::Config& config,
-                    const TapePool::IOStatistics& ioStats) {
+                    const TapePool::IOStatistics& ioStats,
+                    const TapePool::CacheStatistics& cacheStats) {
     std::cout << "Read count:\t" << ioStats.readCnt << std::endl;
     std::cout << "Write count:\t" << ioStats.writeCnt << std::endl;
     std::cout << "Move count:\t" << ioStats.moveCnt << std::endl;
@@ -49,6 +113,8 @@ class SortSimple : BaseApp {
     std::cout << "Open count:\t" << ioStats.openCnt << std::endl;
     std::cout << "Close count:\t" << ioStats.closeCnt << std::endl;
     std::cout << "Remove count:\t" << ioStats.removeCnt << std::endl;
+    std::cout << "Scan read count:\t" << ioStats.scanReadCnt << std::endl;
+    std::cout << "Scan move count:\t" << ioStats.scanMoveCnt << std::endl;
     std::cout << "Read time:\t" << ioStats.readCnt * config.readTime
               << std::endl;
     std::cout << "Write time:\t" << ioStats.writeCnt * config.writeTime
@@ -63,6 +129,26 @@ class SortSimple : BaseApp {
               << std::endl;
     std::cout << "Remove time:\t" << ioStats.removeCnt * config.removeTime
               << std::endl;
+    std::cout << "Scan time:\t"
+              << ioStats.scanReadCnt * config.readTime +
+                     ioStats.scanMoveCnt * config.moveTime
+              << std::endl;
+    std::cout << "Cache hits:\t" << cacheStats.hitCnt << std::endl;
+    std::cout << "Cache misses:\t" << cacheStats.missCnt << std::endl;
+    std::cout << "File seeks:\t" << cacheStats.seekCnt << std::endl;
+  }
+
+  static void printPipelineReport_(const MergePipeline& mergePipeline) {
+    const auto stalls = mergePipeline.getStatistics();
+    std::cout << "Pipelined merges:\t" << mergePipeline.getMergesCnt()
+              << std::endl;
+    std::cout << "Reader 0 stalls:\t" << stalls.readerStallCnt0 << std::endl;
+    std::cout << "Reader 1 stalls:\t" << stalls.readerStallCnt1 << std::endl;
+    std::cout << "Merger input stalls:\t" << stalls.mergerInputStallCnt
+              << std::endl;
+    std::cout << "Merger output stalls:\t" << stalls.mergerOutputStallCnt
+              << std::endl;
+    std::cout << "Writer stalls:\t" << stalls.writerStallCnt << std::endl;
   }
 
  private:
@@ -0,0 +1,31 @@
+#ifndef TAPE_BACKEND_TYPE_PARSER_HPP
+#define TAPE_BACKEND_TYPE_PARSER_HPP
+
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <tape_backend.hpp>
+
+inline TapeBackendType parseTapeBackendType(std::string_view name) {
+  if (name == "file") {
+    return TapeBackendType::File;
+  }
+  if (name == "mmap") {
+    return TapeBackendType::Mmap;
+  }
+  if (name == "memory") {
+    return TapeBackendType::Memory;
+  }
+  if (name == "async") {
+    return TapeBackendType::Async;
+  }
+  if (name == "direct") {
+    return TapeBackendType::Direct;
+  }
+  std::stringstream messageStream;
+  messageStream << "Unknown tape backend \"" << name
+                << "\". Expected one of: file, mmap, memory, async, direct.";
+  throw std::invalid_argument(messageStream.str());
+}
+
+#endif
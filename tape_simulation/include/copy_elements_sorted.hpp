@@ -22,9 +22,8 @@ template <class InputIterator, class OutputIterator>
 void copy_top_elements_sorted(InputIterator source, OutputIterator target,
                               std::size_t elementsCnt,
                               std::size_t additionalScan = 0) {
-  copy_elements_sorted<InputIterator, OutputIterator,
-                       std::greater<std::int32_t>>(source, target, elementsCnt,
-                                                   additionalScan);
+  copy_elements_sorted<InputIterator, OutputIterator, std::greater<>>(
+      source, target, elementsCnt, additionalScan);
 }
 
 /**
@@ -44,7 +43,7 @@ template <class InputIterator, class OutputIterator>
 void copy_bottom_elements_sorted(InputIterator source, OutputIterator target,
                                  std::size_t elementsCnt,
                                  std::size_t additionalScan = 0) {
-  copy_elements_sorted<InputIterator, OutputIterator, std::less<std::int32_t>>(
+  copy_elements_sorted<InputIterator, OutputIterator, std::less<>>(
       source, target, elementsCnt, additionalScan);
 }
 
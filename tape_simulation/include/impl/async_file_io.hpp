@@ -0,0 +1,196 @@
+#ifndef TAPE_SIMULATION_IMPL_ASYNC_FILE_IO_HPP
+#define TAPE_SIMULATION_IMPL_ASYNC_FILE_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class AsyncFileIo - reads and writes of a single file running in
+/// background. Requests are not ordered: a caller waits for a request before
+/// submitting another one touching the same bytes. Submitted buffers must
+/// live until their requests are finished.
+class AsyncFileIo {
+ public:
+  using Request = std::uint64_t;
+
+ public:
+  AsyncFileIo() = default;
+  AsyncFileIo(const AsyncFileIo&) = delete;
+  AsyncFileIo(AsyncFileIo&&) noexcept = delete;
+  AsyncFileIo& operator=(const AsyncFileIo&) = delete;
+  AsyncFileIo& operator=(AsyncFileIo&&) noexcept = delete;
+  virtual ~AsyncFileIo() = default;
+
+  /**
+   * @brief Queue a read of exactly bytesCnt bytes.
+   *
+   * @param data destination.
+   * @param bytesCnt bytes count.
+   * @param offset file offset.
+   * @return request to wait for.
+   */
+  virtual Request submitRead(std::byte* data, std::size_t bytesCnt,
+                             std::size_t offset) = 0;
+
+  /**
+   * @brief Queue a write of exactly bytesCnt bytes.
+   *
+   * @param data source.
+   * @param bytesCnt bytes count.
+   * @param offset file offset.
+   * @return request to wait for.
+   */
+  virtual Request submitWrite(const std::byte* data, std::size_t bytesCnt,
+                              std::size_t offset) = 0;
+
+  /**
+   * @brief Check if a request is finished without blocking.
+   *
+   * @param request request not waited for yet.
+   * @return true if wait would not block.
+   */
+  [[nodiscard]] virtual bool isFinished(Request request) = 0;
+
+  /**
+   * @brief Wait until a request is finished. Throws std::system_error if it
+   * failed. A request is waited for once.
+   *
+   * @param request request not waited for yet.
+   */
+  virtual void wait(Request request) = 0;
+};
+
+/**
+ * @brief Make background I/O of a file: io_uring if the kernel allows it,
+ * threads shared by all files otherwise.
+ *
+ * @param fd file descriptor, used until the returned object is destroyed.
+ * @param filename file name for error messages.
+ * @return background I/O of the file.
+ */
+std::unique_ptr<AsyncFileIo> makeAsyncFileIo(int fd,
+                                             const std::string& filename);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class PooledAsyncFileIo - requests run by threads shared by all
+/// files.
+class PooledAsyncFileIo : public AsyncFileIo {
+ public:
+  /// Count of threads shared by all files.
+  constexpr static std::size_t threadsCnt = 4;
+
+ public:
+  /**
+   * @brief PooledAsyncFileIo constructor.
+   *
+   * @param fd file descriptor.
+   * @param filename file name for error messages.
+   */
+  PooledAsyncFileIo(int fd, std::string filename);
+  PooledAsyncFileIo(const PooledAsyncFileIo&) = delete;
+  PooledAsyncFileIo(PooledAsyncFileIo&&) noexcept = delete;
+  PooledAsyncFileIo& operator=(const PooledAsyncFileIo&) = delete;
+  PooledAsyncFileIo& operator=(PooledAsyncFileIo&&) noexcept = delete;
+  ~PooledAsyncFileIo() override;
+
+  Request submitRead(std::byte* data, std::size_t bytesCnt,
+                     std::size_t offset) override;
+
+  Request submitWrite(const std::byte* data, std::size_t bytesCnt,
+                      std::size_t offset) override;
+
+  [[nodiscard]] bool isFinished(Request request) override;
+
+  void wait(Request request) override;
+
+ private:
+  Request submit_(std::future<void> finished);
+
+ private:
+  int fd_;
+  std::string filename_;
+  Request nextRequest_{0};
+  std::map<Request, std::future<void>> requests_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class IoUringAsyncFileIo - requests run by the kernel through an
+/// io_uring instance of the file. Set up with raw system calls, so no library
+/// is needed. Partial transfers are resubmitted for the rest.
+class IoUringAsyncFileIo : public AsyncFileIo {
+ public:
+  /// Count of requests in flight at once.
+  constexpr static std::uint32_t entriesCnt = 64;
+
+ public:
+  /**
+   * @brief IoUringAsyncFileIo constructor. Throws std::system_error if the
+   * kernel does not support io_uring or forbids it.
+   *
+   * @param fd file descriptor.
+   * @param filename file name for error messages.
+   */
+  IoUringAsyncFileIo(int fd, std::string filename);
+  IoUringAsyncFileIo(const IoUringAsyncFileIo&) = delete;
+  IoUringAsyncFileIo(IoUringAsyncFileIo&&) noexcept = delete;
+  IoUringAsyncFileIo& operator=(const IoUringAsyncFileIo&) = delete;
+  IoUringAsyncFileIo& operator=(IoUringAsyncFileIo&&) noexcept = delete;
+  ~IoUringAsyncFileIo() override;
+
+  Request submitRead(std::byte* data, std::size_t bytesCnt,
+                     std::size_t offset) override;
+
+  Request submitWrite(const std::byte* data, std::size_t bytesCnt,
+                      std::size_t offset) override;
+
+  [[nodiscard]] bool isFinished(Request request) override;
+
+  void wait(Request request) override;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief struct Transfer_ - state of a request. Error is an errno value.
+  struct Transfer_ {
+    bool write;
+    std::byte* data;
+    std::size_t bytesLeft;
+    std::size_t offset;
+    bool finished{false};
+    int error{0};
+  };
+
+ private:
+  void push_(Request request, const Transfer_& transfer);
+  void reap_(bool block);
+  void complete_(Request request, std::int32_t result);
+  void enter_(std::uint32_t submitCnt, std::uint32_t waitCnt);
+  void unmap_() noexcept;
+
+ private:
+  int fd_;
+  std::string filename_;
+  int ringFd_{-1};
+  void* sqRing_{nullptr};
+  std::size_t sqRingSize_{0};
+  void* cqRing_{nullptr};
+  std::size_t cqRingSize_{0};
+  void* sqes_{nullptr};
+  std::size_t sqesSize_{0};
+  std::uint32_t* sqHead_{nullptr};
+  std::uint32_t* sqTail_{nullptr};
+  std::uint32_t sqMask_{0};
+  std::uint32_t* sqArray_{nullptr};
+  std::uint32_t* cqHead_{nullptr};
+  std::uint32_t* cqTail_{nullptr};
+  std::uint32_t cqMask_{0};
+  void* cqes_{nullptr};
+  std::size_t inFlightCnt_{0};
+  Request nextRequest_{0};
+  std::map<Request, Transfer_> transfers_;
+};
+
+#endif  // TAPE_SIMULATION_IMPL_ASYNC_FILE_IO_HPP
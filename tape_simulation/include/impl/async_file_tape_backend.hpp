@@ -0,0 +1,105 @@
+#ifndef TAPE_SIMULATION_IMPL_ASYNC_FILE_TAPE_BACKEND_HPP
+#define TAPE_SIMULATION_IMPL_ASYNC_FILE_TAPE_BACKEND_HPP
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../tape_backend.hpp"
+#include "async_file_io.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class AsyncFileTapeBackend - file cells cached by chunks. Chunks
+/// ahead of the head in its travel direction are read and chunks left behind
+/// by the head are written in background, by io_uring or by threads shared by
+/// all tapes (see makeAsyncFileIo).
+class AsyncFileTapeBackend : public TapeBackend {
+ public:
+  /// Default chunk size in cells.
+  constexpr static std::size_t defaultChunkSize = 1 << 14;
+  /// Number of chunks read ahead of the head.
+  constexpr static std::size_t chunksAhead = 4;
+
+ public:
+  /**
+   * @brief AsyncFileTapeBackend constructor.
+   *
+   * @param filename tape filename.
+   * @param size tape cells count.
+   * @param cellSize bytes count of a single cell.
+   * @param create create (or truncate) the file instead of opening it.
+   * @param dataOffset bytes before the first cell.
+   * @param chunkSize cells count of a single transfer.
+   */
+  AsyncFileTapeBackend(const std::string& filename, std::size_t size,
+                       std::size_t cellSize, bool create,
+                       std::size_t dataOffset, std::size_t chunkSize);
+  AsyncFileTapeBackend(const AsyncFileTapeBackend&) = delete;
+  AsyncFileTapeBackend(AsyncFileTapeBackend&&) noexcept = delete;
+  AsyncFileTapeBackend& operator=(const AsyncFileTapeBackend&) = delete;
+  AsyncFileTapeBackend& operator=(AsyncFileTapeBackend&&) noexcept = delete;
+  ~AsyncFileTapeBackend() override;
+
+  void read(std::size_t position, std::byte* cell) override;
+
+  void write(std::size_t position, const std::byte* cell) override;
+
+  void headMoved(std::size_t position, Direction direction) override;
+
+  void flush() override;
+
+  [[nodiscard]] CacheStatistics getCacheStatistics() const override;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief struct Chunk - cached consecutive cells. Dirty range is in cells.
+  struct Chunk {
+    std::vector<std::byte> cells;
+    std::size_t dirtyBegin{0};
+    std::size_t dirtyEnd{0};
+    std::optional<AsyncFileIo::Request> loading;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief struct PendingWrite - write in flight and its copy of cells.
+  struct PendingWrite {
+    std::size_t chunkIdx;
+    AsyncFileIo::Request request;
+    std::vector<std::byte> cells;
+  };
+
+ private:
+  Chunk& getChunk_(std::size_t chunkIdx);
+  Chunk& loadChunk_(std::size_t chunkIdx);
+  void prefetch_(std::size_t chunkIdx);
+  void evictFarChunks_(std::size_t chunkIdx);
+  void writeBehind_(std::size_t chunkIdx, Chunk& chunk);
+  void checkFinishedWrites_();
+  void waitChunkWrites_(std::size_t chunkIdx);
+
+ private:
+  int fd_{-1};
+  std::string filename_;
+  std::size_t size_;
+  std::size_t dataOffset_;
+  std::size_t chunkSize_;
+  std::size_t chunksCnt_;
+  bool movingLeft_{false};
+  std::size_t headChunkIdx_{0};
+  std::map<std::size_t, std::unique_ptr<Chunk>> chunks_;
+  Chunk* lastChunk_{nullptr};
+  std::size_t lastChunkIdx_{0};
+  std::vector<PendingWrite> pendingWrites_;
+  CacheStatistics cacheStatistics_{};
+  std::unique_ptr<AsyncFileIo> io_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto AsyncFileTapeBackend::getCacheStatistics() const
+    -> CacheStatistics {
+  return cacheStatistics_;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_ASYNC_FILE_TAPE_BACKEND_HPP
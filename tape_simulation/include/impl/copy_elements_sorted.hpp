@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <queue>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 template <class InputIterator, class OutputIterator, class Compare>
@@ -13,8 +14,8 @@ void copy_elements_sorted(InputIterator source, OutputIterator target,
   if (elementsCnt == 0) {
     throw std::logic_error("Trying copying zero elements.");
   }
-  auto q =
-      std::priority_queue<std::int32_t, std::vector<std::int32_t>, Compare>();
+  using Value = std::decay_t<decltype(*source)>;
+  auto q = std::priority_queue<Value, std::vector<Value>, Compare>();
   if (elementsCnt + additionalScan == 0) {
     return;
   }
@@ -0,0 +1,86 @@
+#ifndef TAPE_SIMULATION_IMPL_DIRECT_FILE_TAPE_BACKEND_HPP
+#define TAPE_SIMULATION_IMPL_DIRECT_FILE_TAPE_BACKEND_HPP
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "../tape_backend.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class DirectFileTapeBackend - file cells accessed with direct I/O
+/// bypassing the page cache. A single aligned buffer around the head is the
+/// only memory used. The final partial block of a file is read short and
+/// written without direct I/O, so the file keeps its size.
+class DirectFileTapeBackend : public TapeBackend {
+ public:
+  /// Direct I/O offsets, lengths and buffers are aligned to this many bytes.
+  constexpr static std::size_t blockSize = 4096;
+
+ public:
+  /**
+   * @brief DirectFileTapeBackend constructor.
+   *
+   * @param filename tape filename.
+   * @param size tape cells count.
+   * @param cellSize bytes count of a single cell.
+   * @param create create (or truncate) the file instead of opening it.
+   * @param dataOffset bytes before the first cell, a multiple of blockSize.
+   * @param bufferSize buffer size in cells, rounded up to whole blocks.
+   */
+  DirectFileTapeBackend(const std::string& filename, std::size_t size,
+                        std::size_t cellSize, bool create,
+                        std::size_t dataOffset, std::size_t bufferSize);
+  DirectFileTapeBackend(const DirectFileTapeBackend&) = delete;
+  DirectFileTapeBackend(DirectFileTapeBackend&&) noexcept = delete;
+  DirectFileTapeBackend& operator=(const DirectFileTapeBackend&) = delete;
+  DirectFileTapeBackend& operator=(DirectFileTapeBackend&&) noexcept = delete;
+  ~DirectFileTapeBackend() override;
+
+  void read(std::size_t position, std::byte* cell) override;
+
+  void write(std::size_t position, const std::byte* cell) override;
+
+  void headMoved(std::size_t position, Direction direction) override;
+
+  void flush() override;
+
+  [[nodiscard]] CacheStatistics getCacheStatistics() const override;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief struct FreeDeleter - deleter of aligned allocations.
+  struct FreeDeleter {
+    void operator()(std::byte* data) const;
+  };
+
+ private:
+  std::byte* getCell_(std::size_t position);
+  void load_(std::size_t position);
+  void writeBack_();
+  void writeTail_(std::size_t begin, std::size_t end);
+
+ private:
+  int fd_{-1};
+  std::string filename_;
+  std::size_t size_;
+  std::size_t dataOffset_;
+  // The buffer and the dirty range are tracked in bytes, cells may cross block
+  // boundaries.
+  std::size_t bufferSize_;
+  std::unique_ptr<std::byte, FreeDeleter> buffer_;
+  std::size_t bufferBegin_{0};
+  std::size_t bufferLength_{0};
+  std::size_t dirtyBegin_{0};
+  std::size_t dirtyEnd_{0};
+  bool movingLeft_{false};
+  CacheStatistics cacheStatistics_{};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto DirectFileTapeBackend::getCacheStatistics() const
+    -> CacheStatistics {
+  return cacheStatistics_;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_DIRECT_FILE_TAPE_BACKEND_HPP
@@ -0,0 +1,61 @@
+#ifndef TAPE_SIMULATION_IMPL_FILE_IO_HPP
+#define TAPE_SIMULATION_IMPL_FILE_IO_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Throw std::system_error for the current errno.
+ *
+ * @param action failed action, e.g. "open".
+ * @param filename file name.
+ */
+[[noreturn]] void throwFileError(const std::string& action,
+                                 const std::string& filename);
+
+#ifndef _WIN32
+
+/**
+ * @brief Read exactly bytesCnt bytes at offset, retrying partial reads.
+ *
+ * @param fd file descriptor.
+ * @param data destination.
+ * @param bytesCnt bytes count.
+ * @param offset file offset.
+ * @param filename file name for error messages.
+ */
+void readFileExactly(int fd, void* data, std::size_t bytesCnt,
+                     std::size_t offset, const std::string& filename);
+
+/**
+ * @brief Read up to bytesCnt bytes at offset, retrying partial reads until at
+ * least minBytesCnt bytes are read. The end of a file may cut the rest, an
+ * end before minBytesCnt bytes throws std::system_error with EIO.
+ *
+ * @param fd file descriptor.
+ * @param data destination.
+ * @param bytesCnt bytes count asked.
+ * @param minBytesCnt bytes count which must be read.
+ * @param offset file offset.
+ * @param filename file name for error messages.
+ * @return bytes count read.
+ */
+std::size_t readFileAtLeast(int fd, void* data, std::size_t bytesCnt,
+                            std::size_t minBytesCnt, std::size_t offset,
+                            const std::string& filename);
+
+/**
+ * @brief Write exactly bytesCnt bytes at offset, retrying partial writes.
+ *
+ * @param fd file descriptor.
+ * @param data source.
+ * @param bytesCnt bytes count.
+ * @param offset file offset.
+ * @param filename file name for error messages.
+ */
+void writeFileExactly(int fd, const void* data, std::size_t bytesCnt,
+                      std::size_t offset, const std::string& filename);
+
+#endif
+
+#endif  // TAPE_SIMULATION_IMPL_FILE_IO_HPP
@@ -0,0 +1,98 @@
+#ifndef TAPE_SIMULATION_IMPL_FILE_TAPE_BACKEND_HPP
+#define TAPE_SIMULATION_IMPL_FILE_TAPE_BACKEND_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../tape_backend.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class FileTapeBackend - cells accessed through a file stream with a
+/// direction-aware read window and a write-back buffer.
+class FileTapeBackend : public TapeBackend {
+ public:
+  /// Read window refills are aligned to this number of cells.
+  constexpr static std::size_t readWindowAlignment = 1 << 10;
+
+ public:
+  /**
+   * @brief FileTapeBackend constructor.
+   *
+   * @param filename tape filename.
+   * @param size tape cells count.
+   * @param cellSize bytes count of a single cell.
+   * @param create create (or truncate) the file instead of opening it.
+   * @param dataOffset bytes before the first cell.
+   * @param readWindowSize number of cells cached around the head. Zero
+   * disables caching.
+   * @param writeBufferSize number of cells of consecutive writes coalesced
+   * before reaching the file. Zero disables buffering.
+   */
+  FileTapeBackend(const std::string& filename, std::size_t size,
+                  std::size_t cellSize, bool create, std::size_t dataOffset,
+                  std::size_t readWindowSize, std::size_t writeBufferSize);
+  FileTapeBackend(const FileTapeBackend&) = delete;
+  FileTapeBackend(FileTapeBackend&&) noexcept = delete;
+  FileTapeBackend& operator=(const FileTapeBackend&) = delete;
+  FileTapeBackend& operator=(FileTapeBackend&&) noexcept = delete;
+  ~FileTapeBackend() override;
+
+  void read(std::size_t position, std::byte* cell) override;
+
+  void write(std::size_t position, const std::byte* cell) override;
+
+  void readCells(std::size_t begin, std::span<std::byte> cells) override;
+
+  void writeCells(std::size_t begin, std::span<const std::byte> cells) override;
+
+  void headMoved(std::size_t position, Direction direction) override;
+
+  void flush() override;
+
+  [[nodiscard]] CacheStatistics getCacheStatistics() const override;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief enum class FileAccess - last stream operation kind.
+  enum class FileAccess {
+    None,
+    Read,
+    Write
+  };
+
+ private:
+  void seekTo_(std::size_t position, FileAccess access);
+  void readFromFile_(std::size_t position, char* data, std::size_t cellsCnt);
+  void writeToFile_(std::size_t position, const char* data,
+                    std::size_t cellsCnt);
+  void readThroughWindow_(std::size_t position, std::byte* cell);
+  void fillWindow_(std::size_t position);
+  void bufferWrite_(std::size_t position, const std::byte* cell);
+  void flushWriteBuffer_();
+
+ private:
+  std::size_t size_;
+  std::size_t dataOffset_;
+  std::fstream file_;
+  std::size_t filePosition_{0};
+  FileAccess lastAccess_{FileAccess::None};
+  std::size_t readWindowSize_;
+  std::vector<std::byte> window_;
+  std::size_t windowBegin_{0};
+  std::size_t windowLength_{0};
+  bool movingLeft_{false};
+  CacheStatistics cacheStatistics_{};
+  std::size_t writeBufferSize_;
+  std::vector<std::byte> writeBuffer_;
+  std::size_t writeBufferBegin_{0};
+  std::size_t dirtyBegin_{0};
+  std::size_t dirtyEnd_{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto FileTapeBackend::getCacheStatistics() const -> CacheStatistics {
+  return cacheStatistics_;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_FILE_TAPE_BACKEND_HPP
@@ -0,0 +1,123 @@
+#ifndef TAPE_SIMULATION_IMPL_LOSER_TREE_HPP
+#define TAPE_SIMULATION_IMPL_LOSER_TREE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class LoserTree - tournament tree over heads of k sorted sources.
+/// Internal nodes keep the loser of their match, so replacing the winner
+/// replays a single leaf-to-root path with ceil(log2(k)) comparisons.
+/// Exhausted sources lose to any value, equal values are won by the source
+/// with the smaller index.
+///
+/// @tparam T element type.
+/// @tparam Compare strict ordering, the winner is the first in it.
+template <class T, class Compare>
+class LoserTree {
+ public:
+  /**
+   * @brief LoserTree constructor.
+   *
+   * @param heads first elements of sources, std::nullopt for empty sources.
+   */
+  explicit LoserTree(std::vector<std::optional<T>> heads);
+
+  /**
+   * @brief Get index of a source holding the winner.
+   *
+   * @return source index.
+   */
+  [[nodiscard]] std::size_t getWinner() const;
+
+  /**
+   * @brief Get the winner value.
+   *
+   * @return winner or std::nullopt if all sources are exhausted.
+   */
+  [[nodiscard]] const std::optional<T>& getWinnerValue() const;
+
+  /**
+   * @brief Replace the winner by the next element of its source and replay
+   * matches on its path.
+   *
+   * @param next next element or std::nullopt if the source is exhausted.
+   */
+  void replaceWinner(std::optional<T> next);
+
+ private:
+  [[nodiscard]] bool beats_(std::size_t lhs, std::size_t rhs) const;
+
+ private:
+  std::vector<std::optional<T>> heads_;
+  std::vector<std::size_t> losers_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class Compare>
+LoserTree<T, Compare>::LoserTree(std::vector<std::optional<T>> heads)
+    : heads_(std::move(heads)), losers_(heads_.size()) {
+  const std::size_t k = heads_.size();
+  if (k == 0) {
+    throw std::invalid_argument("Loser tree needs at least one source.");
+  }
+  // Leaf i is node k + i, node n has children 2n and 2n + 1.
+  auto winners = std::vector<std::size_t>(2 * k);
+  for (std::size_t i = 0; i < k; ++i) {
+    winners[k + i] = i;
+  }
+  for (std::size_t node = k - 1; node > 0; --node) {
+    const std::size_t left = winners[2 * node];
+    const std::size_t right = winners[2 * node + 1];
+    const bool leftWins = beats_(left, right);
+    winners[node] = leftWins ? left : right;
+    losers_[node] = leftWins ? right : left;
+  }
+  losers_[0] = winners[1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class Compare>
+inline std::size_t LoserTree<T, Compare>::getWinner() const {
+  return losers_[0];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class Compare>
+inline auto LoserTree<T, Compare>::getWinnerValue() const
+    -> const std::optional<T>& {
+  return heads_[losers_[0]];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class Compare>
+void LoserTree<T, Compare>::replaceWinner(std::optional<T> next) {
+  std::size_t winner = losers_[0];
+  heads_[winner] = std::move(next);
+  for (std::size_t node = (winner + heads_.size()) / 2; node > 0; node /= 2) {
+    if (beats_(losers_[node], winner)) {
+      std::swap(losers_[node], winner);
+    }
+  }
+  losers_[0] = winner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T, class Compare>
+bool LoserTree<T, Compare>::beats_(std::size_t lhs, std::size_t rhs) const {
+  if (!heads_[lhs].has_value()) {
+    return false;
+  }
+  if (!heads_[rhs].has_value()) {
+    return true;
+  }
+  if (Compare()(*heads_[lhs], *heads_[rhs])) {
+    return true;
+  }
+  return !Compare()(*heads_[rhs], *heads_[lhs]) && lhs < rhs;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_LOSER_TREE_HPP
@@ -0,0 +1,61 @@
+#ifndef TAPE_SIMULATION_IMPL_MAPPED_FILE_HPP
+#define TAPE_SIMULATION_IMPL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MappedFile - owning wrapper over a file mapped into memory.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  /**
+   * @brief Map a file into memory. The file is created (or truncated) and
+   * resized to `bytesCnt` if `create` is set. Otherwise an existing file is
+   * mapped.
+   *
+   * @param filename file to map.
+   * @param bytesCnt number of bytes to map.
+   * @param create create a new file instead of opening an existing one.
+   */
+  MappedFile(const std::string& filename, std::size_t bytesCnt, bool create);
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  /**
+   * @brief Get mapped memory.
+   *
+   * @return pointer to the first mapped byte.
+   */
+  [[nodiscard]] std::byte* data() const;
+
+  /**
+   * @brief Get mapped bytes count.
+   *
+   * @return mapping length.
+   */
+  [[nodiscard]] std::size_t size() const;
+
+ private:
+  void unmap_() noexcept;
+
+ private:
+  std::byte* data_{nullptr};
+  std::size_t size_{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::byte* MappedFile::data() const {
+  return data_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t MappedFile::size() const {
+  return size_;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_MAPPED_FILE_HPP
@@ -0,0 +1,32 @@
+#ifndef TAPE_SIMULATION_IMPL_MEMORY_TAPE_BACKEND_HPP
+#define TAPE_SIMULATION_IMPL_MEMORY_TAPE_BACKEND_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../tape_backend.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MemoryTapeBackend - cells in anonymous memory. Nothing is
+/// written to the filesystem, cells are lost when the tape is destroyed.
+class MemoryTapeBackend : public TapeBackend {
+ public:
+  /**
+   * @brief MemoryTapeBackend constructor. All cells are zero.
+   *
+   * @param size tape cells count.
+   * @param cellSize bytes count of a single cell.
+   */
+  MemoryTapeBackend(std::size_t size, std::size_t cellSize);
+
+  [[nodiscard]] std::byte* getCells() override;
+
+  void read(std::size_t position, std::byte* cell) override;
+
+  void write(std::size_t position, const std::byte* cell) override;
+
+ private:
+  std::vector<std::byte> cells_;
+};
+
+#endif  // TAPE_SIMULATION_IMPL_MEMORY_TAPE_BACKEND_HPP
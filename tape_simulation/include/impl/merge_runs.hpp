@@ -0,0 +1,52 @@
+#ifndef TAPE_SIMULATION_IMPL_MERGE_RUNS_HPP
+#define TAPE_SIMULATION_IMPL_MERGE_RUNS_HPP
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../tape_view.hpp"
+#include "loser_tree.hpp"
+
+/**
+ * @brief merge runs read left from several tapes into a run written right
+ * with a loser tree. Each source head must be on the first cell of its run to
+ * read, a run of length `n` takes `n` reads and `n - 1` moves. Target head
+ * stops on the last written cell.
+ *
+ * @tparam Compare strict ordering of the merged run.
+ * @tparam T element type.
+ * @param sources source tapes.
+ * @param lengths lengths of source runs, none of them is zero.
+ * @param target output tape.
+ */
+template <class Compare, class T>
+void merge_runs(const std::vector<BasicTapeView<T>*>& sources,
+                const std::vector<std::size_t>& lengths,
+                BasicTapeView<T>& target) {
+  auto left = lengths;
+  auto heads = std::vector<std::optional<T>>{};
+  heads.reserve(sources.size());
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    heads.emplace_back(sources[i]->read());
+    total += lengths[i];
+  }
+  auto tree = LoserTree<T, Compare>(std::move(heads));
+  for (std::size_t written = 0; written < total; ++written) {
+    const std::size_t winner = tree.getWinner();
+    target.write(*tree.getWinnerValue());
+    if (written + 1 != total) {
+      target.moveRight();
+    }
+    if (--left[winner] == 0) {
+      tree.replaceWinner(std::nullopt);
+    } else {
+      sources[winner]->moveLeft();
+      tree.replaceWinner(sources[winner]->read());
+    }
+  }
+}
+
+#endif  // TAPE_SIMULATION_IMPL_MERGE_RUNS_HPP
@@ -1,11 +1,17 @@
 #ifndef TAPE_SIMULATION_IMPL_MERGE_SORT_ADDITIONAL_TAPES_MANAGER_HPP
 #define TAPE_SIMULATION_IMPL_MERGE_SORT_ADDITIONAL_TAPES_MANAGER_HPP
 
+#include <filesystem>
+#include <sstream>
 #include <string_view>
 
 #include "../tape_pool.hpp"
 
+template <class T>
 class MergeSortAdditionalTapesManager {
+ public:
+  using TapeViewT = BasicTapeView<T>;
+
  public:
   MergeSortAdditionalTapesManager(TapePool& tapePool, std::string_view path,
                                   std::size_t tapeSize);
@@ -16,19 +22,19 @@ class MergeSortAdditionalTapesManager {
   auto operator=(const MergeSortAdditionalTapesManager&) = delete;
   auto operator=(MergeSortAdditionalTapesManager&&) noexcept = delete;
 
-  TapeView createTmpTape_(std::string_view name, std::size_t size);
+  TapeViewT createTmpTape_(std::string_view name, std::size_t size);
 
-  TapeView& getInTape0(std::size_t iterationIdx);
+  TapeViewT& getInTape0(std::size_t iterationIdx);
 
-  TapeView& getInTape1(std::size_t iterationIdx);
+  TapeViewT& getInTape1(std::size_t iterationIdx);
 
-  TapeView& getOutTape0(std::size_t iterationIdx);
+  TapeViewT& getOutTape0(std::size_t iterationIdx);
 
-  TapeView& getOutTape1(std::size_t iterationIdx);
+  TapeViewT& getOutTape1(std::size_t iterationIdx);
 
-  TapeView& getInitialOutTape0();
+  TapeViewT& getInitialOutTape0();
 
-  TapeView& getInitialOutTape1();
+  TapeViewT& getInitialOutTape1();
 
   static bool openOrCreateTmpPath_(std::string_view tmpDirectory);
 
@@ -38,44 +44,107 @@ class MergeSortAdditionalTapesManager {
   TapePool* tapePool_{};
   const std::string path_;
   const bool needToRemove_;
-  TapeView tmpTape00_;
-  TapeView tmpTape01_;
-  TapeView tmpTape10_;
-  TapeView tmpTape11_;
+  TapeViewT tmpTape00_;
+  TapeViewT tmpTape01_;
+  TapeViewT tmpTape10_;
+  TapeViewT tmpTape11_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-inline TapeView& MergeSortAdditionalTapesManager::getInTape0(
-    std::size_t iterationIdx) {
+template <class T>
+MergeSortAdditionalTapesManager<T>::MergeSortAdditionalTapesManager(
+    TapePool& tapePool, std::string_view path, std::size_t tapeSize)
+    : tapePool_{&tapePool},
+      path_{path},
+      // Memory backed temporary tapes need no directory.
+      needToRemove_{tapePool.getTmpBackendType() != TapeBackendType::Memory &&
+                    openOrCreateTmpPath_(path)},
+      tmpTape00_{createTmpTape_("00", tapeSize)},
+      tmpTape01_{createTmpTape_("01", tapeSize)},
+      tmpTape10_{createTmpTape_("10", tapeSize)},
+      tmpTape11_{createTmpTape_("11", tapeSize)} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+bool MergeSortAdditionalTapesManager<T>::openOrCreateTmpPath_(
+    std::string_view tmpDirectory) {
+  if (!std::filesystem::exists(tmpDirectory)) {
+    std::filesystem::create_directory(tmpDirectory);
+    return true;
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto MergeSortAdditionalTapesManager<T>::createTmpTape_(
+    std::string_view nameSuffix, std::size_t size) -> TapeViewT {
+  std::stringstream filenameStream;
+  filenameStream << path_ << "/tmp_tape_" << nameSuffix;
+  return tapePool_->createTape<T>(filenameStream.str(), size,
+                                  tapePool_->getTmpBackendType());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+MergeSortAdditionalTapesManager<T>::~MergeSortAdditionalTapesManager() {
+  tapePool_->removeTape(tmpTape00_.getHandle());
+  tapePool_->removeTape(tmpTape01_.getHandle());
+  tapePool_->removeTape(tmpTape10_.getHandle());
+  tapePool_->removeTape(tmpTape11_.getHandle());
+
+  if (needToRemove_) {
+    std::filesystem::remove(path_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline auto MergeSortAdditionalTapesManager<T>::getInTape0(
+    std::size_t iterationIdx) -> TapeViewT& {
   return (iterationIdx % 2 == 0) ? tmpTape00_ : tmpTape10_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline TapeView& MergeSortAdditionalTapesManager::getInTape1(
-    std::size_t iterationIdx) {
+template <class T>
+inline auto MergeSortAdditionalTapesManager<T>::getInTape1(
+    std::size_t iterationIdx) -> TapeViewT& {
   return (iterationIdx % 2 == 0) ? tmpTape01_ : tmpTape11_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline TapeView& MergeSortAdditionalTapesManager::getOutTape0(
-    std::size_t iterationIdx) {
+template <class T>
+inline auto MergeSortAdditionalTapesManager<T>::getOutTape0(
+    std::size_t iterationIdx) -> TapeViewT& {
   return (iterationIdx % 2 == 0) ? tmpTape10_ : tmpTape00_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline TapeView& MergeSortAdditionalTapesManager::getOutTape1(
-    std::size_t iterationIdx) {
+template <class T>
+inline auto MergeSortAdditionalTapesManager<T>::getOutTape1(
+    std::size_t iterationIdx) -> TapeViewT& {
   return (iterationIdx % 2 == 0) ? tmpTape11_ : tmpTape01_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline TapeView& MergeSortAdditionalTapesManager::getInitialOutTape0() {
+template <class T>
+inline auto MergeSortAdditionalTapesManager<T>::getInitialOutTape0()
+    -> TapeViewT& {
   return tmpTape00_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline TapeView& MergeSortAdditionalTapesManager::getInitialOutTape1() {
+template <class T>
+inline auto MergeSortAdditionalTapesManager<T>::getInitialOutTape1()
+    -> TapeViewT& {
   return tmpTape01_;
 }
 
+extern template class MergeSortAdditionalTapesManager<std::int32_t>;
+extern template class MergeSortAdditionalTapesManager<std::int64_t>;
+extern template class MergeSortAdditionalTapesManager<std::uint64_t>;
+extern template class MergeSortAdditionalTapesManager<float>;
+extern template class MergeSortAdditionalTapesManager<double>;
+
 #endif  // TAPE_SIMULATION_IMPL_MERGE_SORT_ADDITIONAL_TAPES_MANAGER_HPP
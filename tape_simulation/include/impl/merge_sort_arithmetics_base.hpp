@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <vector>
 
 class MergeSortArithmeticsBase {
  protected:
@@ -25,6 +26,16 @@ class MergeSortArithmeticsBase {
     std::size_t cnt1;
   };
 
+  /// Lengths of runs of any length on a tape in order of writing.
+  using Runs_ = std::vector<std::size_t>;
+
+  /// Runs of a couple of tapes. The first tape has the same number of runs
+  /// or one run more.
+  struct RunsCouple_ {
+    Runs_ runs0;
+    Runs_ runs1;
+  };
+
  protected:
   MergeSortArithmeticsBase(std::size_t elementsCnt,
                            std::size_t initialBlockSize);
@@ -41,6 +52,25 @@ class MergeSortArithmeticsBase {
   [[nodiscard]] Counts_ calcTailsCounts_(std::size_t blocksCnt1,
                                          std::size_t blockSize) const;
 
+  /**
+   * @brief Calculate runs after a merge iteration over runs of any length.
+   * Tapes are read left, so the last written runs are merged first. Merged
+   * runs are written to the output tapes alternately.
+   *
+   * @param runs runs of input tapes.
+   * @return runs of output tapes.
+   */
+  [[nodiscard]] static RunsCouple_ calcMergedRuns_(RunsCouple_ runs);
+
+  /**
+   * @brief Calculate merge iterations count for runs of any length before
+   * the last merge into the output tape.
+   *
+   * @param runsCnt initial runs count.
+   * @return iterations count.
+   */
+  [[nodiscard]] static std::size_t calcRunsIterationsCnt_(std::size_t runsCnt);
+
  private:
   [[nodiscard]] std::size_t calcIterationsCnt_() const;
 
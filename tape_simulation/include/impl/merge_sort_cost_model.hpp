@@ -0,0 +1,47 @@
+#ifndef TAPE_SIMULATION_IMPL_MERGE_SORT_COST_MODEL_HPP
+#define TAPE_SIMULATION_IMPL_MERGE_SORT_COST_MODEL_HPP
+
+#include <cstdint>
+
+#include "merge_sort_arithmetics_base.hpp"
+#include "tape_pool_statistics_base.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MergeSortCostModel - operations counts of MergeSort and
+/// ImprovedMergeSortImproved with fixed initial blocks. Counts do not depend
+/// on values, so they follow from the elements count and the initial block
+/// size.
+class MergeSortCostModel : private MergeSortArithmeticsBase {
+ public:
+  using IOStatistics = TapePoolStatisticsBase::IOStatistics;
+
+ public:
+  /**
+   * @brief MergeSortCostModel constructor.
+   *
+   * @param elementsCnt input tape size.
+   * @param initialBlockSize length of initial blocks, one for MergeSort and
+   * the heap size limit for ImprovedMergeSortImproved.
+   */
+  MergeSortCostModel(std::size_t elementsCnt, std::size_t initialBlockSize);
+
+  /**
+   * @brief Predict statistics of a sort of an input tape which is not opened
+   * before the sort and is not marked sorted in its header. The input is not
+   * scanned before the sort. Counts are found pass by pass without tapes, so
+   * any size fitting std::size_t may be predicted. Throws std::overflow_error
+   * if counts do not fit std::size_t.
+   *
+   * @return predicted statistics.
+   */
+  [[nodiscard]] IOStatistics predict() const;
+
+ private:
+  [[nodiscard]] Counts_ calcTapesCounts_(std::size_t blockSize) const;
+
+  [[nodiscard]] static std::size_t calcMovesCnt_(Counts_ counts);
+
+  [[nodiscard]] static std::size_t checkSize_(std::size_t size);
+};
+
+#endif  // TAPE_SIMULATION_IMPL_MERGE_SORT_COST_MODEL_HPP
@@ -1,19 +1,46 @@
 #ifndef TAPE_SIMULATION_IMPL_MERGE_SORT_IMPL_HPP
 #define TAPE_SIMULATION_IMPL_MERGE_SORT_IMPL_HPP
 
+#include <array>
+#include <cassert>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "../copy_n.hpp"
+#include "../merge.hpp"
+#include "../merge_pipeline.hpp"
+#include "../run_generation.hpp"
 #include "../tape_pool.hpp"
 #include "../tape_view.hpp"
 #include "../tape_view_read_iterators.hpp"
 #include "../tape_view_write_iterators.hpp"
 #include "merge_sort_additional_tapes_manager.hpp"
 #include "merge_sort_arithmetics_base.hpp"
+#include "replacement_selection.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief class MergeSortImpl
+template <class T>
 class MergeSortImpl : protected MergeSortArithmeticsBase {
+ protected:
+  using TapeViewT = BasicTapeView<T>;
+  using LeftReadIteratorT = BasicLeftReadIterator<T>;
+  using RightReadIteratorT = BasicRightReadIterator<T>;
+  using RightWriteIteratorT = BasicRightWriteIterator<T>;
+  using LeftWriteIteratorT = BasicLeftWriteIterator<T>;
+
+ protected:
+  /// Maximal sorted run of the input found by a scan.
+  struct NaturalRun_ {
+    std::size_t length;
+    bool increasing;
+  };
+
  protected:
   class ZeroInitialBlockSize_ : std::invalid_argument {
     public:
@@ -21,9 +48,34 @@ class MergeSortImpl : protected MergeSortArithmeticsBase {
   };
 
  protected:
+  /**
+   * @brief MergeSortImpl constructor.
+   *
+   * @param tapePool pool of tapes.
+   * @param inFilename tape to sort.
+   * @param tmpDirectory directory of temporary tapes.
+   * @param initialBlockSize length of initial blocks.
+   * @param increasing sort order.
+   * @param runGeneration way of making initial runs. Temporary tapes take
+   * the whole input unless runs are fixed blocks.
+   * @param preScan scan the input for natural runs before sorting.
+   * @param parallelPasses merge blocks to both output tapes of a pass at once
+   * if temporary tapes are addressable in memory.
+   * @param mergePipeline pipeline of long merges of blocks, merges are done
+   * on a single thread if null.
+   */
   MergeSortImpl(TapePool& tapePool, std::string_view inFilename,
                 std::string_view tmpDirectory, std::size_t initialBlockSize,
-                bool increasing);
+                bool increasing,
+                RunGeneration runGeneration = RunGeneration::FixedBlocks,
+                bool preScan = false, bool parallelPasses = false,
+                MergePipeline* mergePipeline = nullptr);
+
+ private:
+  MergeSortImpl(TapePool& tapePool, const TapeViewT& inTape,
+                std::string_view tmpDirectory, std::size_t initialBlockSize,
+                bool increasing, RunGeneration runGeneration, bool preScan,
+                bool parallelPasses, MergePipeline* mergePipeline);
 
  public:
   MergeSortImpl() = delete;
@@ -73,13 +125,13 @@ class MergeSortImpl : protected MergeSortArithmeticsBase {
    * tape.
    * @param blockSize block size.
    */
-  void mergeBlocks0AndCheck_(TapeView& in0, TapeView& in1, TapeView& out0,
-                             TapeView& out1, std::size_t blockSize,
+  void mergeBlocks0AndCheck_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                             TapeViewT& out1, std::size_t blockSize,
                              bool increasing) const;
 
-  void mergeBlocks0_(LeftReadIterator read0, LeftReadIterator read1,
-                     RightWriteIterator write0, RightWriteIterator write1,
-                     std::size_t blockSize, bool increasing) const;
+  void mergeBlocks0_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                     TapeViewT& out1, std::size_t blockSize,
+                     bool increasing) const;
 
   /**
    * @brief mergeBlocks1_
@@ -102,56 +154,840 @@ class MergeSortImpl : protected MergeSortArithmeticsBase {
    * tape.
    * @param blockSize block size.
    */
-  void mergeBlocks1AndCheck_(TapeView& in0, TapeView& in1, TapeView& out0,
-                             TapeView& out1, std::size_t blockSize,
+  void mergeBlocks1AndCheck_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                             TapeViewT& out1, std::size_t blockSize,
                              bool increasing) const;
 
-  void mergeBlocks1_(LeftReadIterator read0, LeftReadIterator read1,
-                     RightWriteIterator write0, RightWriteIterator write1,
-                     std::size_t blockSize, bool increasing) const;
+  void mergeBlocks1_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                     TapeViewT& out1, std::size_t blockSize,
+                     bool increasing) const;
+
+  void processPartialBlocks_(TapeViewT& in0, std::size_t cnt0, TapeViewT& in1,
+                             std::size_t cnt1, TapeViewT& out,
+                             bool increasing) const;
+
+  void processBlocksPairs_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                           std::size_t blocksOut0, TapeViewT& out1,
+                           std::size_t blocksOut1, std::size_t blockSize,
+                           bool increasing) const;
+
+  /**
+   * @brief Merge blocks to out0 in another thread with own heads over the
+   * input tapes, while the heads of in0 and in1 go on to the blocks of out1.
+   * Reads and writes are the same as of a sequential pass, moves of the
+   * other heads over blocks of out0 are added.
+   */
+  void processBlocksPairsInParallel_(TapeViewT& in0, TapeViewT& in1,
+                                     TapeViewT& out0, std::size_t blocksOut0,
+                                     TapeViewT& out1, std::size_t blocksOut1,
+                                     std::size_t blockSize,
+                                     bool increasing) const;
+
+  void mergeBlocksPairs_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out,
+                         std::size_t blocksCnt, std::size_t blockSize,
+                         bool increasing) const;
+
+  void mergeIntoOutputTape_(TapeViewT& inTape0, TapeViewT& inTape1,
+                            TapeViewT& outTape) const;
+
+  /**
+   * @brief Merge blocks read left to a block written right. Long merges go
+   * through the merge pipeline if there is one.
+   */
+  void merge_(TapeViewT& in0, std::size_t n0, TapeViewT& in1, std::size_t n1,
+              TapeViewT& out, bool increasing) const;
+
+  void mergePipelined_(TapeViewT& in0, std::size_t n0, TapeViewT& in1,
+                       std::size_t n1, TapeViewT& out, bool increasing) const;
+
+  /**
+   * @brief Sort with initial runs of any length made in the way given to the
+   * constructor.
+   *
+   * @param in input tape. The head must be in the beginning of a tape.
+   * @param out output tape. The head must be in the beginning of a tape.
+   */
+  void sortRuns_(TapeViewT& in, TapeViewT& out);
+
+  /**
+   * @brief Scan the input and sort it from the natural runs found if they are
+   * longer than initial blocks on average or natural runs are asked for.
+   * Sorted input is copied and reverse sorted input is written left.
+   * Temporary tapes are not created before the scan.
+   *
+   * @param in input tape. The head must be in the beginning of a tape.
+   * @param out output tape. The head must be in the beginning of a tape.
+   * @return true if the input was sorted.
+   */
+  bool preScanAndSort_(TapeViewT& in, TapeViewT& out);
+
+  /**
+   * @brief Merge runs of any length couple by couple, writing merged runs to
+   * the output tapes of the iteration alternately.
+   *
+   * @param runs runs of the input tapes. Heads must be at the ends of tapes.
+   * @param iterationIndex iteration index.
+   * @param increasing order of merged runs.
+   */
+  void mergeRuns_(RunsCouple_ runs, std::size_t iterationIndex,
+                  bool increasing);
+
+  /**
+   * @brief Merge the last couple of runs of any length into the output tape.
+   * If runs are read in the order opposite to the sort order, the output tape
+   * is written left from its end.
+   *
+   * @param runs runs of the input tapes, one on each or one on the first.
+   * @param iterationIndex iteration index after the last mergeRuns_.
+   * @param outTape output tape. The head must be in the beginning of a tape.
+   * @param increasing order of runs read left.
+   */
+  void mergeRunsIntoOutputTape_(const RunsCouple_& runs,
+                                std::size_t iterationIndex, TapeViewT& outTape,
+                                bool increasing);
+
+  /**
+   * @brief Merge runs of any length until the output tape is written.
+   *
+   * @param runs initial runs on the initial output tapes.
+   * @param increasing order of initial runs.
+   * @param out output tape. The head must be in the beginning of a tape.
+   */
+  void mergeRunsIterations_(RunsCouple_ runs, bool increasing,
+                            TapeViewT& out);
+
+  void sortReplacementSelectionRuns_(TapeViewT& in, TapeViewT& out);
+
+  [[nodiscard]] RunsCouple_ makeReplacementSelectionRuns_(TapeViewT& in,
+                                                          bool increasing);
+
+  void sortNaturalRuns_(TapeViewT& in, TapeViewT& out);
+
+  /**
+   * @brief Sort from natural runs found by a scan.
+   *
+   * @param in input tape. The head must be in the beginning of a tape.
+   * @param out output tape. The head must be in the beginning of a tape.
+   * @param naturalRuns runs of the input.
+   */
+  void sortFoundRuns_(TapeViewT& in, TapeViewT& out,
+                      const std::vector<NaturalRun_>& naturalRuns);
+
+  /**
+   * @brief Find maximal runs of the input. A run is increasing if it is not
+   * decreasing. The head returns to the beginning of a tape. Reads and moves
+   * are counted as scan ones in pool statistics.
+   *
+   * @param in input tape. The head must be in the beginning of a tape.
+   * @return runs in input order.
+   */
+  [[nodiscard]] std::vector<NaturalRun_> scanNaturalRuns_(TapeViewT& in) const;
 
-  void processPartialBlocks_(LeftReadIterator& in0, std::size_t cnt0,
-                             LeftReadIterator& in1, std::size_t cnt1,
-                             RightWriteIterator& out0, bool increasing) const;
+  /**
+   * @brief Write natural runs to the initial output tapes alternately, runs
+   * of the other order are written left, which reverses them.
+   *
+   * @param in input tape. The head must be in the beginning of a tape.
+   * @param naturalRuns runs of the input.
+   * @param increasing order of written runs.
+   * @return runs on the initial output tapes.
+   */
+  [[nodiscard]] RunsCouple_ distributeNaturalRuns_(
+      TapeViewT& in, const std::vector<NaturalRun_>& naturalRuns,
+      bool increasing);
 
-  void processBlocksPairs_(LeftReadIterator& in0, LeftReadIterator& in1,
-                           RightWriteIterator& out0, std::size_t blocksOut0,
-                           RightWriteIterator& out1, std::size_t blocksOUt1,
-                           std::size_t blockSize, bool increasing) const;
+  template <class OutputIterator>
+  void mergeRunsCouple_(LeftReadIteratorT in0, std::size_t n0,
+                        LeftReadIteratorT in1, std::size_t n1,
+                        OutputIterator out, bool increasing) const;
 
-  void mergeIntoOutputTape_(TapeView& inTape0, TapeView& inTape1,
-                            TapeView& outTape) const;
+  /**
+   * @brief Create output tape in the format of the input tape.
+   *
+   * @param inTape input tape.
+   * @param outFilename output tape filename.
+   * @return a view to a created tape.
+   */
+  [[nodiscard]] TapeViewT createOutTape_(const TapeViewT& inTape,
+                                         std::string_view outFilename) const;
 
-  void merge_(LeftReadIterator in0, std::size_t n0, LeftReadIterator in1,
-              std::size_t n1, RightWriteIterator out, bool increasing) const;
+  /**
+   * @brief Copy input to output as is if the input header says it is already
+   * sorted in the requested order.
+   *
+   * @param inTape input tape. The head must be in the beginning of a tape.
+   * @param outTape output tape. The head must be in the beginning of a tape.
+   * @return true if the input was copied.
+   */
+  bool copyIfSorted_(TapeViewT& inTape, TapeViewT& outTape) const;
+
+  /**
+   * @brief Record the sort order in the output header and close the tape.
+   *
+   * @param outTape output tape.
+   */
+  void closeSortedOutTape_(TapeViewT& outTape) const;
 
+  /**
+   * @brief Get temporary tapes manager. Tapes are created on the first call,
+   * which is in the constructor unless the input is scanned first.
+   *
+   * @return temporary tapes manager.
+   */
+  MergeSortAdditionalTapesManager<T>& getTapesManager_();
 
   ~MergeSortImpl();
 
  private:
   //////////////////////////////////////////////////////////////////////////////
   // Checks                                                                   //
-  void checkStartPositions_(TapeView& in0, TapeView& in1, TapeView& out0,
-                            TapeView& out1, std::size_t blockSize) const;
+  void checkStartPositions_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                            TapeViewT& out1, std::size_t blockSize) const;
 
-  void checkFinishPositions_(TapeView& in0, TapeView& in1, TapeView& out0,
-                             TapeView& out1, std::size_t blockSize) const;
+  void checkFinishPositions_(TapeViewT& in0, TapeViewT& in1, TapeViewT& out0,
+                             TapeViewT& out1, std::size_t blockSize) const;
 
-  void checkFinalPositions_(const TapeView& in0, const TapeView& in1) const;
+  void checkFinalPositions_(const TapeViewT& in0, const TapeViewT& in1) const;
   //                                                                          //
   //////////////////////////////////////////////////////////////////////////////
 
-
  protected:
   TapePool* tapePool_;
   const bool increasing_;
-  MergeSortAdditionalTapesManager tapesManager_;
-  std::string inFilename_;
+  const RunGeneration runGeneration_;
+  const bool preScan_;
+  TapeHandle inHandle_;
+
+ private:
+  std::string tmpDirectory_;
+  std::size_t tmpTapesSize_;
+  std::optional<MergeSortAdditionalTapesManager<T>> tapesManager_;
+  const bool parallelPasses_;
+  MergePipeline* mergePipeline_;
 };
 
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+MergeSortImpl<T>::ZeroInitialBlockSize_::ZeroInitialBlockSize_()
+    : std::invalid_argument(
+          "Trying creating sort instance with zero initial block size.") {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+MergeSortImpl<T>::MergeSortImpl(TapePool& tapePool, std::string_view inFilename,
+                                std::string_view tmpDirectory,
+                                std::size_t initialBlockSize, bool increasing,
+                                RunGeneration runGeneration, bool preScan,
+                                bool parallelPasses,
+                                MergePipeline* mergePipeline)
+    : MergeSortImpl(tapePool, tapePool.getOrOpenTape<T>(inFilename),
+                    tmpDirectory, initialBlockSize, increasing, runGeneration,
+                    preScan, parallelPasses, mergePipeline) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+MergeSortImpl<T>::MergeSortImpl(TapePool& tapePool, const TapeViewT& inTape,
+                                std::string_view tmpDirectory,
+                                std::size_t initialBlockSize, bool increasing,
+                                RunGeneration runGeneration, bool preScan,
+                                bool parallelPasses,
+                                MergePipeline* mergePipeline)
+    try : MergeSortArithmeticsBase(inTape.getSize(), initialBlockSize),
+      tapePool_{&tapePool},
+      increasing_{increasing},
+      runGeneration_{runGeneration},
+      preScan_{preScan},
+      inHandle_{inTape.getHandle()},
+      tmpDirectory_{tmpDirectory},
+      tmpTapesSize_{(runGeneration == RunGeneration::FixedBlocks)
+                        ? maxBlockSize_
+                        : elementsCnt_},
+      parallelPasses_{parallelPasses},
+      mergePipeline_{mergePipeline} {
+  if (!preScan_) {
+    getTapesManager_();
+  }
+} catch (MergeSortArithmeticsBase::ZeroInitialBlockSize_& e) {
+  throw ZeroInitialBlockSize_();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline MergeSortImpl<T>::~MergeSortImpl() {
+  tapePool_->closeTape(inHandle_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto MergeSortImpl<T>::createOutTape_(const TapeViewT& inTape,
+                                      std::string_view outFilename) const
+    -> TapeViewT {
+  return tapePool_->createTape<T>(
+      outFilename, elementsCnt_, std::nullopt,
+      inTape.getMetadata().has_value() ? TapeFormat::WithHeader
+                                       : TapeFormat::Raw);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+bool MergeSortImpl<T>::copyIfSorted_(TapeViewT& inTape,
+                                     TapeViewT& outTape) const {
+  const auto& metadata = inTape.getMetadata();
+  const auto order = increasing_ ? TapeOrder::Increasing : TapeOrder::Decreasing;
+  if (!metadata.has_value() || metadata->order != order) {
+    return false;
+  }
+  copy_n(RightReadIteratorT(inTape), elementsCnt_,
+         RightWriteIteratorT(outTape));
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::closeSortedOutTape_(TapeViewT& outTape) const {
+  outTape.markSorted(increasing_ ? TapeOrder::Increasing
+                                 : TapeOrder::Decreasing);
+  tapePool_->closeTape(outTape.getHandle());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto MergeSortImpl<T>::getTapesManager_()
+    -> MergeSortAdditionalTapesManager<T>& {
+  if (!tapesManager_.has_value()) {
+    tapesManager_.emplace(*tapePool_, tmpDirectory_, tmpTapesSize_);
+  }
+  return *tapesManager_;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-inline MergeSortImpl::~MergeSortImpl() {
-  tapePool_->closeTape(inFilename_);
+template <class T>
+void MergeSortImpl<T>::processPartialBlocks_(TapeViewT& in0, std::size_t cnt0,
+                                             TapeViewT& in1, std::size_t cnt1,
+                                             TapeViewT& out,
+                                             bool increasing) const {
+  if (cnt1 == 0) {
+    copy_n(LeftReadIteratorT(in0), cnt0, RightWriteIteratorT(out));
+  } else {
+    merge_(in0, cnt0, in1, cnt1, out, increasing);
+  }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::processBlocksPairs_(
+    TapeViewT& in0, TapeViewT& in1, TapeViewT& out0, std::size_t blocksOut0,
+    TapeViewT& out1, std::size_t blocksOut1, std::size_t blockSize,
+    bool increasing) const {
+  if (parallelPasses_ && blocksOut0 != 0 && blocksOut1 != 0 &&
+      in0.canMakeReadHead() && in1.canMakeReadHead()) {
+    processBlocksPairsInParallel_(in0, in1, out0, blocksOut0, out1,
+                                  blocksOut1, blockSize, increasing);
+    return;
+  }
+  mergeBlocksPairs_(in0, in1, out0, blocksOut0, blockSize, increasing);
+
+  if (blocksOut1 != 0) {
+    in0.moveLeft();
+    in1.moveLeft();
+    mergeBlocksPairs_(in0, in1, out1, blocksOut1, blockSize, increasing);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::processBlocksPairsInParallel_(
+    TapeViewT& in0, TapeViewT& in1, TapeViewT& out0, std::size_t blocksOut0,
+    TapeViewT& out1, std::size_t blocksOut1, std::size_t blockSize,
+    bool increasing) const {
+  // The other thread merges with views of its own. Their counts go to the
+  // owners of the given views, which are not always the pool.
+  auto counters = std::array<TapeOperationsCounter, 3>{};
+  auto head0 = in0.makeReadHead(counters[0]);
+  auto head1 = in1.makeReadHead(counters[1]);
+  auto otherOut0 = out0.countedBy(counters[2]);
+  auto error = std::exception_ptr();
+  {
+    auto thread = std::jthread([&]() {
+      try {
+        mergeBlocksPairs_(head0, head1, otherOut0, blocksOut0, blockSize,
+                          increasing);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    });
+
+    in0.moveLeftRepeated(blocksOut0 * blockSize);
+    in1.moveLeftRepeated(blocksOut0 * blockSize);
+    mergeBlocksPairs_(in0, in1, out1, blocksOut1, blockSize, increasing);
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  in0.addStatistics(counters[0].getStatistics());
+  in1.addStatistics(counters[1].getStatistics());
+  out0.addStatistics(counters[2].getStatistics());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeBlocksPairs_(TapeViewT& in0, TapeViewT& in1,
+                                         TapeViewT& out, std::size_t blocksCnt,
+                                         std::size_t blockSize,
+                                         bool increasing) const {
+  for (std::size_t i = 0; i < blocksCnt; ++i) {
+    merge_(in0, blockSize, in1, blockSize, out, increasing);
+    if (i + 1 != blocksCnt) {
+      in0.moveLeft();
+      in1.moveLeft();
+      out.moveRight();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeBlocks_(std::size_t blockSize,
+                                    std::size_t iterationIndex,
+                                    std::size_t iterationsLeft) {
+  const bool increasing =
+      (iterationsLeft % 2 == 1) ? !increasing_ : increasing_;
+  auto& tapesManager = getTapesManager_();
+  auto& in0 = tapesManager.getInTape0(iterationIndex);
+  auto& in1 = tapesManager.getInTape1(iterationIndex);
+  auto& out0 = tapesManager.getOutTape0(iterationIndex);
+  auto& out1 = tapesManager.getOutTape1(iterationIndex);
+  if (iterationIndex % 2 == 1) {
+    mergeBlocks1AndCheck_(in0, in1, out0, out1, blockSize, increasing);
+  } else {
+    mergeBlocks0AndCheck_(in0, in1, out0, out1, blockSize, increasing);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeBlocks0AndCheck_(TapeViewT& in0, TapeViewT& in1,
+                                             TapeViewT& out0, TapeViewT& out1,
+                                             std::size_t blockSize,
+                                             bool increasing) const {
+  checkStartPositions_(in0, in1, out0, out1, blockSize);
+
+  mergeBlocks0_(in0, in1, out0, out1, blockSize, increasing);
+
+  checkFinishPositions_(in0, in1, out0, out1, blockSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeBlocks0_(TapeViewT& in0, TapeViewT& in1,
+                                     TapeViewT& out0, TapeViewT& out1,
+                                     std::size_t blockSize,
+                                     bool increasing) const {
+  const auto [_0, _1, blocksIn1, blocksOut, blocksOut0, blocksOut1] =
+      calcOperationBlocksCnts_(blockSize);
+
+  auto [inTailSize0, inTailSize1] = calcTailsCounts_(blocksIn1, blockSize);
+
+  if (inTailSize0 + inTailSize1 != 0) {
+    const bool tailTo0 = (blocksOut % 2 == 0);
+    auto& tailOut = tailTo0 ? out0 : out1;
+
+    processPartialBlocks_(in0, inTailSize0, in1, inTailSize1, tailOut,
+                          increasing);
+    if (const auto blocksAfterTailWrite = tailTo0 ? blocksOut0 : blocksOut1;
+        blocksAfterTailWrite != 0) {
+      tailOut.moveRight();
+    }
+    in0.moveLeft();
+    if (inTailSize1 != 0) {
+      in1.moveLeft();
+    }
+  }
+
+  processBlocksPairs_(in0, in1, out0, blocksOut0, out1, blocksOut1, blockSize,
+                      increasing);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeBlocks1AndCheck_(TapeViewT& in0, TapeViewT& in1,
+                                             TapeViewT& out0, TapeViewT& out1,
+                                             std::size_t blockSize,
+                                             bool increasing) const {
+  checkStartPositions_(in0, in1, out0, out1, blockSize);
+
+  mergeBlocks1_(in0, in1, out0, out1, blockSize, increasing);
+
+  checkFinishPositions_(in0, in1, out0, out1, blockSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeBlocks1_(TapeViewT& in0, TapeViewT& in1,
+                                     TapeViewT& out0, TapeViewT& out1,
+                                     std::size_t blockSize,
+                                     bool increasing) const {
+  const auto [_0, _1, blocksIn1, blocksOut, blocksOut0, blocksOut1] =
+      calcOperationBlocksCnts_(blockSize);
+
+  processBlocksPairs_(in0, in1, out0, blocksOut0, out1, blocksOut1, blockSize,
+                      increasing);
+
+  auto [inTailSize0, inTailSize1] = calcTailsCounts_(blocksIn1, blockSize);
+
+  if (inTailSize0 != 0 || inTailSize1 != 0) {
+    auto& tailOut = (blocksOut % 2 == 0) ? out0 : out1;
+
+    if (blocksOut != 0) {
+      in0.moveLeft();
+
+      if (inTailSize1 != 0) {
+        in1.moveLeft();
+      }
+
+      if (inTailSize0 + inTailSize1 != 0 && blocksOut1 != 0) {
+        tailOut.moveRight();
+      }
+    }
+
+    processPartialBlocks_(in0, inTailSize0, in1, inTailSize1, tailOut,
+                          increasing);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeIntoOutputTape_(TapeViewT& inTape0,
+                                            TapeViewT& inTape1,
+                                            TapeViewT& outTape) const {
+  checkFinalPositions_(inTape0, inTape1);
+
+  merge_(inTape0, maxBlockSize_, inTape1, elementsCnt_ - maxBlockSize_, outTape,
+         increasing_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::merge_(TapeViewT& in0, std::size_t n0, TapeViewT& in1,
+                              std::size_t n1, TapeViewT& out,
+                              bool increasing) const {
+  if (mergePipeline_ != nullptr && mergePipeline_->isWorthPipelining(n0 + n1)) {
+    mergePipelined_(in0, n0, in1, n1, out, increasing);
+  } else if (increasing) {
+    merge_increasing(LeftReadIteratorT(in0), n0, LeftReadIteratorT(in1), n1,
+                     RightWriteIteratorT(out));
+  } else {
+    merge_decreasing(LeftReadIteratorT(in0), n0, LeftReadIteratorT(in1), n1,
+                     RightWriteIteratorT(out));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergePipelined_(TapeViewT& in0, std::size_t n0,
+                                       TapeViewT& in1, std::size_t n1,
+                                       TapeViewT& out, bool increasing) const {
+  // Stages run on other threads with views of their own. Their counts go to
+  // the owners of the given views, which are not always the pool.
+  auto counters = std::array<TapeOperationsCounter, 3>{};
+  auto read0 = in0.countedBy(counters[0]);
+  auto read1 = in1.countedBy(counters[1]);
+  auto write = out.countedBy(counters[2]);
+  if (increasing) {
+    mergePipeline_->merge<std::less<>>(
+        LeftReadIteratorT(read0), n0, LeftReadIteratorT(read1), n1,
+        RightWriteIteratorT(write));
+  } else {
+    mergePipeline_->merge<std::greater<>>(
+        LeftReadIteratorT(read0), n0, LeftReadIteratorT(read1), n1,
+        RightWriteIteratorT(write));
+  }
+  in0.addStatistics(counters[0].getStatistics());
+  in1.addStatistics(counters[1].getStatistics());
+  out.addStatistics(counters[2].getStatistics());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::sortRuns_(TapeViewT& in, TapeViewT& out) {
+  if (runGeneration_ == RunGeneration::NaturalRuns) {
+    sortNaturalRuns_(in, out);
+  } else {
+    sortReplacementSelectionRuns_(in, out);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeRunsIterations_(RunsCouple_ runs, bool increasing,
+                                            TapeViewT& out) {
+  const std::size_t iterationsCnt =
+      calcRunsIterationsCnt_(runs.runs0.size() + runs.runs1.size());
+  for (std::size_t iterationIdx = 0; iterationIdx < iterationsCnt;
+       ++iterationIdx) {
+    increasing = !increasing;
+    mergeRuns_(runs, iterationIdx, increasing);
+    runs = calcMergedRuns_(std::move(runs));
+  }
+  mergeRunsIntoOutputTape_(runs, iterationsCnt, out, !increasing);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::sortReplacementSelectionRuns_(TapeViewT& in,
+                                                     TapeViewT& out) {
+  // Runs are made in the sort order as partially sorted input is most likely
+  // sorted that way. Runs count is known only after runs are made, so the
+  // output tape is written left if the last merge reads runs in the order
+  // opposite to the sort one.
+  mergeRunsIterations_(makeReplacementSelectionRuns_(in, increasing_),
+                       increasing_, out);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto MergeSortImpl<T>::makeReplacementSelectionRuns_(TapeViewT& in,
+                                                     bool increasing)
+    -> RunsCouple_ {
+  auto read = RightReadIteratorT(in);
+  auto writes = std::vector<RightWriteIteratorT>{
+      RightWriteIteratorT(getTapesManager_().getInitialOutTape0()),
+      RightWriteIteratorT(getTapesManager_().getInitialOutTape1())};
+  auto runs = increasing
+                  ? replacement_selection<std::less<>>(
+                        read, elementsCnt_, std::move(writes),
+                        initialBlockSize_)
+                  : replacement_selection<std::greater<>>(
+                        read, elementsCnt_, std::move(writes),
+                        initialBlockSize_);
+  return {std::move(runs[0]), std::move(runs[1])};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+bool MergeSortImpl<T>::preScanAndSort_(TapeViewT& in, TapeViewT& out) {
+  const auto naturalRuns = scanNaturalRuns_(in);
+  if (runGeneration_ != RunGeneration::NaturalRuns && naturalRuns.size() > 1 &&
+      naturalRuns.size() * initialBlockSize_ >= elementsCnt_) {
+    return false;
+  }
+  // Natural runs may not fit temporary tapes of fixed blocks.
+  tmpTapesSize_ = elementsCnt_;
+  sortFoundRuns_(in, out, naturalRuns);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::sortNaturalRuns_(TapeViewT& in, TapeViewT& out) {
+  sortFoundRuns_(in, out, scanNaturalRuns_(in));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::sortFoundRuns_(
+    TapeViewT& in, TapeViewT& out,
+    const std::vector<NaturalRun_>& naturalRuns) {
+  if (naturalRuns.size() == 1) {
+    if (naturalRuns.front().increasing == increasing_) {
+      copy_n(RightReadIteratorT(in), elementsCnt_, RightWriteIteratorT(out));
+    } else {
+      out.seek(elementsCnt_ - 1);
+      copy_n(RightReadIteratorT(in), elementsCnt_, LeftWriteIteratorT(out));
+    }
+    return;
+  }
+
+  // Runs are written in the order of most elements, so fewer are reversed.
+  std::size_t increasingCnt = 0;
+  for (const auto& run : naturalRuns) {
+    if (run.increasing) {
+      increasingCnt += run.length;
+    }
+  }
+  const bool increasing = 2 * increasingCnt >= elementsCnt_;
+  mergeRunsIterations_(distributeNaturalRuns_(in, naturalRuns, increasing),
+                       increasing, out);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto MergeSortImpl<T>::scanNaturalRuns_(TapeViewT& in) const
+    -> std::vector<NaturalRun_> {
+  // The scan is counted apart to be reported as scan operations too.
+  auto counter = TapeOperationsCounter();
+  auto scan = in.countedBy(counter);
+  auto runs = std::vector<NaturalRun_>{{1, true}};
+  auto read = RightReadIteratorT(scan);
+  T last = *read;
+  for (std::size_t i = 1; i < elementsCnt_; ++i) {
+    ++read;
+    const T current = *read;
+    auto& run = runs.back();
+    if (run.length == 1) {
+      run.increasing = !(current < last);
+      ++run.length;
+    } else if (run.increasing != (current < last)) {
+      ++run.length;
+    } else {
+      runs.push_back({1, true});
+    }
+    last = current;
+  }
+  scan.seek(0);
+  auto statistics = counter.getStatistics();
+  statistics.scanReadCnt = statistics.readCnt;
+  statistics.scanMoveCnt = statistics.moveCnt;
+  in.addStatistics(statistics);
+  return runs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto MergeSortImpl<T>::distributeNaturalRuns_(
+    TapeViewT& in, const std::vector<NaturalRun_>& naturalRuns,
+    bool increasing) -> RunsCouple_ {
+  auto runs = RunsCouple_{};
+  auto& tapesManager = getTapesManager_();
+  auto tapes = std::array<TapeViewT*, 2>{&tapesManager.getInitialOutTape0(),
+                                         &tapesManager.getInitialOutTape1()};
+  auto contents = std::array<std::size_t, 2>{};
+  auto read = RightReadIteratorT(in);
+  for (std::size_t runIdx = 0; runIdx < naturalRuns.size(); ++runIdx) {
+    const auto& run = naturalRuns[runIdx];
+    auto& tape = *tapes[runIdx % 2];
+    auto& content = contents[runIdx % 2];
+    if (runIdx != 0) {
+      ++read;
+    }
+    if (run.length == 1 || run.increasing == increasing) {
+      tape.seek(content);
+      copy_n(read, run.length, RightWriteIteratorT(tape));
+    } else {
+      tape.seek(content + run.length - 1);
+      copy_n(read, run.length, LeftWriteIteratorT(tape));
+    }
+    content += run.length;
+    auto& tapeRuns = (runIdx % 2 == 0) ? runs.runs0 : runs.runs1;
+    tapeRuns.push_back(run.length);
+  }
+  // Runs are merged from the ends of tapes.
+  tapes[0]->seek(contents[0] - 1);
+  tapes[1]->seek(contents[1] - 1);
+  return runs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeRuns_(RunsCouple_ runs, std::size_t iterationIndex,
+                                  bool increasing) {
+  auto& tapesManager = getTapesManager_();
+  auto read0 = LeftReadIteratorT(tapesManager.getInTape0(iterationIndex));
+  auto read1 = LeftReadIteratorT(tapesManager.getInTape1(iterationIndex));
+  auto write0 = RightWriteIteratorT(tapesManager.getOutTape0(iterationIndex));
+  auto write1 = RightWriteIteratorT(tapesManager.getOutTape1(iterationIndex));
+  for (std::size_t runIdx = 0; !runs.runs0.empty(); ++runIdx) {
+    const std::size_t n0 = runs.runs0.back();
+    runs.runs0.pop_back();
+    std::size_t n1 = 0;
+    if (!runs.runs1.empty()) {
+      n1 = runs.runs1.back();
+      runs.runs1.pop_back();
+    }
+    if (runIdx != 0) {
+      ++read0;
+      if (n1 != 0) {
+        ++read1;
+      }
+    }
+    auto& write = (runIdx % 2 == 0) ? write0 : write1;
+    if (runIdx >= 2) {
+      ++write;
+    }
+    mergeRunsCouple_(read0, n0, read1, n1, write, increasing);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::mergeRunsIntoOutputTape_(const RunsCouple_& runs,
+                                                std::size_t iterationIndex,
+                                                TapeViewT& outTape,
+                                                bool increasing) {
+  auto& tapesManager = getTapesManager_();
+  auto read0 = LeftReadIteratorT(tapesManager.getInTape0(iterationIndex));
+  auto read1 = LeftReadIteratorT(tapesManager.getInTape1(iterationIndex));
+  const std::size_t n0 = runs.runs0.front();
+  const std::size_t n1 = runs.runs1.empty() ? 0 : runs.runs1.front();
+  if (increasing == increasing_) {
+    mergeRunsCouple_(read0, n0, read1, n1, RightWriteIteratorT(outTape),
+                     increasing);
+  } else {
+    outTape.seek(elementsCnt_ - 1);
+    mergeRunsCouple_(read0, n0, read1, n1, LeftWriteIteratorT(outTape),
+                     increasing);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+template <class OutputIterator>
+void MergeSortImpl<T>::mergeRunsCouple_(LeftReadIteratorT in0, std::size_t n0,
+                                        LeftReadIteratorT in1, std::size_t n1,
+                                        OutputIterator out,
+                                        bool increasing) const {
+  if (n1 == 0) {
+    copy_n(in0, n0, out);
+  } else if (increasing) {
+    merge_increasing(in0, n0, in1, n1, out);
+  } else {
+    merge_decreasing(in0, n0, in1, n1, out);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::checkStartPositions_(TapeViewT& in0, TapeViewT& in1,
+                                            TapeViewT& out0, TapeViewT& out1,
+                                            std::size_t blockSize) const {
+  const auto opBlocksCnt = calcOperationBlocksCnts_(blockSize);
+  const auto [inCnt0Expected, inCnt1Expected] =
+      calcCounts_(opBlocksCnt.in0, opBlocksCnt.in1, blockSize);
+  assert(in0.getPosition() + 1 == inCnt0Expected);
+  assert(in1.getPosition() + 1 == inCnt1Expected);
+  assert(out0.getPosition() == 0);
+  assert(out1.getPosition() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::checkFinishPositions_(TapeViewT& in0, TapeViewT& in1,
+                                             TapeViewT& out0, TapeViewT& out1,
+                                             std::size_t blockSize) const {
+  const auto opBlocksCnt = calcOperationBlocksCnts_(blockSize);
+  const auto [outCnt0Expected, outCnt1Expected] =
+      calcCounts_(opBlocksCnt.out0, opBlocksCnt.out1, blockSize * 2);
+  assert(in0.getPosition() == 0);
+  assert(in1.getPosition() == 0);
+  assert(out0.getPosition() + 1 == outCnt0Expected);
+  assert(out1.getPosition() + 1 == outCnt1Expected);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void MergeSortImpl<T>::checkFinalPositions_(const TapeViewT& in0,
+                                            const TapeViewT& in1) const {
+  assert(in0.getPosition() + 1 == maxBlockSize_);
+  assert(in1.getPosition() + 1 == elementsCnt_ - maxBlockSize_);
+}
+
+extern template class MergeSortImpl<std::int32_t>;
+extern template class MergeSortImpl<std::int64_t>;
+extern template class MergeSortImpl<std::uint64_t>;
+extern template class MergeSortImpl<float>;
+extern template class MergeSortImpl<double>;
+
 #endif  // TAPE_SIMULATION_IMPL_MERGE_SORT_IMPL_HPP
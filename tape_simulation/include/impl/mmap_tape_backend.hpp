@@ -0,0 +1,36 @@
+#ifndef TAPE_SIMULATION_IMPL_MMAP_TAPE_BACKEND_HPP
+#define TAPE_SIMULATION_IMPL_MMAP_TAPE_BACKEND_HPP
+
+#include <string>
+
+#include "../tape_backend.hpp"
+#include "mapped_file.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MmapTapeBackend - cells of a file mapped into memory.
+class MmapTapeBackend : public TapeBackend {
+ public:
+  /**
+   * @brief MmapTapeBackend constructor.
+   *
+   * @param filename tape filename.
+   * @param size tape cells count.
+   * @param cellSize bytes count of a single cell.
+   * @param create create (or truncate) the file instead of opening it.
+   * @param dataOffset bytes before the first cell.
+   */
+  MmapTapeBackend(const std::string& filename, std::size_t size,
+                  std::size_t cellSize, bool create, std::size_t dataOffset);
+
+  [[nodiscard]] std::byte* getCells() override;
+
+  void read(std::size_t position, std::byte* cell) override;
+
+  void write(std::size_t position, const std::byte* cell) override;
+
+ private:
+  MappedFile mappedFile_;
+  std::byte* cells_;
+};
+
+#endif  // TAPE_SIMULATION_IMPL_MMAP_TAPE_BACKEND_HPP
@@ -0,0 +1,222 @@
+#ifndef TAPE_SIMULATION_IMPL_PIPELINED_MERGE_HPP
+#define TAPE_SIMULATION_IMPL_PIPELINED_MERGE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <type_traits>
+
+#include "merge.hpp"
+#include "spsc_ring.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief struct MergePipelineStatistics - counts of waits of pipeline
+/// stages. A stage waiting for a ring counts a single stall however long it
+/// waits.
+struct MergePipelineStatistics {
+  /// Waits of the first reader for a place in its ring.
+  std::size_t readerStallCnt0;
+  /// Waits of the second reader for a place in its ring.
+  std::size_t readerStallCnt1;
+  /// Waits of the merger for an element from any reader.
+  std::size_t mergerInputStallCnt;
+  /// Waits of the merger for a place in the writer ring.
+  std::size_t mergerOutputStallCnt;
+  /// Waits of the writer for an element from the merger.
+  std::size_t writerStallCnt;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MergePipelineStopped_ - thrown inside a stage when another
+/// stage failed.
+class MergePipelineStopped_ {};
+
+/**
+ * @brief Retry a ring operation until it succeeds.
+ *
+ * @param tryOperation ring operation returning false if it can not be done.
+ * @param stallCnt counter increased if the operation has to be waited for.
+ * @param stopped flag of a failed stage.
+ */
+template <class TryOperation>
+void wait_for_ring_(TryOperation tryOperation, std::size_t& stallCnt,
+                    const std::atomic<bool>& stopped) {
+  if (tryOperation()) {
+    return;
+  }
+  ++stallCnt;
+  while (!tryOperation()) {
+    if (stopped.load(std::memory_order_relaxed)) {
+      throw MergePipelineStopped_();
+    }
+    std::this_thread::yield();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MergePipelineReadIterator_ - input iterator of the merger,
+/// every dereference takes the next element of a ring.
+template <class T>
+class MergePipelineReadIterator_ {
+ public:
+  MergePipelineReadIterator_(SpscRing<T>& ring, std::size_t& stallCnt,
+                             const std::atomic<bool>& stopped)
+      : ring_{&ring}, stallCnt_{&stallCnt}, stopped_{&stopped} {
+  }
+
+  T operator*() {
+    auto value = T{};
+    wait_for_ring_([&]() { return ring_->tryPop(value); }, *stallCnt_,
+                   *stopped_);
+    return value;
+  }
+
+  MergePipelineReadIterator_& operator++() {
+    return *this;
+  }
+
+ private:
+  SpscRing<T>* ring_;
+  std::size_t* stallCnt_;
+  const std::atomic<bool>* stopped_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MergePipelineWriteIterator_ - output iterator of the merger,
+/// every assignment puts an element to a ring.
+template <class T>
+class MergePipelineWriteIterator_ {
+ public:
+  MergePipelineWriteIterator_(SpscRing<T>& ring, std::size_t& stallCnt,
+                              const std::atomic<bool>& stopped)
+      : ring_{&ring}, stallCnt_{&stallCnt}, stopped_{&stopped} {
+  }
+
+  MergePipelineWriteIterator_& operator*() {
+    return *this;
+  }
+
+  MergePipelineWriteIterator_& operator=(const T& value) {
+    wait_for_ring_([&]() { return ring_->tryPush(value); }, *stallCnt_,
+                   *stopped_);
+    return *this;
+  }
+
+  MergePipelineWriteIterator_& operator++() {
+    return *this;
+  }
+
+ private:
+  SpscRing<T>* ring_;
+  std::size_t* stallCnt_;
+  const std::atomic<bool>* stopped_;
+};
+
+/**
+ * @brief merge two ranges like `merge` with each source read by its own
+ * thread and the target written by its own thread. Stages pass elements
+ * through rings of `ringCapacity` elements. Sources are read completely, so
+ * reads and iterator increments are the same as of `merge`. Iterators are
+ * used from different threads and must not share unsynchronized state, for
+ * example statistics.
+ *
+ * @tparam Compare strict ordering of sources.
+ * @tparam InputIterator1 first input iterator type.
+ * @tparam InputIterator2 second input iterator type.
+ * @tparam OutputIterator output iterator type.
+ * @param source0 first range input iterator.
+ * @param cnt0 first range length.
+ * @param source1 second range input iterator.
+ * @param cnt1 second range length.
+ * @param target output iterator.
+ * @param ringCapacity elements count of a ring between stages.
+ * @return stalls of stages.
+ */
+template <class Compare, class InputIterator1, class InputIterator2,
+          class OutputIterator>
+MergePipelineStatistics pipelined_merge(InputIterator1 source0,
+                                        std::size_t cnt0,
+                                        InputIterator2 source1,
+                                        std::size_t cnt1,
+                                        OutputIterator target,
+                                        std::size_t ringCapacity) {
+  if (cnt0 == 0 || cnt1 == 0) {
+    // Same errors as of a single thread merge.
+    merge<InputIterator1, InputIterator2, OutputIterator, Compare>(
+        source0, cnt0, source1, cnt1, target);
+  }
+  using Value = std::decay_t<decltype(*source0)>;
+  auto ring0 = SpscRing<Value>(ringCapacity);
+  auto ring1 = SpscRing<Value>(ringCapacity);
+  auto outRing = SpscRing<Value>(ringCapacity);
+  auto statistics = MergePipelineStatistics{};
+  auto stopped = std::atomic<bool>{false};
+  std::array<std::exception_ptr, 4> errors;
+
+  const auto runStage = [&stopped](std::exception_ptr& error, auto stage) {
+    try {
+      stage();
+    } catch (const MergePipelineStopped_&) {
+    } catch (...) {
+      error = std::current_exception();
+      stopped.store(true, std::memory_order_relaxed);
+    }
+  };
+  const auto read = [&stopped](auto source, std::size_t cnt,
+                               SpscRing<Value>& ring, std::size_t& stallCnt) {
+    for (std::size_t i = 0; i < cnt; ++i) {
+      if (i != 0) {
+        ++source;
+      }
+      const Value value = *source;
+      wait_for_ring_([&]() { return ring.tryPush(value); }, stallCnt,
+                     stopped);
+    }
+  };
+
+  {
+    const auto reader0 = std::jthread([&]() {
+      runStage(errors[0], [&]() {
+        read(source0, cnt0, ring0, statistics.readerStallCnt0);
+      });
+    });
+    const auto reader1 = std::jthread([&]() {
+      runStage(errors[1], [&]() {
+        read(source1, cnt1, ring1, statistics.readerStallCnt1);
+      });
+    });
+    const auto writer = std::jthread([&]() {
+      runStage(errors[2], [&]() {
+        for (std::size_t i = 0; i < cnt0 + cnt1; ++i) {
+          auto value = Value{};
+          wait_for_ring_([&]() { return outRing.tryPop(value); },
+                         statistics.writerStallCnt, stopped);
+          if (i != 0) {
+            ++target;
+          }
+          *target = value;
+        }
+      });
+    });
+
+    runStage(errors[3], [&]() {
+      using ReadIterator = MergePipelineReadIterator_<Value>;
+      using WriteIterator = MergePipelineWriteIterator_<Value>;
+      merge<ReadIterator, ReadIterator, WriteIterator, Compare>(
+          ReadIterator(ring0, statistics.mergerInputStallCnt, stopped), cnt0,
+          ReadIterator(ring1, statistics.mergerInputStallCnt, stopped), cnt1,
+          WriteIterator(outRing, statistics.mergerOutputStallCnt, stopped));
+    });
+  }
+
+  for (const auto& error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+  return statistics;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_PIPELINED_MERGE_HPP
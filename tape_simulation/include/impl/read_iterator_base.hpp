@@ -8,57 +8,60 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief class ReadIteratorBase
-template <class Derived>
+template <class Derived, class T>
 class ReadIteratorBase {
  public:
-  explicit ReadIteratorBase(TapeView& tv);
-  typename std::int32_t operator*();
+  explicit ReadIteratorBase(BasicTapeView<T>& tv);
+  T operator*();
   bool operator==(const Derived& other) const;
   bool operator!=(const Derived& other) const;
   Derived operator++(int);
 
  protected:
-  [[nodiscard]] TapeView& getTapeView_() const;
+  [[nodiscard]] BasicTapeView<T>& getTapeView_() const;
 
  private:
-  TapeView* tapeView_;
+  BasicTapeView<T>* tapeView_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline ReadIteratorBase<Derived>::ReadIteratorBase(TapeView& tv)
+template <class Derived, class T>
+inline ReadIteratorBase<Derived, T>::ReadIteratorBase(BasicTapeView<T>& tv)
     : tapeView_{&tv} {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline std::int32_t ReadIteratorBase<Derived>::operator*() {
+template <class Derived, class T>
+inline T ReadIteratorBase<Derived, T>::operator*() {
   return tapeView_->read();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline bool ReadIteratorBase<Derived>::operator==(const Derived& other) const {
+template <class Derived, class T>
+inline bool ReadIteratorBase<Derived, T>::operator==(
+    const Derived& other) const {
   return other.tapeView_ == tapeView_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline bool ReadIteratorBase<Derived>::operator!=(const Derived& other) const {
+template <class Derived, class T>
+inline bool ReadIteratorBase<Derived, T>::operator!=(
+    const Derived& other) const {
   return other.tapeView_ != tapeView_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline Derived ReadIteratorBase<Derived>::operator++(int) {
+template <class Derived, class T>
+inline Derived ReadIteratorBase<Derived, T>::operator++(int) {
   Derived ret = *static_cast<Derived*>(this);
   static_cast<Derived*>(this)->operator++();
   return ret;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline TapeView& ReadIteratorBase<Derived>::getTapeView_() const {
+template <class Derived, class T>
+inline BasicTapeView<T>& ReadIteratorBase<Derived, T>::getTapeView_()
+    const {
   return *tapeView_;
 }
 
@@ -0,0 +1,83 @@
+#ifndef TAPE_SIMULATION_IMPL_REPLACEMENT_SELECTION_HPP
+#define TAPE_SIMULATION_IMPL_REPLACEMENT_SELECTION_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief copy `elementsCnt` elements to runs made by replacement selection
+ * with a heap of `heapSize` elements. An element read goes to the current run
+ * unless it must precede the last written one, so runs are about
+ * `2 * heapSize` long on random input and sorted input makes a single run.
+ * Runs are dealt round robin over targets. Input iterator is moved
+ * `elementsCnt - 1` times, a target is moved between its written elements
+ * only.
+ *
+ * @tparam Compare strict ordering of runs.
+ * @tparam InputIterator read iterator type.
+ * @tparam OutputIterator write iterator type.
+ * @param source position to start reading from.
+ * @param elementsCnt number of elements to copy.
+ * @param targets positions to start writing to.
+ * @param heapSize number of elements kept in memory.
+ * @return lengths of runs written to each target in order of writing.
+ */
+template <class Compare, class InputIterator, class OutputIterator>
+std::vector<std::vector<std::size_t>> replacement_selection(
+    InputIterator source, std::size_t elementsCnt,
+    std::vector<OutputIterator> targets, std::size_t heapSize) {
+  if (heapSize == 0) {
+    throw std::logic_error("Replacement selection heap can not be empty.");
+  }
+  using Value = std::decay_t<decltype(*source)>;
+  using Element = std::pair<std::size_t, Value>;
+  // Top is the least element of the earliest run.
+  const auto later = [](const Element& lhs, const Element& rhs) {
+    return lhs.first > rhs.first ||
+           (lhs.first == rhs.first && Compare()(rhs.second, lhs.second));
+  };
+  auto heap = std::priority_queue<Element, std::vector<Element>,
+                                  decltype(later)>(later);
+  std::size_t readCnt = 0;
+  const auto readNext = [&]() {
+    if (readCnt++ != 0) {
+      ++source;
+    }
+    return *source;
+  };
+  while (readCnt < std::min(heapSize, elementsCnt)) {
+    heap.emplace(0, readNext());
+  }
+
+  auto runs = std::vector<std::vector<std::size_t>>(targets.size());
+  auto written = std::vector<bool>(targets.size(), false);
+  auto currentRun = std::optional<std::size_t>{};
+  while (!heap.empty()) {
+    const auto [run, value] = heap.top();
+    heap.pop();
+    const std::size_t targetIdx = run % targets.size();
+    if (currentRun != run) {
+      runs[targetIdx].push_back(0);
+      currentRun = run;
+    }
+    if (written[targetIdx]) {
+      ++targets[targetIdx];
+    }
+    *targets[targetIdx] = value;
+    written[targetIdx] = true;
+    ++runs[targetIdx].back();
+    if (readCnt < elementsCnt) {
+      const auto next = readNext();
+      heap.emplace(Compare()(next, value) ? run + 1 : run, next);
+    }
+  }
+  return runs;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_REPLACEMENT_SELECTION_HPP
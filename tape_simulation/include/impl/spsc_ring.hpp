@@ -0,0 +1,92 @@
+#ifndef TAPE_SIMULATION_IMPL_SPSC_RING_HPP
+#define TAPE_SIMULATION_IMPL_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class SpscRing - bounded lock-free queue for a single producer
+/// thread and a single consumer thread.
+template <class T>
+class SpscRing {
+ public:
+  /// Bytes count of a cache line, indices are kept on separate ones.
+  constexpr static std::size_t cacheLineSize = 64;
+
+ public:
+  /**
+   * @brief SpscRing constructor.
+   *
+   * @param capacity maximal number of queued values.
+   */
+  explicit SpscRing(std::size_t capacity);
+
+  /**
+   * @brief Queue a value. Called by the producer only.
+   *
+   * @param value value to queue.
+   * @return false if the ring is full.
+   */
+  bool tryPush(const T& value);
+
+  /**
+   * @brief Take the oldest value. Called by the consumer only.
+   *
+   * @param value destination.
+   * @return false if the ring is empty.
+   */
+  bool tryPop(T& value);
+
+ private:
+  [[nodiscard]] std::size_t next_(std::size_t index) const;
+
+ private:
+  std::vector<T> cells_;
+  /// Next cell to pop, written by the consumer.
+  alignas(cacheLineSize) std::atomic<std::size_t> head_{0};
+  /// Next cell to push, written by the producer.
+  alignas(cacheLineSize) std::atomic<std::size_t> tail_{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+SpscRing<T>::SpscRing(std::size_t capacity) : cells_(capacity + 1) {
+  if (capacity == 0) {
+    throw std::invalid_argument("Ring capacity can not be zero.");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline bool SpscRing<T>::tryPush(const T& value) {
+  const std::size_t tail = tail_.load(std::memory_order_relaxed);
+  const std::size_t next = next_(tail);
+  if (next == head_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  cells_[tail] = value;
+  tail_.store(next, std::memory_order_release);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline bool SpscRing<T>::tryPop(T& value) {
+  const std::size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tail_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  value = cells_[head];
+  head_.store(next_(head), std::memory_order_release);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline std::size_t SpscRing<T>::next_(std::size_t index) const {
+  return (index + 1 == cells_.size()) ? 0 : index + 1;
+}
+
+#endif  // TAPE_SIMULATION_IMPL_SPSC_RING_HPP
@@ -0,0 +1,35 @@
+#ifndef TAPE_SIMULATION_IMPL_TAPE_HEADER_HPP
+#define TAPE_SIMULATION_IMPL_TAPE_HEADER_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include "../tape_metadata.hpp"
+
+/// Header size in bytes. It takes a whole block, so cells stay aligned for
+/// direct I/O and memory mapping.
+constexpr std::size_t tapeHeaderSize = 4096;
+
+/// Current header version.
+constexpr std::uint16_t tapeHeaderVersion = 1;
+
+/**
+ * @brief Read a tape header.
+ *
+ * @param filename tape file.
+ * @return metadata or std::nullopt if the file has no header.
+ */
+std::optional<TapeMetadata> readTapeHeader(const std::string& filename);
+
+/**
+ * @brief Write a tape header over the beginning of an existing file. Throws
+ * std::runtime_error if the header is not written.
+ *
+ * @param filename tape file.
+ * @param metadata metadata to store.
+ */
+void writeTapeHeader(const std::string& filename,
+                     const TapeMetadata& metadata);
+
+#endif  // TAPE_SIMULATION_IMPL_TAPE_HEADER_HPP
@@ -1,8 +1,16 @@
 #ifndef TAPE_SIMULATION_TAPE_POOL_STATISTICS_BASE_HPP
 #define TAPE_SIMULATION_TAPE_POOL_STATISTICS_BASE_HPP
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TapePoolStatisticsBase - operations counters which may be
+/// increased from several threads. Every thread owns a shard of counters while
+/// it runs and increases them without atomic read-modify-writes, threads left
+/// without a shard share the last one. Shards are on separate cache lines and
+/// are summed on reading.
 class TapePoolStatisticsBase {
  public:
   struct IOStatistics {
@@ -13,17 +21,39 @@ class TapePoolStatisticsBase {
     std::size_t openCnt;
     std::size_t closeCnt;
     std::size_t removeCnt;
+    /// Reads of pre-sort scans, included in readCnt.
+    std::size_t scanReadCnt;
+    /// Moves of pre-sort scans, included in moveCnt.
+    std::size_t scanMoveCnt;
+  };
+
+  /// Count of shards owned by a single thread.
+  constexpr static std::size_t countersShardsCnt = 16;
+  /// Bytes count of a cache line, shards are kept on separate ones.
+  constexpr static std::size_t cacheLineSize = 64;
+
+ private:
+  struct alignas(cacheLineSize) Counters_ {
+    std::atomic<std::size_t> readCnt{0};
+    std::atomic<std::size_t> writeCnt{0};
+    std::atomic<std::size_t> moveCnt{0};
+    std::atomic<std::size_t> createCnt{0};
+    std::atomic<std::size_t> openCnt{0};
+    std::atomic<std::size_t> closeCnt{0};
+    std::atomic<std::size_t> removeCnt{0};
+    std::atomic<std::size_t> scanReadCnt{0};
+    std::atomic<std::size_t> scanMoveCnt{0};
   };
 
  protected:
   TapePoolStatisticsBase() = default;
 
  public:
-  void increaseReadsCnt();
+  void increaseReadsCnt(std::size_t cnt = 1);
 
-  void increaseWritesCnt();
+  void increaseWritesCnt(std::size_t cnt = 1);
 
-  void increaseMovesCnt();
+  void increaseMovesCnt(std::size_t cnt = 1);
 
   void increaseCreateCnt();
 
@@ -33,51 +63,169 @@ class TapePoolStatisticsBase {
 
   void increaseRemoveCnt();
 
+  void increaseScanReadsCnt(std::size_t cnt);
+
+  void increaseScanMovesCnt(std::size_t cnt);
+
+  /**
+   * @brief Add operations counted elsewhere.
+   *
+   * @param statistics counts to add.
+   */
+  void addStatistics(const IOStatistics& statistics);
+
+  /**
+   * @brief Get sums of counters of all threads. Operations counted
+   * concurrently may be partly included.
+   *
+   * @return operations counts.
+   */
   [[nodiscard]] IOStatistics getStatistics() const;
 
  private:
-  IOStatistics statistics_{};
+  using Counter_ = std::atomic<std::size_t> Counters_::*;
+
+  [[nodiscard]] static std::size_t getThreadShardIdx_();
+
+  [[nodiscard]] static std::size_t acquireShard_();
+
+  void add_(Counter_ counter, std::size_t cnt);
+
+ private:
+  /// Owned shards and the shared one.
+  std::array<Counters_, countersShardsCnt + 1> counters_{};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-inline void TapePoolStatisticsBase::increaseReadsCnt() {
-  ++statistics_.readCnt;
+inline void TapePoolStatisticsBase::increaseReadsCnt(std::size_t cnt) {
+  add_(&Counters_::readCnt, cnt);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline void TapePoolStatisticsBase::increaseWritesCnt() {
-  ++statistics_.writeCnt;
+inline void TapePoolStatisticsBase::increaseWritesCnt(std::size_t cnt) {
+  add_(&Counters_::writeCnt, cnt);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline void TapePoolStatisticsBase::increaseMovesCnt() {
-  ++statistics_.moveCnt;
+inline void TapePoolStatisticsBase::increaseMovesCnt(std::size_t cnt) {
+  add_(&Counters_::moveCnt, cnt);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 inline void TapePoolStatisticsBase::increaseCreateCnt() {
-  ++statistics_.createCnt;
+  add_(&Counters_::createCnt, 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 inline void TapePoolStatisticsBase::increaseOpenCnt() {
-  ++statistics_.openCnt;
+  add_(&Counters_::openCnt, 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 inline void TapePoolStatisticsBase::increaseCloseCnt() {
-  ++statistics_.closeCnt;
+  add_(&Counters_::closeCnt, 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 inline void TapePoolStatisticsBase::increaseRemoveCnt() {
-  ++statistics_.removeCnt;
+  add_(&Counters_::removeCnt, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void TapePoolStatisticsBase::increaseScanReadsCnt(std::size_t cnt) {
+  add_(&Counters_::scanReadCnt, cnt);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void TapePoolStatisticsBase::increaseScanMovesCnt(std::size_t cnt) {
+  add_(&Counters_::scanMoveCnt, cnt);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void TapePoolStatisticsBase::addStatistics(
+    const IOStatistics& statistics) {
+  add_(&Counters_::readCnt, statistics.readCnt);
+  add_(&Counters_::writeCnt, statistics.writeCnt);
+  add_(&Counters_::moveCnt, statistics.moveCnt);
+  add_(&Counters_::createCnt, statistics.createCnt);
+  add_(&Counters_::openCnt, statistics.openCnt);
+  add_(&Counters_::closeCnt, statistics.closeCnt);
+  add_(&Counters_::removeCnt, statistics.removeCnt);
+  add_(&Counters_::scanReadCnt, statistics.scanReadCnt);
+  add_(&Counters_::scanMoveCnt, statistics.scanMoveCnt);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 inline auto TapePoolStatisticsBase::getStatistics() const
     -> IOStatistics {
-  return statistics_;
+  auto ret = IOStatistics{};
+  for (const auto& counters : counters_) {
+    ret.readCnt += counters.readCnt.load(std::memory_order_relaxed);
+    ret.writeCnt += counters.writeCnt.load(std::memory_order_relaxed);
+    ret.moveCnt += counters.moveCnt.load(std::memory_order_relaxed);
+    ret.createCnt += counters.createCnt.load(std::memory_order_relaxed);
+    ret.openCnt += counters.openCnt.load(std::memory_order_relaxed);
+    ret.closeCnt += counters.closeCnt.load(std::memory_order_relaxed);
+    ret.removeCnt += counters.removeCnt.load(std::memory_order_relaxed);
+    ret.scanReadCnt += counters.scanReadCnt.load(std::memory_order_relaxed);
+    ret.scanMoveCnt += counters.scanMoveCnt.load(std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t TapePoolStatisticsBase::getThreadShardIdx_() {
+  // Constant initialized, so checking it costs no guard.
+  thread_local std::size_t shardIdx = countersShardsCnt + 1;
+  if (shardIdx > countersShardsCnt) [[unlikely]] {
+    shardIdx = acquireShard_();
+  }
+  return shardIdx;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t TapePoolStatisticsBase::acquireShard_() {
+  // Shard indices are the same in every pool, a thread owns one in all pools.
+  static std::array<std::atomic<bool>, countersShardsCnt> taken{};
+  std::size_t shardIdx = 0;
+  for (; shardIdx < countersShardsCnt; ++shardIdx) {
+    auto expected = false;
+    if (taken[shardIdx].compare_exchange_strong(expected, true,
+                                                std::memory_order_acquire)) {
+      break;
+    }
+  }
+  struct Release {
+    std::size_t shardIdx;
+    ~Release() {
+      if (shardIdx < countersShardsCnt) {
+        taken[shardIdx].store(false, std::memory_order_release);
+      }
+    }
+  };
+  thread_local const Release release{shardIdx};
+  return shardIdx;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline void TapePoolStatisticsBase::add_(Counter_ counter, std::size_t cnt) {
+  const std::size_t shardIdx = getThreadShardIdx_();
+  auto& shardCounter = counters_[shardIdx].*counter;
+  if (shardIdx == countersShardsCnt) [[unlikely]] {
+    shardCounter.fetch_add(cnt, std::memory_order_relaxed);
+    return;
+  }
+  // Only the owner writes the counter, readers may load it concurrently.
+  shardCounter.store(shardCounter.load(std::memory_order_relaxed) + cnt,
+                     std::memory_order_relaxed);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TapeOperationsCounter - statistics of views used apart from
+/// the pool, for example in another thread. Added to the pool afterwards.
+class TapeOperationsCounter : public TapePoolStatisticsBase {
+ public:
+  TapeOperationsCounter() = default;
+};
+
 #endif  // TAPE_SIMULATION_TAPE_POOL_STATISTICS_BASE_HPP
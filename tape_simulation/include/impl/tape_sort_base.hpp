@@ -0,0 +1,146 @@
+#ifndef TAPE_SIMULATION_IMPL_TAPE_SORT_BASE_HPP
+#define TAPE_SIMULATION_IMPL_TAPE_SORT_BASE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../copy_n.hpp"
+#include "../tape_pool.hpp"
+#include "../tape_view_read_iterators.hpp"
+#include "../tape_view_write_iterators.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TapeSortBase - input and output tapes handling shared by
+/// sorters which are not built on the two-way MergeSortImpl. Input tape is
+/// closed on destruction.
+template <class T>
+class TapeSortBase {
+ protected:
+  using TapeViewT = BasicTapeView<T>;
+
+ protected:
+  TapeSortBase(TapePool& tapePool, std::string_view inFilename,
+               bool increasing);
+
+ public:
+  TapeSortBase() = delete;
+  TapeSortBase(const TapeSortBase&) = delete;
+  TapeSortBase(TapeSortBase&&) noexcept = delete;
+  auto operator=(const TapeSortBase&) = delete;
+  auto operator=(TapeSortBase&&) = delete;
+
+ protected:
+  /**
+   * @brief Get view of the input tape, checking its head is in the
+   * beginning.
+   *
+   * @return input tape view.
+   */
+  [[nodiscard]] TapeViewT getInTape_() const;
+
+  /**
+   * @brief Create output tape in the format of the input tape.
+   *
+   * @param inTape input tape.
+   * @param outFilename output tape filename.
+   * @return a view to a created tape.
+   */
+  [[nodiscard]] TapeViewT createOutTape_(const TapeViewT& inTape,
+                                         std::string_view outFilename) const;
+
+  /**
+   * @brief Copy input to output as is if the input header says it is already
+   * sorted in the requested order.
+   *
+   * @param inTape input tape. The head must be in the beginning of a tape.
+   * @param outTape output tape. The head must be in the beginning of a tape.
+   * @return true if the input was copied.
+   */
+  bool copyIfSorted_(TapeViewT& inTape, TapeViewT& outTape) const;
+
+  /**
+   * @brief Record the sort order in the output header and close the tape.
+   *
+   * @param outTape output tape.
+   */
+  void closeSortedOutTape_(TapeViewT& outTape) const;
+
+  ~TapeSortBase();
+
+ protected:
+  TapePool* tapePool_;
+  std::string inFilename_;
+  bool increasing_;
+  TapeHandle inHandle_;
+  std::size_t elementsCnt_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+TapeSortBase<T>::TapeSortBase(TapePool& tapePool, std::string_view inFilename,
+                              bool increasing)
+    : tapePool_{&tapePool},
+      inFilename_{inFilename},
+      increasing_{increasing},
+      inHandle_{tapePool.getOrOpenTape<T>(inFilename_).getHandle()},
+      elementsCnt_{tapePool.getOpenedTape<T>(inHandle_).getSize()} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto TapeSortBase<T>::getInTape_() const -> TapeViewT {
+  auto inTape = tapePool_->getOpenedTape<T>(inHandle_);
+  if (inTape.getPosition() != 0) {
+    throw std::logic_error("Input tape head is not in the beginning.");
+  }
+  return inTape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto TapeSortBase<T>::createOutTape_(const TapeViewT& inTape,
+                                     std::string_view outFilename) const
+    -> TapeViewT {
+  return tapePool_->createTape<T>(
+      outFilename, elementsCnt_, std::nullopt,
+      inTape.getMetadata().has_value() ? TapeFormat::WithHeader
+                                       : TapeFormat::Raw);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+bool TapeSortBase<T>::copyIfSorted_(TapeViewT& inTape,
+                                    TapeViewT& outTape) const {
+  const auto& metadata = inTape.getMetadata();
+  const auto order =
+      increasing_ ? TapeOrder::Increasing : TapeOrder::Decreasing;
+  if (!metadata.has_value() || metadata->order != order) {
+    return false;
+  }
+  copy_n(BasicRightReadIterator<T>(inTape), elementsCnt_,
+         BasicRightWriteIterator<T>(outTape));
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void TapeSortBase<T>::closeSortedOutTape_(TapeViewT& outTape) const {
+  outTape.markSorted(increasing_ ? TapeOrder::Increasing
+                                 : TapeOrder::Decreasing);
+  tapePool_->closeTape(outTape.getHandle());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline TapeSortBase<T>::~TapeSortBase() {
+  tapePool_->closeTape(inHandle_);
+}
+
+extern template class TapeSortBase<std::int32_t>;
+extern template class TapeSortBase<std::int64_t>;
+extern template class TapeSortBase<std::uint64_t>;
+extern template class TapeSortBase<float>;
+extern template class TapeSortBase<double>;
+
+#endif  // TAPE_SIMULATION_IMPL_TAPE_SORT_BASE_HPP
@@ -0,0 +1,47 @@
+#ifndef TAPE_SIMULATION_IMPL_TASK_WORKER_HPP
+#define TAPE_SIMULATION_IMPL_TASK_WORKER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TaskWorker - helper thread running tasks one by one in
+/// submission order.
+class TaskWorker {
+ public:
+  TaskWorker();
+  TaskWorker(const TaskWorker&) = delete;
+  TaskWorker(TaskWorker&&) noexcept = delete;
+  TaskWorker& operator=(const TaskWorker&) = delete;
+  TaskWorker& operator=(TaskWorker&&) noexcept = delete;
+  ~TaskWorker();
+
+  /**
+   * @brief Queue a task. Tasks are run in submission order.
+   *
+   * @param task task to run.
+   * @return future of the task, holds an exception if the task throws.
+   */
+  std::future<void> submit(std::function<void()> task);
+
+  /**
+   * @brief Wait until all submitted tasks are finished.
+   */
+  void wait();
+
+ private:
+  void run_();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::packaged_task<void()>> tasks_;
+  bool stopping_{false};
+  std::thread thread_;
+};
+
+#endif  // TAPE_SIMULATION_IMPL_TASK_WORKER_HPP
@@ -0,0 +1,113 @@
+#ifndef TAPE_SIMULATION_IMPL_TMP_TAPES_MANAGER_HPP
+#define TAPE_SIMULATION_IMPL_TMP_TAPES_MANAGER_HPP
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../tape_pool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TmpTapesManager - any number of temporary tapes of given
+/// sizes, which are removed on destruction.
+template <class T>
+class TmpTapesManager {
+ public:
+  using TapeViewT = BasicTapeView<T>;
+
+ public:
+  /**
+   * @brief TmpTapesManager constructor.
+   *
+   * @param tapePool pool of tapes.
+   * @param path directory of temporary tapes. It is created if it does not
+   * exist and then removed on destruction.
+   * @param sizes sizes of tapes to create.
+   */
+  TmpTapesManager(TapePool& tapePool, std::string_view path,
+                  const std::vector<std::size_t>& sizes);
+  TmpTapesManager(const TmpTapesManager&) = delete;
+  TmpTapesManager(TmpTapesManager&&) noexcept = delete;
+  auto operator=(const TmpTapesManager&) = delete;
+  auto operator=(TmpTapesManager&&) noexcept = delete;
+
+  /**
+   * @brief Get temporary tape.
+   *
+   * @param idx tape index.
+   * @return tape view.
+   */
+  TapeViewT& getTape(std::size_t idx);
+
+  /**
+   * @brief Get temporary tapes count.
+   *
+   * @return tapes count.
+   */
+  [[nodiscard]] std::size_t getTapesCnt() const;
+
+  ~TmpTapesManager();
+
+ private:
+  [[nodiscard]] std::string getFilename_(std::size_t idx) const;
+
+ private:
+  TapePool* tapePool_;
+  const std::string path_;
+  const bool needToRemove_;
+  std::vector<TapeViewT> tapes_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+TmpTapesManager<T>::TmpTapesManager(TapePool& tapePool, std::string_view path,
+                                    const std::vector<std::size_t>& sizes)
+    : tapePool_{&tapePool},
+      path_{path},
+      // Memory backed temporary tapes need no directory.
+      needToRemove_{tapePool.getTmpBackendType() != TapeBackendType::Memory &&
+                    std::filesystem::create_directory(path_)} {
+  tapes_.reserve(sizes.size());
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    tapes_.push_back(tapePool_->createTape<T>(getFilename_(i), sizes[i],
+                                              tapePool_->getTmpBackendType()));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline auto TmpTapesManager<T>::getTape(std::size_t idx) -> TapeViewT& {
+  return tapes_[idx];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline std::size_t TmpTapesManager<T>::getTapesCnt() const {
+  return tapes_.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+TmpTapesManager<T>::~TmpTapesManager() {
+  for (const auto& tape : tapes_) {
+    tapePool_->removeTape(tape.getHandle());
+  }
+  if (needToRemove_) {
+    std::filesystem::remove(path_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::string TmpTapesManager<T>::getFilename_(std::size_t idx) const {
+  return path_ + "/tmp_tape_" + std::to_string(idx);
+}
+
+extern template class TmpTapesManager<std::int32_t>;
+extern template class TmpTapesManager<std::int64_t>;
+extern template class TmpTapesManager<std::uint64_t>;
+extern template class TmpTapesManager<float>;
+extern template class TmpTapesManager<double>;
+
+#endif  // TAPE_SIMULATION_IMPL_TMP_TAPES_MANAGER_HPP
@@ -8,67 +8,67 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief class WriteIteratorBase
-template <class Derived>
+template <class Derived, class T>
 class WriteIteratorBase {
  protected:
   class WriteRef {
    public:
-    explicit WriteRef(TapeView& tv);
-    WriteRef& operator=(std::int32_t value);
+    explicit WriteRef(BasicTapeView<T>& tv);
+    WriteRef& operator=(const T& value);
 
    private:
-    TapeView* tapeView_;
+    BasicTapeView<T>* tapeView_;
   };
 
  public:
-  explicit WriteIteratorBase(TapeView& tv);
+  explicit WriteIteratorBase(BasicTapeView<T>& tv);
   WriteRef operator*();
   Derived operator++(int);
 
  protected:
-  TapeView& getTapeView_();
+  BasicTapeView<T>& getTapeView_();
 
  private:
-  TapeView* tapeView_;
+  BasicTapeView<T>* tapeView_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline WriteIteratorBase<Derived>::WriteRef::WriteRef(TapeView& tv)
+template <class Derived, class T>
+inline WriteIteratorBase<Derived, T>::WriteRef::WriteRef(BasicTapeView<T>& tv)
     : tapeView_(&tv) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline auto WriteIteratorBase<Derived>::WriteRef::operator=(std::int32_t value)
-    -> WriteRef& {
+template <class Derived, class T>
+inline auto WriteIteratorBase<Derived, T>::WriteRef::operator=(
+    const T& value) -> WriteRef& {
   tapeView_->write(value);
   return *this;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline WriteIteratorBase<Derived>::WriteIteratorBase(TapeView& tv)
+template <class Derived, class T>
+inline WriteIteratorBase<Derived, T>::WriteIteratorBase(BasicTapeView<T>& tv)
     : tapeView_{&tv} {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline auto WriteIteratorBase<Derived>::operator*() -> WriteRef {
+template <class Derived, class T>
+inline auto WriteIteratorBase<Derived, T>::operator*() -> WriteRef {
   return WriteRef(getTapeView_());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline Derived WriteIteratorBase<Derived>::operator++(int) {
+template <class Derived, class T>
+inline Derived WriteIteratorBase<Derived, T>::operator++(int) {
   Derived ret = *static_cast<Derived*>(this);
   static_cast<Derived*>(this)->operator++();
   return ret;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-template <class Derived>
-inline TapeView& WriteIteratorBase<Derived>::getTapeView_() {
+template <class Derived, class T>
+inline BasicTapeView<T>& WriteIteratorBase<Derived, T>::getTapeView_() {
   return *tapeView_;
 }
 
@@ -1,35 +1,333 @@
 #ifndef TAPE_SIMULATION_IMPROVED_MERGE_SORT_HPP
 #define TAPE_SIMULATION_IMPROVED_MERGE_SORT_HPP
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "copy_elements_sorted.hpp"
 #include "impl/merge_sort_impl.hpp"
+#include "impl/task_worker.hpp"
 #include "tape_pool.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief class MergeSort - merge sort class.
-class ImprovedMergeSortImproved : private MergeSortImpl {
+/// \brief class BasicImprovedMergeSortImproved - merge sort of a tape of
+/// elements of type T with initial blocks sorted in memory.
+template <class T>
+class BasicImprovedMergeSortImproved : private MergeSortImpl<T> {
  public:
   class ZeroHeapSizeLimit : std::logic_error {
    public:
     ZeroHeapSizeLimit();
   };
 
+  class ZeroSortThreadsCnt : public std::logic_error {
+   public:
+    ZeroSortThreadsCnt();
+  };
+
+ private:
+  using typename MergeSortImpl<T>::TapeViewT;
+  using typename MergeSortImpl<T>::RightReadIteratorT;
+  using typename MergeSortImpl<T>::RightWriteIteratorT;
+
+  /// Initial block read ahead and sorted by a worker.
+  struct PendingBlock_ {
+    std::vector<T> values;
+    bool toOut1;
+    std::future<void> sorted;
+  };
+
  public:
-  ImprovedMergeSortImproved(TapePool& tapePool, std::string_view inFilename,
-                    std::string_view tmpDirectory, bool increasing,
-                    std::size_t heapSizeLimit);
+  /**
+   * @brief BasicImprovedMergeSortImproved constructor.
+   *
+   * @param tapePool pool of tapes.
+   * @param inFilename tape to sort.
+   * @param tmpDirectory directory of temporary tapes.
+   * @param increasing sort order.
+   * @param heapSizeLimit length of initial blocks sorted in memory.
+   * @param runGeneration way of making initial runs.
+   * @param preScan scan the input for natural runs before sorting.
+   * @param parallelPasses merge blocks to both output tapes of a pass at once.
+   * @param mergePipeline pipeline of long merges of blocks or null.
+   * @param sortThreadsCnt threads sorting initial blocks. Blocks are read
+   * ahead, so up to sortThreadsCnt * heapSizeLimit elements are kept in
+   * memory. Blocks and counted operations do not depend on it.
+   */
+  BasicImprovedMergeSortImproved(
+      TapePool& tapePool, std::string_view inFilename,
+      std::string_view tmpDirectory, bool increasing,
+      std::size_t heapSizeLimit,
+      RunGeneration runGeneration = RunGeneration::FixedBlocks,
+      bool preScan = false, bool parallelPasses = false,
+      MergePipeline* mergePipeline = nullptr, std::size_t sortThreadsCnt = 1);
 
   void perform(std::string_view outFilename) &&;
 
  private:
-  void makeInitialBlocks_(TapeView& in, TapeView& out0, TapeView& out1) const;
+  void makeInitialBlocks_(TapeViewT& in, TapeViewT& out0,
+                          TapeViewT& out1) const;
+
+  void makeInitialBlocksInParallel_(TapeViewT& in, TapeViewT& out0,
+                                    TapeViewT& out1) const;
+
+  static void writeSortedBlock_(PendingBlock_& block,
+                                RightWriteIteratorT& write, bool first);
 
-  static void copyElementsSorted_(RightReadIterator read,
-                                  RightWriteIterator write, std::size_t cnt,
+  static void copyElementsSorted_(RightReadIteratorT read,
+                                  RightWriteIteratorT write, std::size_t cnt,
                                   bool increasing);
+
+ private:
+  const std::size_t sortThreadsCnt_;
 };
 
+using ImprovedMergeSortImproved = BasicImprovedMergeSortImproved<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicImprovedMergeSortImproved<T>::ZeroHeapSizeLimit::ZeroHeapSizeLimit()
+    : std::logic_error("heapSizeLimit can not be zero.") {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicImprovedMergeSortImproved<T>::ZeroSortThreadsCnt::ZeroSortThreadsCnt()
+    : std::logic_error("sortThreadsCnt can not be zero.") {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicImprovedMergeSortImproved<T>::BasicImprovedMergeSortImproved(
+    TapePool& tapePool, std::string_view inFilename,
+    std::string_view tmpDirectory, bool increasing, std::size_t heapSizeLimit,
+    RunGeneration runGeneration, bool preScan, bool parallelPasses,
+    MergePipeline* mergePipeline, std::size_t sortThreadsCnt)
+    : MergeSortImpl<T>(tapePool, inFilename, tmpDirectory, heapSizeLimit,
+                       increasing, runGeneration, preScan, parallelPasses,
+                       mergePipeline),
+      sortThreadsCnt_{sortThreadsCnt} {
+  if (heapSizeLimit == 0) {
+    throw ZeroHeapSizeLimit();
+  }
+  if (sortThreadsCnt == 0) {
+    throw ZeroSortThreadsCnt();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicImprovedMergeSortImproved<T>::perform(
+    std::string_view outFilename) && {
+  auto inTape = this->tapePool_->template getOpenedTape<T>(this->inHandle_);
+  auto outTape = this->createOutTape_(inTape, outFilename);
+
+  if (inTape.getPosition() != 0) {
+    throw std::logic_error("Input tape head is not in the beginning.");
+  }
+
+  if (this->elementsCnt_ == 0) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->elementsCnt_ == 1) {
+    outTape.write(inTape.read());
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->copyIfSorted_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->elementsCnt_ <= this->initialBlockSize_) {
+    auto read = RightReadIteratorT(inTape);
+    auto write = RightWriteIteratorT(outTape);
+    if (this->increasing_) {
+      copy_top_elements_sorted(read, write, this->elementsCnt_);
+    } else {
+      copy_bottom_elements_sorted(read, write, this->elementsCnt_);
+    }
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->preScan_ && this->preScanAndSort_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->runGeneration_ != RunGeneration::FixedBlocks) {
+    this->sortRuns_(inTape, outTape);
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  makeInitialBlocks_(inTape, this->getTapesManager_().getInitialOutTape0(),
+                     this->getTapesManager_().getInitialOutTape1());
+
+  std::size_t iterationsLeft = this->iterationsCnt_;
+  std::size_t blockSize = this->initialBlockSize_;
+
+  for (; iterationsLeft > 0; --iterationsLeft, blockSize *= 2) {
+    const std::size_t iterationIdx = this->iterationsCnt_ - iterationsLeft;
+    this->mergeBlocks_(blockSize, iterationIdx, iterationsLeft);
+  }
+
+  this->mergeIntoOutputTape_(
+      this->getTapesManager_().getInTape0(this->iterationsCnt_),
+      this->getTapesManager_().getInTape1(this->iterationsCnt_), outTape);
+  this->closeSortedOutTape_(outTape);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicImprovedMergeSortImproved<T>::makeInitialBlocks_(
+    TapeViewT& in, TapeViewT& out0, TapeViewT& out1) const {
+  if (sortThreadsCnt_ > 1) {
+    makeInitialBlocksInParallel_(in, out0, out1);
+    return;
+  }
+  const std::size_t initialBlockSize = this->initialBlockSize_;
+  const auto [blocksOut0, blocksOut1] = this->getBlocksCnts_(initialBlockSize);
+  auto read = RightReadIteratorT(in);
+  auto write0 = RightWriteIteratorT(out0);
+  auto write1 = RightWriteIteratorT(out1);
+  bool increasing =
+      (this->iterationsCnt_ % 2 == 0) ? !this->increasing_ : this->increasing_;
+  for (std::size_t i = 0; i < blocksOut0; ++i) {
+    copyElementsSorted_(read, write0, initialBlockSize, increasing);
+    if (i + 1 != blocksOut0) {
+      ++read;
+      ++write0;
+    }
+  }
+
+  if (blocksOut1 != 0) {
+    ++read;
+    for (std::size_t i = 0; i < blocksOut1; ++i) {
+      copyElementsSorted_(read, write1, initialBlockSize, increasing);
+      if (i + 1 != blocksOut1) {
+        ++read;
+        ++write1;
+      }
+    }
+  }
+
+  if (std::size_t tailSize = this->elementsCnt_ % initialBlockSize;
+      tailSize != 0) {
+    auto write = (blocksOut0 == blocksOut1 + 1) ? write1 : write0;
+    if (const auto blockBeforeTail =
+            (blocksOut0 == blocksOut1 + 1) ? blocksOut1 : blocksOut0;
+        blockBeforeTail != 0) {
+      ++write;
+    }
+    ++read;
+    copyElementsSorted_(read, write, tailSize, increasing);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicImprovedMergeSortImproved<T>::makeInitialBlocksInParallel_(
+    TapeViewT& in, TapeViewT& out0, TapeViewT& out1) const {
+  // Tapes are used by this thread only and see the same operations as with
+  // makeInitialBlocks_, workers sort blocks already read to memory.
+  const std::size_t initialBlockSize = this->initialBlockSize_;
+  const auto [blocksOut0, blocksOut1] = this->getBlocksCnts_(initialBlockSize);
+  auto blocks = std::vector<std::pair<std::size_t, bool>>(
+      blocksOut0, {initialBlockSize, false});
+  blocks.resize(blocksOut0 + blocksOut1, {initialBlockSize, true});
+  if (std::size_t tailSize = this->elementsCnt_ % initialBlockSize;
+      tailSize != 0) {
+    blocks.emplace_back(tailSize, blocksOut0 == blocksOut1 + 1);
+  }
+  const bool increasing =
+      (this->iterationsCnt_ % 2 == 0) ? !this->increasing_ : this->increasing_;
+
+  auto read = RightReadIteratorT(in);
+  auto write0 = RightWriteIteratorT(out0);
+  auto write1 = RightWriteIteratorT(out1);
+  auto written = std::array<bool, 2>{false, false};
+  const auto writeFront = [&](std::deque<PendingBlock_>& pending) {
+    auto& block = pending.front();
+    writeSortedBlock_(block, block.toOut1 ? write1 : write0,
+                      !written[block.toOut1 ? 1 : 0]);
+    written[block.toOut1 ? 1 : 0] = true;
+    pending.pop_front();
+  };
+
+  // Workers are destroyed, finishing their tasks, before pending blocks.
+  auto pending = std::deque<PendingBlock_>();
+  auto workers = std::vector<TaskWorker>(sortThreadsCnt_);
+  for (std::size_t blockIdx = 0; blockIdx < blocks.size(); ++blockIdx) {
+    if (pending.size() == workers.size()) {
+      writeFront(pending);
+    }
+    const auto [size, toOut1] = blocks[blockIdx];
+    auto& block = pending.emplace_back(std::vector<T>(size), toOut1);
+    for (std::size_t i = 0; i < size; ++i) {
+      if (blockIdx != 0 || i != 0) {
+        ++read;
+      }
+      block.values[i] = *read;
+    }
+    block.sorted = workers[blockIdx % workers.size()].submit(
+        [&values = block.values, increasing]() {
+          if (increasing) {
+            std::sort(values.begin(), values.end(), std::less<>());
+          } else {
+            std::sort(values.begin(), values.end(), std::greater<>());
+          }
+        });
+  }
+  while (!pending.empty()) {
+    writeFront(pending);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicImprovedMergeSortImproved<T>::writeSortedBlock_(
+    PendingBlock_& block, RightWriteIteratorT& write, bool first) {
+  block.sorted.get();
+  if (!first) {
+    ++write;
+  }
+  for (std::size_t i = 0; i < block.values.size(); ++i) {
+    *write = block.values[i];
+    if (i + 1 != block.values.size()) {
+      ++write;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicImprovedMergeSortImproved<T>::copyElementsSorted_(
+    RightReadIteratorT read, RightWriteIteratorT write, std::size_t cnt,
+    bool increasing) {
+  if (increasing) {
+    copy_top_elements_sorted(read, write, cnt);
+  } else {
+    copy_bottom_elements_sorted(read, write, cnt);
+  }
+}
+
+extern template class BasicImprovedMergeSortImproved<std::int32_t>;
+extern template class BasicImprovedMergeSortImproved<std::int64_t>;
+extern template class BasicImprovedMergeSortImproved<std::uint64_t>;
+extern template class BasicImprovedMergeSortImproved<float>;
+extern template class BasicImprovedMergeSortImproved<double>;
+
 #endif  // TAPE_SIMULATION_IMPROVED_MERGE_SORT_HPP
@@ -0,0 +1,297 @@
+#ifndef TAPE_SIMULATION_K_WAY_MERGE_SORT_HPP
+#define TAPE_SIMULATION_K_WAY_MERGE_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "copy_elements_sorted.hpp"
+#include "impl/merge_runs.hpp"
+#include "impl/tape_sort_base.hpp"
+#include "impl/tmp_tapes_manager.hpp"
+#include "tape_pool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class BasicKWayMergeSort - balanced k-way merge sort of a tape of
+/// elements of type T. Initial runs are distributed over k temporary tapes and
+/// every pass merges k runs into one with a loser tree, moving them to the
+/// other k temporary tapes. It takes ceil(log_k(runs)) passes instead of
+/// ceil(log_2(runs)) of MergeSort. Tapes written right in a pass are read left
+/// in the next one, so no rewinds are needed and runs order flips every pass.
+template <class T>
+class BasicKWayMergeSort : private TapeSortBase<T> {
+ public:
+  class InvalidWaysCnt : public std::invalid_argument {
+   public:
+    explicit InvalidWaysCnt(std::size_t waysCnt);
+
+   private:
+    static std::string generateMessage_(std::size_t waysCnt);
+  };
+
+ private:
+  using typename TapeSortBase<T>::TapeViewT;
+  /// Lengths of runs on each of k tapes in order of writing.
+  using Runs_ = std::vector<std::vector<std::size_t>>;
+
+ public:
+  /**
+   * @brief BasicKWayMergeSort constructor.
+   *
+   * @param tapePool pool of tapes.
+   * @param inFilename tape to sort.
+   * @param tmpDirectory directory of 2k temporary tapes.
+   * @param increasing sort order.
+   * @param waysCnt number of runs merged at once, at least two.
+   * @param initialBlockSize length of initial runs sorted in memory.
+   */
+  BasicKWayMergeSort(TapePool& tapePool, std::string_view inFilename,
+                     std::string_view tmpDirectory, bool increasing,
+                     std::size_t waysCnt, std::size_t initialBlockSize = 1);
+
+  void perform(std::string_view outFilename) &&;
+
+ private:
+  [[nodiscard]] Runs_ calcInitialRuns_() const;
+
+  [[nodiscard]] Runs_ calcMergedRuns_(Runs_ runs) const;
+
+  [[nodiscard]] std::size_t calcPassesCnt_() const;
+
+  [[nodiscard]] std::vector<std::size_t> calcTmpTapesSizes_() const;
+
+  void makeInitialRuns_(TapeViewT& in, const Runs_& runs, bool increasing);
+
+  void mergePass_(Runs_ inRuns, std::size_t inBegin,
+                  std::optional<std::size_t> outBegin, TapeViewT* outTape,
+                  bool increasing);
+
+ private:
+  std::size_t waysCnt_;
+  std::size_t initialBlockSize_;
+  TmpTapesManager<T> tapesManager_;
+};
+
+using KWayMergeSort = BasicKWayMergeSort<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicKWayMergeSort<T>::InvalidWaysCnt::InvalidWaysCnt(std::size_t waysCnt)
+    : std::invalid_argument(generateMessage_(waysCnt)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::string BasicKWayMergeSort<T>::InvalidWaysCnt::generateMessage_(
+    std::size_t waysCnt) {
+  std::stringstream messageStream;
+  messageStream << "K-way merge sort needs at least two ways, got " << waysCnt
+                << ".";
+  return messageStream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicKWayMergeSort<T>::BasicKWayMergeSort(TapePool& tapePool,
+                                          std::string_view inFilename,
+                                          std::string_view tmpDirectory,
+                                          bool increasing, std::size_t waysCnt,
+                                          std::size_t initialBlockSize)
+    : TapeSortBase<T>(tapePool, inFilename, increasing),
+      waysCnt_{waysCnt < 2 ? throw InvalidWaysCnt(waysCnt) : waysCnt},
+      initialBlockSize_{initialBlockSize == 0
+                            ? throw std::invalid_argument(
+                                  "Initial block size can not be zero.")
+                            : initialBlockSize},
+      tapesManager_(tapePool, tmpDirectory, calcTmpTapesSizes_()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicKWayMergeSort<T>::perform(std::string_view outFilename) && {
+  auto inTape = this->getInTape_();
+  auto outTape = this->createOutTape_(inTape, outFilename);
+
+  if (this->elementsCnt_ == 0 || this->copyIfSorted_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->elementsCnt_ <= initialBlockSize_) {
+    auto read = BasicRightReadIterator<T>(inTape);
+    auto write = BasicRightWriteIterator<T>(outTape);
+    if (this->increasing_) {
+      copy_top_elements_sorted(read, write, this->elementsCnt_);
+    } else {
+      copy_bottom_elements_sorted(read, write, this->elementsCnt_);
+    }
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  const std::size_t passesCnt = calcPassesCnt_();
+  // The last pass writes runs in the requested order.
+  bool increasing =
+      (passesCnt % 2 == 0) ? this->increasing_ : !this->increasing_;
+  auto runs = calcInitialRuns_();
+  makeInitialRuns_(inTape, runs, increasing);
+
+  for (std::size_t pass = 0; pass + 1 < passesCnt; ++pass) {
+    increasing = !increasing;
+    const std::size_t inBegin = (pass % 2 == 0) ? 0 : waysCnt_;
+    mergePass_(runs, inBegin, waysCnt_ - inBegin, nullptr, increasing);
+    runs = calcMergedRuns_(std::move(runs));
+  }
+
+  const std::size_t inBegin = (passesCnt % 2 == 1) ? 0 : waysCnt_;
+  mergePass_(std::move(runs), inBegin, std::nullopt, &outTape,
+             this->increasing_);
+  this->closeSortedOutTape_(outTape);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicKWayMergeSort<T>::calcInitialRuns_() const -> Runs_ {
+  auto runs = Runs_(waysCnt_);
+  const std::size_t runsCnt =
+      (this->elementsCnt_ + initialBlockSize_ - 1) / initialBlockSize_;
+  for (std::size_t i = 0; i < runsCnt; ++i) {
+    const std::size_t left = this->elementsCnt_ - i * initialBlockSize_;
+    runs[i % waysCnt_].push_back(std::min(initialBlockSize_, left));
+  }
+  return runs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicKWayMergeSort<T>::calcMergedRuns_(Runs_ runs) const -> Runs_ {
+  // Tapes are read left, so the last written runs are merged first.
+  auto merged = Runs_(waysCnt_);
+  for (std::size_t groupIdx = 0;; ++groupIdx) {
+    std::size_t length = 0;
+    for (auto& tapeRuns : runs) {
+      if (!tapeRuns.empty()) {
+        length += tapeRuns.back();
+        tapeRuns.pop_back();
+      }
+    }
+    if (length == 0) {
+      return merged;
+    }
+    merged[groupIdx % waysCnt_].push_back(length);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::size_t BasicKWayMergeSort<T>::calcPassesCnt_() const {
+  std::size_t runsCnt =
+      (this->elementsCnt_ + initialBlockSize_ - 1) / initialBlockSize_;
+  std::size_t passesCnt = 1;
+  for (; runsCnt > waysCnt_; ++passesCnt) {
+    runsCnt = (runsCnt + waysCnt_ - 1) / waysCnt_;
+  }
+  return passesCnt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::vector<std::size_t> BasicKWayMergeSort<T>::calcTmpTapesSizes_() const {
+  auto sizes = std::vector<std::size_t>(2 * waysCnt_);
+  if (this->elementsCnt_ <= initialBlockSize_) {
+    return sizes;
+  }
+  auto runs = calcInitialRuns_();
+  const std::size_t passesCnt = calcPassesCnt_();
+  for (std::size_t pass = 0; pass < passesCnt; ++pass) {
+    const std::size_t begin = (pass % 2 == 0) ? 0 : waysCnt_;
+    for (std::size_t i = 0; i < waysCnt_; ++i) {
+      const auto& tapeRuns = runs[i];
+      sizes[begin + i] =
+          std::max(sizes[begin + i],
+                   std::accumulate(tapeRuns.begin(), tapeRuns.end(),
+                                   std::size_t{0}));
+    }
+    runs = calcMergedRuns_(std::move(runs));
+  }
+  return sizes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicKWayMergeSort<T>::makeInitialRuns_(TapeViewT& in, const Runs_& runs,
+                                             bool increasing) {
+  auto read = BasicRightReadIterator<T>(in);
+  const std::size_t runsCnt =
+      (this->elementsCnt_ + initialBlockSize_ - 1) / initialBlockSize_;
+  for (std::size_t runIdx = 0; runIdx < runsCnt; ++runIdx) {
+    auto& tape = tapesManager_.getTape(runIdx % waysCnt_);
+    if (runIdx >= waysCnt_) {
+      tape.moveRight();
+    }
+    if (runIdx != 0) {
+      ++read;
+    }
+    // Runs are dealt round robin.
+    const std::size_t length = runs[runIdx % waysCnt_][runIdx / waysCnt_];
+    auto write = BasicRightWriteIterator<T>(tape);
+    if (increasing) {
+      copy_top_elements_sorted(read, write, length);
+    } else {
+      copy_bottom_elements_sorted(read, write, length);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicKWayMergeSort<T>::mergePass_(Runs_ inRuns, std::size_t inBegin,
+                                       std::optional<std::size_t> outBegin,
+                                       TapeViewT* outTape, bool increasing) {
+  auto started = std::vector<bool>(waysCnt_, false);
+  for (std::size_t groupIdx = 0;; ++groupIdx) {
+    auto sources = std::vector<TapeViewT*>{};
+    auto lengths = std::vector<std::size_t>{};
+    for (std::size_t i = 0; i < waysCnt_; ++i) {
+      if (inRuns[i].empty()) {
+        continue;
+      }
+      auto& tape = tapesManager_.getTape(inBegin + i);
+      if (started[i]) {
+        tape.moveLeft();
+      }
+      started[i] = true;
+      sources.push_back(&tape);
+      lengths.push_back(inRuns[i].back());
+      inRuns[i].pop_back();
+    }
+    if (sources.empty()) {
+      return;
+    }
+    auto& target = outBegin.has_value()
+                       ? tapesManager_.getTape(*outBegin + groupIdx % waysCnt_)
+                       : *outTape;
+    if (groupIdx >= waysCnt_) {
+      target.moveRight();
+    }
+    if (increasing) {
+      merge_runs<std::less<>>(sources, lengths, target);
+    } else {
+      merge_runs<std::greater<>>(sources, lengths, target);
+    }
+  }
+}
+
+extern template class BasicKWayMergeSort<std::int32_t>;
+extern template class BasicKWayMergeSort<std::int64_t>;
+extern template class BasicKWayMergeSort<std::uint64_t>;
+extern template class BasicKWayMergeSort<float>;
+extern template class BasicKWayMergeSort<double>;
+
+#endif  // TAPE_SIMULATION_K_WAY_MERGE_SORT_HPP
@@ -0,0 +1,33 @@
+#ifndef TAPE_SIMULATION_KEYED_RECORD_HPP
+#define TAPE_SIMULATION_KEYED_RECORD_HPP
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief struct KeyedRecord - fixed-size record of a key and an opaque
+/// payload. Records are ordered by key only.
+template <std::size_t PayloadSize>
+struct KeyedRecord {
+  std::int64_t key;
+  std::array<std::byte, PayloadSize> payload;
+
+  friend auto operator<=>(const KeyedRecord& lhs, const KeyedRecord& rhs) {
+    return lhs.key <=> rhs.key;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief struct RecordTag - key of a record and the record index on its
+/// tape. Tags are ordered by key, then by index.
+struct RecordTag {
+  std::int64_t key;
+  std::uint64_t index;
+
+  friend auto operator<=>(const RecordTag& lhs,
+                          const RecordTag& rhs) = default;
+};
+
+#endif  // TAPE_SIMULATION_KEYED_RECORD_HPP
@@ -0,0 +1,94 @@
+#ifndef TAPE_SIMULATION_MERGE_PIPELINE_HPP
+#define TAPE_SIMULATION_MERGE_PIPELINE_HPP
+
+#include <cstdint>
+#include <mutex>
+
+#include "impl/pipelined_merge.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class MergePipeline - settings of merges done by reader, merger and
+/// writer threads and stalls of their stages summed over all merges. Merges
+/// may be run from different threads.
+class MergePipeline {
+ public:
+  using Statistics = MergePipelineStatistics;
+
+ public:
+  /// Default elements count of a ring between stages.
+  constexpr static std::size_t defaultRingCapacity = 1 << 12;
+  /// Default least elements count of a merge worth starting threads.
+  constexpr static std::size_t defaultMinElementsCnt = 1 << 14;
+
+ public:
+  /**
+   * @brief MergePipeline constructor.
+   *
+   * @param ringCapacity elements count of a ring between stages.
+   * @param minElementsCnt shorter merges are done on a single thread.
+   */
+  explicit MergePipeline(std::size_t ringCapacity = defaultRingCapacity,
+                         std::size_t minElementsCnt = defaultMinElementsCnt);
+
+  /**
+   * @brief Check if a merge is long enough to be pipelined.
+   *
+   * @param elementsCnt elements count of both sources.
+   * @return true if pipelined merge is to be used.
+   */
+  [[nodiscard]] bool isWorthPipelining(std::size_t elementsCnt) const;
+
+  /**
+   * @brief Merge two ranges with pipelined_merge and add its stalls.
+   *
+   * @tparam Compare strict ordering of sources.
+   * @tparam InputIterator1 first input iterator type.
+   * @tparam InputIterator2 second input iterator type.
+   * @tparam OutputIterator output iterator type.
+   * @param source0 first range input iterator.
+   * @param cnt0 first range length.
+   * @param source1 second range input iterator.
+   * @param cnt1 second range length.
+   * @param target output iterator.
+   */
+  template <class Compare, class InputIterator1, class InputIterator2,
+            class OutputIterator>
+  void merge(InputIterator1 source0, std::size_t cnt0, InputIterator2 source1,
+             std::size_t cnt1, OutputIterator target);
+
+  /**
+   * @brief Get stalls of stages summed over finished merges.
+   *
+   * @return stalls counts.
+   */
+  [[nodiscard]] Statistics getStatistics() const;
+
+  /**
+   * @brief Get count of pipelined merges.
+   *
+   * @return merges count.
+   */
+  [[nodiscard]] std::size_t getMergesCnt() const;
+
+ private:
+  void addStatistics_(const Statistics& statistics);
+
+ private:
+  std::size_t ringCapacity_;
+  std::size_t minElementsCnt_;
+  mutable std::mutex mutex_;
+  Statistics statistics_{};
+  std::size_t mergesCnt_{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class Compare, class InputIterator1, class InputIterator2,
+          class OutputIterator>
+void MergePipeline::merge(InputIterator1 source0, std::size_t cnt0,
+                          InputIterator2 source1, std::size_t cnt1,
+                          OutputIterator target) {
+  addStatistics_(pipelined_merge<Compare>(source0, cnt0, source1, cnt1,
+                                          target, ringCapacity_));
+}
+
+#endif  // TAPE_SIMULATION_MERGE_PIPELINE_HPP
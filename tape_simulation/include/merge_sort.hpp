@@ -2,23 +2,120 @@
 #define TAPE_SIMULATION_MERGE_SORT_HPP
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
+#include "copy_n.hpp"
 #include "impl/merge_sort_impl.hpp"
 #include "tape_pool.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief class MergeSort - merge sort class.
-class MergeSort : private MergeSortImpl {
+/// \brief class BasicMergeSort - merge sort of a tape of elements of type T.
+template <class T>
+class BasicMergeSort : private MergeSortImpl<T> {
+ private:
+  using typename MergeSortImpl<T>::TapeViewT;
+  using typename MergeSortImpl<T>::RightReadIteratorT;
+  using typename MergeSortImpl<T>::RightWriteIteratorT;
+
  public:
-  MergeSort(TapePool& tapePool, std::string_view inFilename,
-            std::string_view tmpDirectory, bool increasing);
+  BasicMergeSort(TapePool& tapePool, std::string_view inFilename,
+                 std::string_view tmpDirectory, bool increasing,
+                 RunGeneration runGeneration = RunGeneration::FixedBlocks,
+                 bool preScan = false, bool parallelPasses = false,
+                 MergePipeline* mergePipeline = nullptr);
 
   void perform(std::string_view outFilename) &&;
 
  private:
-  void makeInitialBlocks_(TapeView& in, TapeView& out0, TapeView& out1) const;
+  void makeInitialBlocks_(TapeViewT& in, TapeViewT& out0,
+                          TapeViewT& out1) const;
 };
 
+using MergeSort = BasicMergeSort<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicMergeSort<T>::BasicMergeSort(TapePool& tapePool,
+                                  std::string_view inFilename,
+                                  std::string_view tmpDirectory,
+                                  bool increasing, RunGeneration runGeneration,
+                                  bool preScan, bool parallelPasses,
+                                  MergePipeline* mergePipeline)
+    : MergeSortImpl<T>(tapePool, inFilename, tmpDirectory, 1, increasing,
+                       runGeneration, preScan, parallelPasses, mergePipeline) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicMergeSort<T>::perform(std::string_view outFilename) && {
+  auto inTape = this->tapePool_->template getOpenedTape<T>(this->inHandle_);
+  auto outTape = this->createOutTape_(inTape, outFilename);
+
+  if (inTape.getPosition() != 0) {
+    throw std::logic_error("Input tape head is not in the beginning.");
+  }
+
+  if (this->elementsCnt_ == 0) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->elementsCnt_ == 1) {
+    outTape.write(inTape.read());
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->copyIfSorted_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->preScan_ && this->preScanAndSort_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->runGeneration_ != RunGeneration::FixedBlocks) {
+    this->sortRuns_(inTape, outTape);
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  makeInitialBlocks_(inTape, this->getTapesManager_().getInitialOutTape0(),
+                     this->getTapesManager_().getInitialOutTape1());
+
+  std::size_t iterationsLeft = this->iterationsCnt_;
+  std::size_t blockSize = 1;
+
+  for (; iterationsLeft > 0; --iterationsLeft, blockSize *= 2) {
+    const std::size_t iterationIdx = this->iterationsCnt_ - iterationsLeft;
+    this->mergeBlocks_(blockSize, iterationIdx, iterationsLeft);
+  }
+
+  this->mergeIntoOutputTape_(
+      this->getTapesManager_().getInTape0(this->iterationsCnt_),
+      this->getTapesManager_().getInTape1(this->iterationsCnt_), outTape);
+  this->closeSortedOutTape_(outTape);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicMergeSort<T>::makeInitialBlocks_(TapeViewT& in, TapeViewT& out0,
+                                           TapeViewT& out1) const {
+  const auto [to0Cnt, to1Cnt] = this->getBlocksCnts_(1);
+  auto read = RightReadIteratorT(in);
+  copy_n(read, to0Cnt, RightWriteIteratorT(out0));
+  ++read;
+  copy_n(read, to1Cnt, RightWriteIteratorT(out1));
+}
+
+extern template class BasicMergeSort<std::int32_t>;
+extern template class BasicMergeSort<std::int64_t>;
+extern template class BasicMergeSort<std::uint64_t>;
+extern template class BasicMergeSort<float>;
+extern template class BasicMergeSort<double>;
+
 #endif  // TAPE_SIMULATION_MERGE_SORT_HPP
@@ -0,0 +1,321 @@
+#ifndef TAPE_SIMULATION_PARALLEL_TAPE_SORT_HPP
+#define TAPE_SIMULATION_PARALLEL_TAPE_SORT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "copy_n.hpp"
+#include "impl/loser_tree.hpp"
+#include "impl/tape_sort_base.hpp"
+#include "improved_merge_sort.hpp"
+#include "tape_pool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class BasicParallelTapeSort - sort of a tape of elements of type T
+/// split into contiguous segments. Every worker thread copies its segment
+/// from the input to a temporary tape of its own pool and sorts it with
+/// BasicImprovedMergeSortImproved in its own temporary directory. Sorted
+/// segments are merged to the output tape with a loser tree by the calling
+/// thread. Workers open the input file themselves, so the pool must keep
+/// tapes in plain files: memory backed tapes are not visible to workers, and
+/// direct and asynchronous backends keep unflushed blocks of the input.
+template <class T>
+class BasicParallelTapeSort : private TapeSortBase<T> {
+ public:
+  using IOStatistics = TapePool::IOStatistics;
+  using Duration = std::chrono::steady_clock::duration;
+
+  class ZeroWorkersCnt : public std::logic_error {
+   public:
+    ZeroWorkersCnt();
+  };
+
+  /// Statistics of a performed sort.
+  struct Report {
+    /// Operations of each worker pool: segment copy and segment sort.
+    std::vector<IOStatistics> workerStatistics;
+    /// Operations of the final merge by the calling thread.
+    IOStatistics mergeStatistics;
+    /// Sum of operations of workers and of the final merge.
+    IOStatistics aggregateStatistics;
+    /// Wall-clock time of sorting segments by workers.
+    Duration sortTime;
+    /// Wall-clock time of the final merge.
+    Duration mergeTime;
+  };
+
+ private:
+  using typename TapeSortBase<T>::TapeViewT;
+
+ public:
+  /**
+   * @brief BasicParallelTapeSort constructor.
+   *
+   * @param tapePool pool of tapes. Worker pools get its backend types and
+   * statistics of workers and of the merge are added to it. File and mmap
+   * backends only.
+   * @param inFilename tape to sort.
+   * @param tmpDirectory directory of worker directories.
+   * @param increasing sort order.
+   * @param heapSizeLimit length of initial blocks sorted in memory by each
+   * worker.
+   * @param workersCnt number of segments sorted at once. Short tapes are
+   * split to fewer segments, one element at least in each.
+   */
+  BasicParallelTapeSort(TapePool& tapePool, std::string_view inFilename,
+                        std::string_view tmpDirectory, bool increasing,
+                        std::size_t heapSizeLimit, std::size_t workersCnt);
+
+  Report perform(std::string_view outFilename) &&;
+
+ private:
+  [[nodiscard]] std::vector<std::size_t> calcSegmentsSizes_() const;
+
+  [[nodiscard]] std::string getWorkerDirectory_(std::size_t workerIdx) const;
+
+  [[nodiscard]] std::string getSortedFilename_(std::size_t workerIdx) const;
+
+  IOStatistics sortSegment_(std::size_t workerIdx, std::size_t begin,
+                            std::size_t size) const;
+
+  template <class Compare>
+  void mergeSegments_(std::vector<TapeViewT>& sources,
+                      const std::vector<std::size_t>& lengths,
+                      TapeViewT& target) const;
+
+ private:
+  std::string tmpDirectory_;
+  std::size_t heapSizeLimit_;
+  std::size_t workersCnt_;
+};
+
+using ParallelTapeSort = BasicParallelTapeSort<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicParallelTapeSort<T>::ZeroWorkersCnt::ZeroWorkersCnt()
+    : std::logic_error("Parallel tape sort needs at least one worker.") {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicParallelTapeSort<T>::BasicParallelTapeSort(
+    TapePool& tapePool, std::string_view inFilename,
+    std::string_view tmpDirectory, bool increasing, std::size_t heapSizeLimit,
+    std::size_t workersCnt)
+    : TapeSortBase<T>(tapePool, inFilename, increasing),
+      tmpDirectory_{tmpDirectory},
+      heapSizeLimit_{heapSizeLimit},
+      workersCnt_{workersCnt == 0 ? throw ZeroWorkersCnt() : workersCnt} {
+  switch (tapePool.getBackendType()) {
+    case TapeBackendType::Memory:
+      throw std::invalid_argument(
+          "Parallel tape sort workers can not open memory backed tapes.");
+    case TapeBackendType::Direct:
+    case TapeBackendType::Async:
+      throw std::invalid_argument(
+          "Parallel tape sort workers reopen the input file, direct and "
+          "asynchronous backends are not supported.");
+    default:
+      break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicParallelTapeSort<T>::perform(std::string_view outFilename) &&
+    -> Report {
+  // Reads, writes and moves of the calling thread, tapes operations are
+  // counted by the pool and added to the report by hand.
+  auto mergeCounter = TapeOperationsCounter();
+  auto inTape = this->getInTape_().countedBy(mergeCounter);
+  auto outTape =
+      this->createOutTape_(inTape, outFilename).countedBy(mergeCounter);
+  auto report = Report{};
+
+  if (this->elementsCnt_ == 0 || this->copyIfSorted_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    this->tapePool_->addStatistics(mergeCounter.getStatistics());
+    report.mergeStatistics = mergeCounter.getStatistics();
+    report.mergeStatistics.createCnt = 1;
+    report.mergeStatistics.closeCnt = 1;
+    report.aggregateStatistics = report.mergeStatistics;
+    return report;
+  }
+
+  // Workers read the input file with their own tapes.
+  inTape.flush();
+  const bool needToRemove = !std::filesystem::exists(tmpDirectory_);
+  std::filesystem::create_directories(tmpDirectory_);
+
+  const auto segmentsSizes = calcSegmentsSizes_();
+  report.workerStatistics.resize(segmentsSizes.size());
+  auto errors = std::vector<std::exception_ptr>(segmentsSizes.size());
+  const auto sortStart = std::chrono::steady_clock::now();
+  {
+    auto workers = std::vector<std::jthread>{};
+    workers.reserve(segmentsSizes.size());
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < segmentsSizes.size(); ++i) {
+      workers.emplace_back([this, &report, &errors, i, begin,
+                            size = segmentsSizes[i]]() {
+        try {
+          report.workerStatistics[i] = sortSegment_(i, begin, size);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+      begin += segmentsSizes[i];
+    }
+  }
+  report.sortTime = std::chrono::steady_clock::now() - sortStart;
+
+  for (std::size_t i = 0; i < segmentsSizes.size(); ++i) {
+    this->tapePool_->addStatistics(report.workerStatistics[i]);
+  }
+  for (const auto& error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  const auto mergeStart = std::chrono::steady_clock::now();
+  auto sources = std::vector<TapeViewT>{};
+  sources.reserve(segmentsSizes.size());
+  for (std::size_t i = 0; i < segmentsSizes.size(); ++i) {
+    sources.push_back(
+        this->tapePool_->template openTape<T>(getSortedFilename_(i))
+            .countedBy(mergeCounter));
+  }
+  if (this->increasing_) {
+    mergeSegments_<std::less<>>(sources, segmentsSizes, outTape);
+  } else {
+    mergeSegments_<std::greater<>>(sources, segmentsSizes, outTape);
+  }
+  for (std::size_t i = 0; i < segmentsSizes.size(); ++i) {
+    this->tapePool_->removeTape(sources[i].getHandle());
+    std::filesystem::remove_all(getWorkerDirectory_(i));
+  }
+  this->closeSortedOutTape_(outTape);
+  report.mergeTime = std::chrono::steady_clock::now() - mergeStart;
+  if (needToRemove) {
+    std::filesystem::remove(tmpDirectory_);
+  }
+
+  this->tapePool_->addStatistics(mergeCounter.getStatistics());
+  report.mergeStatistics = mergeCounter.getStatistics();
+  report.mergeStatistics.createCnt = 1;
+  report.mergeStatistics.openCnt = segmentsSizes.size();
+  report.mergeStatistics.closeCnt = 1;
+  report.mergeStatistics.removeCnt = segmentsSizes.size();
+
+  auto aggregate = TapeOperationsCounter();
+  for (const auto& workerStatistics : report.workerStatistics) {
+    aggregate.addStatistics(workerStatistics);
+  }
+  aggregate.addStatistics(report.mergeStatistics);
+  report.aggregateStatistics = aggregate.getStatistics();
+  return report;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::vector<std::size_t> BasicParallelTapeSort<T>::calcSegmentsSizes_()
+    const {
+  const std::size_t segmentsCnt = std::min(workersCnt_, this->elementsCnt_);
+  auto sizes = std::vector<std::size_t>(segmentsCnt,
+                                        this->elementsCnt_ / segmentsCnt);
+  for (std::size_t i = 0; i < this->elementsCnt_ % segmentsCnt; ++i) {
+    ++sizes[i];
+  }
+  return sizes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::string BasicParallelTapeSort<T>::getWorkerDirectory_(
+    std::size_t workerIdx) const {
+  return tmpDirectory_ + "/worker_" + std::to_string(workerIdx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::string BasicParallelTapeSort<T>::getSortedFilename_(
+    std::size_t workerIdx) const {
+  return getWorkerDirectory_(workerIdx) + "/sorted";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicParallelTapeSort<T>::sortSegment_(std::size_t workerIdx,
+                                            std::size_t begin,
+                                            std::size_t size) const
+    -> IOStatistics {
+  auto tapePool = TapePool(this->tapePool_->getBackendType(),
+                           this->tapePool_->getTmpBackendType());
+  const auto directory = getWorkerDirectory_(workerIdx);
+  std::filesystem::create_directory(directory);
+  const auto segmentFilename = directory + "/segment";
+  {
+    auto inTape = tapePool.openTape<T>(this->inFilename_);
+    auto segmentTape = tapePool.createTape<T>(segmentFilename, size,
+                                              tapePool.getTmpBackendType());
+    inTape.seek(begin);
+    copy_n(BasicRightReadIterator<T>(inTape), size,
+           BasicRightWriteIterator<T>(segmentTape));
+    segmentTape.seek(0);
+    tapePool.closeTape(inTape.getHandle());
+  }
+  // The sort closes the segment tape, its file goes with the directory.
+  BasicImprovedMergeSortImproved<T>(tapePool, segmentFilename,
+                                    directory + "/tmp", this->increasing_,
+                                    heapSizeLimit_)
+      .perform(getSortedFilename_(workerIdx));
+  return tapePool.getStatistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+template <class Compare>
+void BasicParallelTapeSort<T>::mergeSegments_(
+    std::vector<TapeViewT>& sources, const std::vector<std::size_t>& lengths,
+    TapeViewT& target) const {
+  auto left = lengths;
+  auto heads = std::vector<std::optional<T>>{};
+  heads.reserve(sources.size());
+  for (auto& source : sources) {
+    heads.emplace_back(source.read());
+  }
+  auto tree = LoserTree<T, Compare>(std::move(heads));
+  for (std::size_t written = 0; written < this->elementsCnt_; ++written) {
+    const std::size_t winner = tree.getWinner();
+    target.write(*tree.getWinnerValue());
+    if (written + 1 != this->elementsCnt_) {
+      target.moveRight();
+    }
+    if (--left[winner] == 0) {
+      tree.replaceWinner(std::nullopt);
+    } else {
+      sources[winner].moveRight();
+      tree.replaceWinner(sources[winner].read());
+    }
+  }
+}
+
+extern template class BasicParallelTapeSort<std::int32_t>;
+extern template class BasicParallelTapeSort<std::int64_t>;
+extern template class BasicParallelTapeSort<std::uint64_t>;
+extern template class BasicParallelTapeSort<float>;
+extern template class BasicParallelTapeSort<double>;
+
+#endif  // TAPE_SIMULATION_PARALLEL_TAPE_SORT_HPP
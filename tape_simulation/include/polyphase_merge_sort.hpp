@@ -0,0 +1,372 @@
+#ifndef TAPE_SIMULATION_POLYPHASE_MERGE_SORT_HPP
+#define TAPE_SIMULATION_POLYPHASE_MERGE_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "copy_elements_sorted.hpp"
+#include "impl/merge_runs.hpp"
+#include "impl/tape_sort_base.hpp"
+#include "impl/tmp_tapes_manager.hpp"
+#include "merge.hpp"
+#include "tape_pool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class BasicPolyphaseMergeSort - polyphase merge sort of a tape of
+/// elements of type T on a fixed number of working tapes, the output tape
+/// included. Initial runs are distributed over all working tapes but one in
+/// generalized Fibonacci numbers, missing runs are padded with empty dummy
+/// runs. Every phase merges runs into the empty tape until one of the source
+/// tapes empties, which becomes the target of the next phase. Input tape is
+/// read only once during the distribution and is not used as a working tape,
+/// so tapesCnt working tapes need tapesCnt + 1 drives: four at least. Tapes
+/// are used as stacks: written right and read left, so no rewinds are
+/// needed.
+template <class T>
+class BasicPolyphaseMergeSort : private TapeSortBase<T> {
+ public:
+  class InvalidTapesCnt : public std::invalid_argument {
+   public:
+    explicit InvalidTapesCnt(std::size_t tapesCnt);
+
+   private:
+    static std::string generateMessage_(std::size_t tapesCnt);
+  };
+
+ private:
+  using typename TapeSortBase<T>::TapeViewT;
+
+  /// Run of the plan. Merged runs refer to runs they are merged from.
+  struct Run_ {
+    std::size_t length;
+    std::vector<std::size_t> sources;
+    /// Order of the run read right.
+    bool increasing{true};
+  };
+
+  /// Merge of top runs of all tapes but the target one.
+  struct Merge_ {
+    std::size_t target;
+    std::size_t run;
+  };
+
+  /// Runs and merges of the sort computed before touching tapes.
+  struct Plan_ {
+    /// Initial runs in input order, then dummy runs, then merged runs.
+    std::vector<Run_> runs;
+    /// Working tape of each non-dummy initial run.
+    std::vector<std::size_t> initialTapes;
+    /// Runs on working tapes after the distribution in order of writing.
+    std::vector<std::vector<std::size_t>> initialStacks;
+    std::vector<Merge_> merges;
+    /// Maximum cells count of each working tape.
+    std::vector<std::size_t> capacities;
+    /// Working tape of the last merge, it is the output tape.
+    std::size_t finalTape{0};
+  };
+
+ public:
+  /**
+   * @brief BasicPolyphaseMergeSort constructor.
+   *
+   * @param tapePool pool of tapes.
+   * @param inFilename tape to sort.
+   * @param tmpDirectory directory of tapesCnt - 1 temporary tapes.
+   * @param increasing sort order.
+   * @param tapesCnt number of working tapes including the output one, at
+   * least three. The input tape is one more drive.
+   * @param initialBlockSize length of initial runs sorted in memory.
+   */
+  BasicPolyphaseMergeSort(TapePool& tapePool, std::string_view inFilename,
+                          std::string_view tmpDirectory, bool increasing,
+                          std::size_t tapesCnt = 3,
+                          std::size_t initialBlockSize = 1);
+
+  void perform(std::string_view outFilename) &&;
+
+ private:
+  [[nodiscard]] Plan_ makePlan_() const;
+
+  [[nodiscard]] std::vector<std::size_t> calcTmpTapesSizes_() const;
+
+  void distributeRuns_(TapeViewT& in, const std::vector<TapeViewT*>& tapes,
+                       std::vector<std::size_t>& contents);
+
+  void mergeRuns_(const Merge_& merge, const std::vector<TapeViewT*>& tapes,
+                  std::vector<std::vector<std::size_t>>& stacks,
+                  std::vector<std::size_t>& contents);
+
+ private:
+  std::size_t tapesCnt_;
+  std::size_t initialBlockSize_;
+  Plan_ plan_;
+  TmpTapesManager<T> tapesManager_;
+};
+
+using PolyphaseMergeSort = BasicPolyphaseMergeSort<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicPolyphaseMergeSort<T>::InvalidTapesCnt::InvalidTapesCnt(
+    std::size_t tapesCnt)
+    : std::invalid_argument(generateMessage_(tapesCnt)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::string BasicPolyphaseMergeSort<T>::InvalidTapesCnt::generateMessage_(
+    std::size_t tapesCnt) {
+  std::stringstream messageStream;
+  messageStream << "Polyphase merge sort needs at least three tapes, got "
+                << tapesCnt << ".";
+  return messageStream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicPolyphaseMergeSort<T>::BasicPolyphaseMergeSort(
+    TapePool& tapePool, std::string_view inFilename,
+    std::string_view tmpDirectory, bool increasing, std::size_t tapesCnt,
+    std::size_t initialBlockSize)
+    : TapeSortBase<T>(tapePool, inFilename, increasing),
+      tapesCnt_{tapesCnt < 3 ? throw InvalidTapesCnt(tapesCnt) : tapesCnt},
+      initialBlockSize_{initialBlockSize == 0
+                            ? throw std::invalid_argument(
+                                  "Initial block size can not be zero.")
+                            : initialBlockSize},
+      plan_{makePlan_()},
+      tapesManager_(tapePool, tmpDirectory, calcTmpTapesSizes_()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicPolyphaseMergeSort<T>::perform(std::string_view outFilename) && {
+  auto inTape = this->getInTape_();
+  auto outTape = this->createOutTape_(inTape, outFilename);
+
+  if (this->elementsCnt_ == 0 || this->copyIfSorted_(inTape, outTape)) {
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  if (this->elementsCnt_ <= initialBlockSize_) {
+    auto read = BasicRightReadIterator<T>(inTape);
+    auto write = BasicRightWriteIterator<T>(outTape);
+    if (this->increasing_) {
+      copy_top_elements_sorted(read, write, this->elementsCnt_);
+    } else {
+      copy_bottom_elements_sorted(read, write, this->elementsCnt_);
+    }
+    this->closeSortedOutTape_(outTape);
+    return;
+  }
+
+  auto tapes = std::vector<TapeViewT*>(tapesCnt_);
+  for (std::size_t i = 0, tmpIdx = 0; i < tapesCnt_; ++i) {
+    tapes[i] = (i == plan_.finalTape) ? &outTape
+                                      : &tapesManager_.getTape(tmpIdx++);
+  }
+  auto contents = std::vector<std::size_t>(tapesCnt_);
+  distributeRuns_(inTape, tapes, contents);
+  auto stacks = plan_.initialStacks;
+  for (const auto& merge : plan_.merges) {
+    mergeRuns_(merge, tapes, stacks, contents);
+  }
+  this->closeSortedOutTape_(outTape);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicPolyphaseMergeSort<T>::makePlan_() const -> Plan_ {
+  auto plan = Plan_{};
+  plan.capacities.resize(tapesCnt_);
+  if (this->elementsCnt_ <= initialBlockSize_) {
+    return plan;
+  }
+  const std::size_t sourcesCnt = tapesCnt_ - 1;
+  const std::size_t realRunsCnt =
+      (this->elementsCnt_ + initialBlockSize_ - 1) / initialBlockSize_;
+
+  // Perfect distribution of the smallest level fitting all runs.
+  auto counts = std::vector<std::size_t>(sourcesCnt);
+  counts[0] = 1;
+  while (std::accumulate(counts.begin(), counts.end(), std::size_t{0}) <
+         realRunsCnt) {
+    const std::size_t first = counts[0];
+    for (std::size_t i = 0; i + 1 < sourcesCnt; ++i) {
+      counts[i] = first + counts[i + 1];
+    }
+    counts.back() = first;
+  }
+
+  // Runs are dealt round robin over tapes with free places, dummy runs are
+  // put on top to be merged first.
+  auto& stacks = plan.initialStacks;
+  stacks.resize(tapesCnt_);
+  for (std::size_t runIdx = 0, tapeIdx = 0; runIdx < realRunsCnt; ++runIdx) {
+    while (stacks[tapeIdx].size() == counts[tapeIdx]) {
+      tapeIdx = (tapeIdx + 1) % sourcesCnt;
+    }
+    const std::size_t left = this->elementsCnt_ - runIdx * initialBlockSize_;
+    plan.runs.push_back({std::min(initialBlockSize_, left), {}});
+    plan.initialTapes.push_back(tapeIdx);
+    stacks[tapeIdx].push_back(runIdx);
+    plan.capacities[tapeIdx] += plan.runs.back().length;
+    tapeIdx = (tapeIdx + 1) % sourcesCnt;
+  }
+  for (std::size_t tapeIdx = 0; tapeIdx < sourcesCnt; ++tapeIdx) {
+    while (stacks[tapeIdx].size() < counts[tapeIdx]) {
+      stacks[tapeIdx].push_back(plan.runs.size());
+      plan.runs.push_back({0, {}});
+    }
+  }
+
+  auto contents = plan.capacities;
+  auto current = stacks;
+  std::size_t target = sourcesCnt;
+  for (std::size_t runsCnt = std::accumulate(counts.begin(), counts.end(),
+                                             std::size_t{0});
+       runsCnt > 1;) {
+    std::size_t mergesCnt = runsCnt;
+    for (std::size_t i = 0; i < tapesCnt_; ++i) {
+      if (i != target) {
+        mergesCnt = std::min(mergesCnt, current[i].size());
+      }
+    }
+    for (std::size_t mergeIdx = 0; mergeIdx < mergesCnt; ++mergeIdx) {
+      auto merged = Run_{0, {}};
+      for (std::size_t i = 0; i < tapesCnt_; ++i) {
+        if (i == target) {
+          continue;
+        }
+        const std::size_t source = current[i].back();
+        current[i].pop_back();
+        merged.length += plan.runs[source].length;
+        merged.sources.push_back(source);
+        contents[i] -= plan.runs[source].length;
+      }
+      contents[target] += merged.length;
+      plan.capacities[target] =
+          std::max(plan.capacities[target], contents[target]);
+      current[target].push_back(plan.runs.size());
+      plan.merges.push_back({target, plan.runs.size()});
+      plan.runs.push_back(std::move(merged));
+    }
+    runsCnt -= mergesCnt * (sourcesCnt - 1);
+    plan.finalTape = target;
+    target = static_cast<std::size_t>(
+        std::find_if(current.begin(), current.end(),
+                     [](const auto& runs) { return runs.empty(); }) -
+        current.begin());
+  }
+
+  // The last run is written in the requested order. Runs are read left, so
+  // sources of a merge are written in the order opposite to the merged one.
+  plan.runs.back().increasing = this->increasing_;
+  for (auto run = plan.runs.rbegin(); run != plan.runs.rend(); ++run) {
+    for (const std::size_t source : run->sources) {
+      plan.runs[source].increasing = !run->increasing;
+    }
+  }
+  return plan;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+std::vector<std::size_t> BasicPolyphaseMergeSort<T>::calcTmpTapesSizes_()
+    const {
+  auto sizes = std::vector<std::size_t>{};
+  for (std::size_t i = 0; i < tapesCnt_; ++i) {
+    if (i != plan_.finalTape) {
+      sizes.push_back(plan_.capacities[i]);
+    }
+  }
+  return sizes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicPolyphaseMergeSort<T>::distributeRuns_(
+    TapeViewT& in, const std::vector<TapeViewT*>& tapes,
+    std::vector<std::size_t>& contents) {
+  auto read = BasicRightReadIterator<T>(in);
+  for (std::size_t runIdx = 0; runIdx < plan_.initialTapes.size(); ++runIdx) {
+    const std::size_t tapeIdx = plan_.initialTapes[runIdx];
+    const auto& run = plan_.runs[runIdx];
+    auto& tape = *tapes[tapeIdx];
+    tape.seek(contents[tapeIdx]);
+    if (runIdx != 0) {
+      ++read;
+    }
+    auto write = BasicRightWriteIterator<T>(tape);
+    if (run.increasing) {
+      copy_top_elements_sorted(read, write, run.length);
+    } else {
+      copy_bottom_elements_sorted(read, write, run.length);
+    }
+    contents[tapeIdx] += run.length;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicPolyphaseMergeSort<T>::mergeRuns_(
+    const Merge_& merge, const std::vector<TapeViewT*>& tapes,
+    std::vector<std::vector<std::size_t>>& stacks,
+    std::vector<std::size_t>& contents) {
+  auto sources = std::vector<TapeViewT*>{};
+  auto lengths = std::vector<std::size_t>{};
+  for (std::size_t i = 0; i < tapesCnt_; ++i) {
+    if (i == merge.target) {
+      continue;
+    }
+    const std::size_t length = plan_.runs[stacks[i].back()].length;
+    stacks[i].pop_back();
+    if (length == 0) {
+      continue;
+    }
+    tapes[i]->seek(contents[i] - 1);
+    contents[i] -= length;
+    sources.push_back(tapes[i]);
+    lengths.push_back(length);
+  }
+  stacks[merge.target].push_back(merge.run);
+  if (sources.empty()) {
+    return;
+  }
+
+  auto& target = *tapes[merge.target];
+  target.seek(contents[merge.target]);
+  contents[merge.target] += plan_.runs[merge.run].length;
+  const bool increasing = plan_.runs[merge.run].increasing;
+  auto write = BasicRightWriteIterator<T>(target);
+  if (sources.size() == 1) {
+    copy_n(BasicLeftReadIterator<T>(*sources[0]), lengths[0], write);
+  } else if (sources.size() == 2 && increasing) {
+    merge_increasing(BasicLeftReadIterator<T>(*sources[0]), lengths[0],
+                     BasicLeftReadIterator<T>(*sources[1]), lengths[1],
+                     write);
+  } else if (sources.size() == 2) {
+    merge_decreasing(BasicLeftReadIterator<T>(*sources[0]), lengths[0],
+                     BasicLeftReadIterator<T>(*sources[1]), lengths[1],
+                     write);
+  } else if (increasing) {
+    merge_runs<std::less<>>(sources, lengths, target);
+  } else {
+    merge_runs<std::greater<>>(sources, lengths, target);
+  }
+}
+
+extern template class BasicPolyphaseMergeSort<std::int32_t>;
+extern template class BasicPolyphaseMergeSort<std::int64_t>;
+extern template class BasicPolyphaseMergeSort<std::uint64_t>;
+extern template class BasicPolyphaseMergeSort<float>;
+extern template class BasicPolyphaseMergeSort<double>;
+
+#endif  // TAPE_SIMULATION_POLYPHASE_MERGE_SORT_HPP
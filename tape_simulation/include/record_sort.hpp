@@ -0,0 +1,199 @@
+#ifndef TAPE_SIMULATION_RECORD_SORT_HPP
+#define TAPE_SIMULATION_RECORD_SORT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "improved_merge_sort.hpp"
+#include "keyed_record.hpp"
+#include "tape_pool.hpp"
+#include "tape_view_read_iterators.hpp"
+#include "tape_view_write_iterators.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief enum class RecordSortStrategy - how records are moved while sorting.
+enum class RecordSortStrategy {
+  FullRecords,  ///< Whole records go through every merge pass.
+  TagSort       ///< (key, index) tags are merged, payloads are gathered once.
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class RecordSort - sort of a tape of keyed records by key.
+template <std::size_t PayloadSize>
+class RecordSort {
+ public:
+  using Record = KeyedRecord<PayloadSize>;
+
+ public:
+  /**
+   * @brief RecordSort constructor.
+   *
+   * @param tapePool pool of tapes.
+   * @param inFilename tape of records to sort.
+   * @param tmpDirectory directory of temporary tapes.
+   * @param increasing sort order.
+   * @param memoryLimit bytes of elements sorted in memory at once. Initial
+   * blocks of tags are longer than ones of records for the same limit.
+   */
+  RecordSort(TapePool& tapePool, std::string_view inFilename,
+             std::string_view tmpDirectory, bool increasing,
+             std::size_t memoryLimit);
+
+  /**
+   * @brief Sort records into a new tape.
+   *
+   * @param outFilename output tape filename.
+   * @param strategy way records are moved.
+   */
+  void perform(std::string_view outFilename, RecordSortStrategy strategy) &&;
+
+ private:
+  void performFullRecords_(std::string_view outFilename) const;
+
+  void performTagSort_(std::string_view outFilename) const;
+
+  static void writeTags_(BasicTapeView<Record>& inTape,
+                         BasicTapeView<RecordTag>& tagsTape);
+
+  static void gatherRecords_(BasicTapeView<Record>& inTape,
+                             BasicTapeView<RecordTag>& sortedTagsTape,
+                             BasicTapeView<Record>& outTape);
+
+ private:
+  TapePool* tapePool_;
+  std::string inFilename_;
+  std::string tmpDirectory_;
+  bool increasing_;
+  std::size_t memoryLimit_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t PayloadSize>
+RecordSort<PayloadSize>::RecordSort(TapePool& tapePool,
+                                    std::string_view inFilename,
+                                    std::string_view tmpDirectory,
+                                    bool increasing, std::size_t memoryLimit)
+    : tapePool_{&tapePool},
+      inFilename_{inFilename},
+      tmpDirectory_{tmpDirectory},
+      increasing_{increasing},
+      memoryLimit_{memoryLimit} {
+  if (memoryLimit_ < sizeof(Record)) {
+    std::stringstream messageStream;
+    messageStream << "Memory limit of " << memoryLimit_
+                  << " bytes does not fit a single record of " << sizeof(Record)
+                  << " bytes.";
+    throw std::invalid_argument(messageStream.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t PayloadSize>
+void RecordSort<PayloadSize>::perform(std::string_view outFilename,
+                                      RecordSortStrategy strategy) && {
+  if (strategy == RecordSortStrategy::FullRecords) {
+    performFullRecords_(outFilename);
+    return;
+  }
+  auto inTape = tapePool_->getOrOpenTape<Record>(inFilename_);
+  const auto order =
+      increasing_ ? TapeOrder::Increasing : TapeOrder::Decreasing;
+  // Nothing to gain from tags if records are not merged at all.
+  if (inTape.getSize() < 2 || (inTape.getMetadata().has_value() &&
+                               inTape.getMetadata()->order == order)) {
+    performFullRecords_(outFilename);
+    return;
+  }
+  performTagSort_(outFilename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t PayloadSize>
+void RecordSort<PayloadSize>::performFullRecords_(
+    std::string_view outFilename) const {
+  BasicImprovedMergeSortImproved<Record>(*tapePool_, inFilename_,
+                                         tmpDirectory_, increasing_,
+                                         memoryLimit_ / sizeof(Record))
+      .perform(outFilename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t PayloadSize>
+void RecordSort<PayloadSize>::performTagSort_(
+    std::string_view outFilename) const {
+  const auto tagsFilename = std::string(outFilename) + "_tags";
+  const auto sortedTagsFilename = std::string(outFilename) + "_sorted_tags";
+
+  auto inTape = tapePool_->getOrOpenTape<Record>(inFilename_);
+  if (inTape.getPosition() != 0) {
+    throw std::logic_error("Input tape head is not in the beginning.");
+  }
+  {
+    auto tagsTape =
+        tapePool_->createTape<RecordTag>(tagsFilename, inTape.getSize());
+    writeTags_(inTape, tagsTape);
+  }
+
+  BasicImprovedMergeSortImproved<RecordTag>(*tapePool_, tagsFilename,
+                                            tmpDirectory_, increasing_,
+                                            memoryLimit_ / sizeof(RecordTag))
+      .perform(sortedTagsFilename);
+  // The tags sort closes its input, so the file is removed directly.
+  std::filesystem::remove(tagsFilename);
+  tapePool_->increaseRemoveCnt();
+
+  auto sortedTagsTape = tapePool_->openTape<RecordTag>(sortedTagsFilename);
+  auto outTape = tapePool_->createTape<Record>(
+      outFilename, inTape.getSize(), std::nullopt,
+      inTape.getMetadata().has_value() ? TapeFormat::WithHeader
+                                       : TapeFormat::Raw);
+  gatherRecords_(inTape, sortedTagsTape, outTape);
+  tapePool_->removeTape(sortedTagsTape.getHandle());
+
+  outTape.markSorted(increasing_ ? TapeOrder::Increasing
+                                 : TapeOrder::Decreasing);
+  tapePool_->closeTape(outTape.getHandle());
+  tapePool_->closeTape(inTape.getHandle());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t PayloadSize>
+void RecordSort<PayloadSize>::writeTags_(BasicTapeView<Record>& inTape,
+                                         BasicTapeView<RecordTag>& tagsTape) {
+  const std::size_t elementsCnt = inTape.getSize();
+  auto read = BasicRightReadIterator<Record>(inTape);
+  auto write = BasicRightWriteIterator<RecordTag>(tagsTape);
+  for (std::size_t i = 0; i < elementsCnt; ++i) {
+    *write = RecordTag{(*read).key, i};
+    if (i + 1 != elementsCnt) {
+      ++read;
+      ++write;
+    }
+  }
+  tagsTape.seek(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <std::size_t PayloadSize>
+void RecordSort<PayloadSize>::gatherRecords_(
+    BasicTapeView<Record>& inTape, BasicTapeView<RecordTag>& sortedTagsTape,
+    BasicTapeView<Record>& outTape) {
+  const std::size_t elementsCnt = inTape.getSize();
+  auto tags = BasicRightReadIterator<RecordTag>(sortedTagsTape);
+  auto write = BasicRightWriteIterator<Record>(outTape);
+  for (std::size_t i = 0; i < elementsCnt; ++i) {
+    const RecordTag tag = *tags;
+    inTape.seek(tag.index);
+    *write = inTape.read();
+    if (i + 1 != elementsCnt) {
+      ++tags;
+      ++write;
+    }
+  }
+}
+
+#endif  // TAPE_SIMULATION_RECORD_SORT_HPP
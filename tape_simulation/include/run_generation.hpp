@@ -0,0 +1,19 @@
+#ifndef TAPE_SIMULATION_RUN_GENERATION_HPP
+#define TAPE_SIMULATION_RUN_GENERATION_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief enum class RunGeneration - way of making initial runs of merge
+/// sorts.
+enum class RunGeneration {
+  /// Blocks of the initial block size sorted in memory one by one.
+  FixedBlocks,
+  /// Replacement selection with a heap of the initial block size. Runs are
+  /// about twice the heap size on random input and far longer on partially
+  /// sorted input.
+  ReplacementSelection,
+  /// Maximal increasing and decreasing runs found by a scan of the input.
+  /// Decreasing runs are reversed on write. Sorted input is copied at once.
+  NaturalRuns
+};
+
+#endif  // TAPE_SIMULATION_RUN_GENERATION_HPP
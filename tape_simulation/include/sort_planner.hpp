@@ -0,0 +1,130 @@
+#ifndef TAPE_SIMULATION_SORT_PLANNER_HPP
+#define TAPE_SIMULATION_SORT_PLANNER_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tape_pool.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class SortPlanner - predicts statistics of the available merge sorts
+/// of a tape and chooses the one of the least modelled time. Predictions are
+/// exact for fixed initial blocks of an input tape which is not opened before
+/// the sort.
+class SortPlanner {
+ public:
+  using IOStatistics = TapePool::IOStatistics;
+
+  enum class Algorithm { MergeSort, ImprovedMergeSort };
+
+  /// Time of a single operation of each kind.
+  struct OperationTimes {
+    std::size_t moveTime;
+    std::size_t readTime;
+    std::size_t writeTime;
+    std::size_t openTime;
+    std::size_t createTime;
+    std::size_t closeTime;
+    std::size_t removeTime;
+  };
+
+  struct Plan {
+    Algorithm algorithm;
+    IOStatistics statistics;
+    std::size_t time;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief class NotEnoughTapes - too few tapes for any of the sorts.
+  class NotEnoughTapes : public std::invalid_argument {
+   public:
+    explicit NotEnoughTapes(std::size_t tapesCnt);
+
+   private:
+    static std::string generateMessage_(std::size_t tapesCnt);
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief class NotAvailable - a sort can not run with the given resources.
+  class NotAvailable : public std::invalid_argument {
+   public:
+    explicit NotAvailable(Algorithm algorithm);
+
+   private:
+    static std::string generateMessage_(Algorithm algorithm);
+  };
+
+ public:
+  /// Input, output and four temporary tapes.
+  constexpr static std::size_t requiredTapesCnt = 6;
+
+ public:
+  /**
+   * @brief SortPlanner constructor.
+   *
+   * @param elementsCnt input tape size.
+   * @param memoryLimit number of elements kept in memory, the heap size limit
+   * of ImprovedMergeSortImproved. It is not available if the limit is zero.
+   * @param tapesCnt number of tapes available, including the input and the
+   * output ones.
+   * @param times operations times.
+   */
+  SortPlanner(std::size_t elementsCnt, std::size_t memoryLimit,
+              std::size_t tapesCnt, const OperationTimes& times);
+
+  /**
+   * @brief Get plans of all available sorts.
+   *
+   * @return plans in order of Algorithm values.
+   */
+  [[nodiscard]] const std::vector<Plan>& getPlans() const;
+
+  /**
+   * @brief Get the plan of a sort.
+   *
+   * @param algorithm sort algorithm.
+   * @return plan of the sort.
+   */
+  [[nodiscard]] const Plan& getPlan(Algorithm algorithm) const;
+
+  /**
+   * @brief Get the plan of the least time. MergeSort is preferred on a tie as
+   * it needs no memory.
+   *
+   * @return chosen plan.
+   */
+  [[nodiscard]] const Plan& choose() const;
+
+  /**
+   * @brief Calculate modelled time of operations. Throws std::overflow_error
+   * if it does not fit std::size_t.
+   *
+   * @param statistics operations counts.
+   * @param times operations times.
+   * @return total time.
+   */
+  [[nodiscard]] static std::size_t calcTime(const IOStatistics& statistics,
+                                            const OperationTimes& times);
+
+  /**
+   * @brief Get algorithm name for reports.
+   *
+   * @param algorithm algorithm.
+   * @return name.
+   */
+  [[nodiscard]] static std::string_view getName(Algorithm algorithm);
+
+ private:
+  [[nodiscard]] Plan makePlan_(Algorithm algorithm,
+                               std::size_t initialBlockSize) const;
+
+ private:
+  std::size_t elementsCnt_;
+  OperationTimes times_;
+  std::vector<Plan> plans_;
+};
+
+#endif  // TAPE_SIMULATION_SORT_PLANNER_HPP
@@ -2,106 +2,139 @@
 #define TAPE_SIMULATION_TAPE_HPP
 
 #include <cstdint>
-#include <fstream>
 #include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
+
+#include "tape_base.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief class Tape - tape modelling over a file.
-class Tape {
- public:
+/// \brief class BasicTape - tape of elements of type T, each element takes a
+/// single cell.
+template <class T>
+class BasicTape : public TapeBase {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Tape elements must be trivially copyable.");
 
-  //////////////////////////////////////////////////////////////////////////////
-  /// \brief class LeftOutOfRange - out of range exception
-  class RightOutOfRange : public std::out_of_range {
-   private:
-    RightOutOfRange(const std::string& filename, std::size_t position);
-    static std::string generateMessage_(const std::string& filename,
-                                        std::size_t position);
-    friend class Tape;
-  };
-
-  //////////////////////////////////////////////////////////////////////////////
-  /// \brief class LeftOutOfRange - out of range exception
-  class LeftOutOfRange : public std::out_of_range {
-   private:
-    explicit LeftOutOfRange(const std::string& filename);
-    static std::string generateMessage_(const std::string& filename);
-    friend class Tape;
-  };
+ public:
+  using ElementType = T;
 
  public:
-  constexpr static auto cellSize = sizeof(std::uint32_t);
+  constexpr static auto cellSize = sizeof(T);
 
  public:
   /**
-   * @brief Tape constructor. Tape is created from an existing file if size is
-   * given and opens a file as an exiting tape.
+   * @brief Tape constructor. Tape is created if size is given and opens a file
+   * as an exiting tape otherwise. Memory backed tapes can only be created.
+   * Header of an opened tape is detected automatically.
    *
    * @param filename tape filename.
    * @param size size of a tape.
+   * @param backendType cells storage.
+   * @param readWindowSize number of cells cached around the head for the file
+   * backend. Zero disables caching. Chunk size for the async backend and
+   * buffer size for the direct backend, zero selects the default one.
+   * @param writeBufferSize number of cells of consecutive writes coalesced
+   * before reaching the file for the file backend. Zero disables buffering.
+   * @param format layout of a created tape.
    */
-  explicit Tape(std::string_view filename,
-                std::optional<std::size_t> size = std::nullopt);
-  Tape(Tape&&) noexcept = default;
-  Tape(const Tape&) = delete;
-  Tape& operator=(Tape&&) noexcept = delete;
-  Tape& operator=(const Tape&) = delete;
-  ~Tape() = default;
+  explicit BasicTape(std::string_view filename,
+                     std::optional<std::size_t> size = std::nullopt,
+                     TapeBackendType backendType = TapeBackendType::File,
+                     std::size_t readWindowSize = defaultReadWindowSize,
+                     std::size_t writeBufferSize = defaultWriteBufferSize,
+                     TapeFormat format = TapeFormat::Raw);
 
   /**
    * @brief read cell.
    *
-   * @return std::int32_t read value.
+   * @return T read value.
    */
-  [[nodiscard]] std::int32_t read();
+  [[nodiscard]] T read();
 
   /**
    * @brief write to a current cell.
    *
    * @param x value to write.
    */
-  void write(std::int32_t x);
+  void write(const T& x);
 
   /**
-   * @brief get current head position.
+   * @brief Read cells starting from the current one in the given direction.
+   * The head stops on the last read cell.
    *
-   * @return std::size_t head position, index of a cell.
-   */
-  [[nodiscard]] std::size_t getPosition() const;
-
-  /**
-   * @brief Move head one cell left.
+   * @param values destination, its size is the number of cells to read.
+   * @param direction head travel direction.
    */
-  void moveLeft();
+  void readBlock(std::span<T> values, Direction direction);
 
   /**
-   * @brief Move head one cell right.
+   * @brief Write cells starting from the current one in the given direction.
+   * The head stops on the last written cell.
+   *
+   * @param values values to write.
+   * @param direction head travel direction.
    */
-  void moveRight();
+  void writeBlock(std::span<const T> values, Direction direction);
 
   /**
-   * @brief Get tape cells count.
+   * @brief Record in the header that cells are sorted. Min/max summary is
+   * taken from the first and the last cells of integer tapes. Does nothing
+   * for a raw tape.
    *
-   * @return std::size_t tape size.
+   * @param order cells order.
    */
-  [[nodiscard]] std::size_t getSize() const;
-
- private:
-  std::size_t position_{0};
-  std::string filename_;
-  std::size_t size_;
-  std::fstream file_;
+  void markSorted(TapeOrder order);
 };
 
+using Tape = BasicTape<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTape<T>::BasicTape(std::string_view filename,
+                        std::optional<std::size_t> size,
+                        TapeBackendType backendType, std::size_t readWindowSize,
+                        std::size_t writeBufferSize, TapeFormat format)
+    : TapeBase(filename, sizeof(T), size, backendType, readWindowSize,
+               writeBufferSize, format) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline T BasicTape<T>::read() {
+  return readAs<T>();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-inline std::size_t Tape::getPosition() const {
-  return position_;
+template <class T>
+inline void BasicTape<T>::write(const T& x) {
+  writeAs<T>(x);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline std::size_t Tape::getSize() const {
-  return size_;
+template <class T>
+inline void BasicTape<T>::readBlock(std::span<T> values, Direction direction) {
+  readBlockAs<T>(values, direction);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void BasicTape<T>::writeBlock(std::span<const T> values,
+                                     Direction direction) {
+  writeBlockAs<T>(values, direction);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void BasicTape<T>::markSorted(TapeOrder order) {
+  markSortedAs<T>(order);
+}
+
+extern template class BasicTape<std::int32_t>;
+extern template class BasicTape<std::int64_t>;
+extern template class BasicTape<std::uint64_t>;
+extern template class BasicTape<float>;
+extern template class BasicTape<double>;
+
 #endif
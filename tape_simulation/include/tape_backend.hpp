@@ -0,0 +1,132 @@
+#ifndef TAPE_SIMULATION_TAPE_BACKEND_HPP
+#define TAPE_SIMULATION_TAPE_BACKEND_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief enum class TapeBackendType - the way tape cells are stored.
+enum class TapeBackendType {
+  File,    ///< Cells are read and written through a file stream.
+  Mmap,    ///< File is mapped into memory, cells are plain loads and stores.
+  Memory,  ///< Cells live in anonymous memory, no file is touched.
+  Async,   ///< File chunks are prefetched and written behind by a thread.
+  Direct   ///< File is accessed with direct I/O bypassing the page cache.
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief enum class Direction - head travel direction.
+enum class Direction {
+  Left,
+  Right
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TapeBackend - cells storage behind a tape. Tape itself keeps
+/// the head and checks bounds, a backend only stores cells. Cells are opaque
+/// byte strings of a fixed size, element types are known only to tapes.
+class TapeBackend {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief struct CacheStatistics - read window usage and file seek
+  /// counters.
+  struct CacheStatistics {
+    std::size_t hitCnt;
+    std::size_t missCnt;
+    std::size_t seekCnt;
+  };
+
+ public:
+  /**
+   * @brief TapeBackend constructor.
+   *
+   * @param cellSize bytes count of a single cell.
+   */
+  explicit TapeBackend(std::size_t cellSize);
+  TapeBackend(const TapeBackend&) = delete;
+  TapeBackend(TapeBackend&&) noexcept = delete;
+  TapeBackend& operator=(const TapeBackend&) = delete;
+  TapeBackend& operator=(TapeBackend&&) noexcept = delete;
+  virtual ~TapeBackend() = default;
+
+  /**
+   * @brief Get cells memory if all cells are addressable. Tape then reads and
+   * writes cells directly without virtual calls.
+   *
+   * @return pointer to the first cell or nullptr.
+   */
+  [[nodiscard]] virtual std::byte* getCells();
+
+  /**
+   * @brief Get bytes count of a single cell.
+   *
+   * @return cell size.
+   */
+  [[nodiscard]] std::size_t getCellSize() const;
+
+  /**
+   * @brief Read cell.
+   *
+   * @param position cell index.
+   * @param cell destination of getCellSize() bytes.
+   */
+  virtual void read(std::size_t position, std::byte* cell) = 0;
+
+  /**
+   * @brief Write cell.
+   *
+   * @param position cell index.
+   * @param cell getCellSize() bytes to write.
+   */
+  virtual void write(std::size_t position, const std::byte* cell) = 0;
+
+  /**
+   * @brief Read consecutive cells with a single access where possible.
+   *
+   * @param begin index of the first cell.
+   * @param cells destination filled in increasing position order, its size is
+   * a multiple of the cell size.
+   */
+  virtual void readCells(std::size_t begin, std::span<std::byte> cells);
+
+  /**
+   * @brief Write consecutive cells with a single access where possible.
+   *
+   * @param begin index of the first cell.
+   * @param cells cells in increasing position order, its size is a multiple
+   * of the cell size.
+   */
+  virtual void writeCells(std::size_t begin, std::span<const std::byte> cells);
+
+  /**
+   * @brief Notify the backend about head movement. Called only for backends
+   * without addressable cells.
+   *
+   * @param position new head position.
+   * @param direction head travel direction.
+   */
+  virtual void headMoved(std::size_t position, Direction direction);
+
+  /**
+   * @brief Push written cells to the underlying storage.
+   */
+  virtual void flush();
+
+  /**
+   * @brief Get read cache hits and misses count.
+   *
+   * @return cache statistics.
+   */
+  [[nodiscard]] virtual CacheStatistics getCacheStatistics() const;
+
+ private:
+  std::size_t cellSize_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t TapeBackend::getCellSize() const {
+  return cellSize_;
+}
+
+#endif  // TAPE_SIMULATION_TAPE_BACKEND_HPP
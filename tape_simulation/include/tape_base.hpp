@@ -0,0 +1,395 @@
+#ifndef TAPE_SIMULATION_TAPE_BASE_HPP
+#define TAPE_SIMULATION_TAPE_BASE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "tape_backend.hpp"
+#include "tape_metadata.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief class TapeBase - tape modelling over a cells storage backend. Cells
+/// are of a fixed size given at runtime, typed access is done through member
+/// templates by BasicTape and BasicTapeView.
+class TapeBase {
+ public:
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief class LeftOutOfRange - out of range exception
+  class RightOutOfRange : public std::out_of_range {
+   private:
+    RightOutOfRange(const std::string& filename, std::size_t position);
+    static std::string generateMessage_(const std::string& filename,
+                                        std::size_t position);
+    friend class TapeBase;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief class LeftOutOfRange - out of range exception
+  class LeftOutOfRange : public std::out_of_range {
+   private:
+    explicit LeftOutOfRange(const std::string& filename);
+    static std::string generateMessage_(const std::string& filename);
+    friend class TapeBase;
+  };
+
+ public:
+  using CacheStatistics = TapeBackend::CacheStatistics;
+
+ public:
+  /// Default read window size in cells.
+  constexpr static std::size_t defaultReadWindowSize = 1 << 14;
+  /// Default write-back buffer size in cells.
+  constexpr static std::size_t defaultWriteBufferSize = 1 << 14;
+
+ public:
+  /**
+   * @brief TapeBase constructor. Tape is created if size is given and opens a
+   * file as an exiting tape otherwise. Memory backed tapes can only be
+   * created. Header of an opened tape is detected automatically.
+   *
+   * @param filename tape filename.
+   * @param cellSize bytes count of a single cell.
+   * @param size size of a tape.
+   * @param backendType cells storage.
+   * @param readWindowSize number of cells cached around the head for the file
+   * backend. Zero disables caching. Chunk size for the async backend and
+   * buffer size for the direct backend, zero selects the default one.
+   * @param writeBufferSize number of cells of consecutive writes coalesced
+   * before reaching the file for the file backend. Zero disables buffering.
+   * @param format layout of a created tape.
+   */
+  TapeBase(std::string_view filename, std::size_t cellSize,
+           std::optional<std::size_t> size, TapeBackendType backendType,
+           std::size_t readWindowSize, std::size_t writeBufferSize,
+           TapeFormat format);
+  TapeBase(TapeBase&&) noexcept = default;
+  TapeBase(const TapeBase&) = delete;
+  TapeBase& operator=(TapeBase&&) noexcept = delete;
+  TapeBase& operator=(const TapeBase&) = delete;
+  ~TapeBase();
+
+  /**
+   * @brief Read current cell as a value of type T.
+   *
+   * @tparam T element type, its size is the cell size.
+   * @return read value.
+   */
+  template <class T>
+  [[nodiscard]] T readAs();
+
+  /**
+   * @brief Write a value of type T to the current cell.
+   *
+   * @tparam T element type, its size is the cell size.
+   * @param x value to write.
+   */
+  template <class T>
+  void writeAs(const T& x);
+
+  /**
+   * @brief Read cells starting from the current one in the given direction.
+   * The head stops on the last read cell.
+   *
+   * @tparam T element type, its size is the cell size.
+   * @param values destination, its size is the number of cells to read.
+   * @param direction head travel direction.
+   */
+  template <class T>
+  void readBlockAs(std::span<T> values, Direction direction);
+
+  /**
+   * @brief Write cells starting from the current one in the given direction.
+   * The head stops on the last written cell.
+   *
+   * @tparam T element type, its size is the cell size.
+   * @param values values to write.
+   * @param direction head travel direction.
+   */
+  template <class T>
+  void writeBlockAs(std::span<const T> values, Direction direction);
+
+  /**
+   * @brief Record in the header that cells are sorted. Min/max summary is
+   * taken from the first and the last cells if T is an integer type fitting
+   * std::int64_t. Does nothing for a raw tape.
+   *
+   * @tparam T element type, its size is the cell size.
+   * @param order cells order.
+   */
+  template <class T>
+  void markSortedAs(TapeOrder order);
+
+  /**
+   * @brief get current head position.
+   *
+   * @return std::size_t head position, index of a cell.
+   */
+  [[nodiscard]] std::size_t getPosition() const;
+
+  /**
+   * @brief Move head one cell left.
+   */
+  void moveLeft();
+
+  /**
+   * @brief Move head one cell right.
+   */
+  void moveRight();
+
+  /**
+   * @brief Move head n cells left at once. Nothing moves if the target is out
+   * of range.
+   *
+   * @param n cells count.
+   */
+  void moveLeftRepeated(std::size_t n);
+
+  /**
+   * @brief Move head n cells right at once. Nothing moves if the target is out
+   * of range.
+   *
+   * @param n cells count.
+   */
+  void moveRightRepeated(std::size_t n);
+
+  /**
+   * @brief Move head to a cell at once.
+   *
+   * @param position target cell index.
+   */
+  void seek(std::size_t position);
+
+  /**
+   * @brief Get tape cells count.
+   *
+   * @return std::size_t tape size.
+   */
+  [[nodiscard]] std::size_t getSize() const;
+
+  /**
+   * @brief Get bytes count of a single cell.
+   *
+   * @return cell size.
+   */
+  [[nodiscard]] std::size_t getCellSize() const;
+
+  /**
+   * @brief Get read window hits and misses count.
+   *
+   * @return cache statistics.
+   */
+  [[nodiscard]] CacheStatistics getCacheStatistics() const;
+
+  /**
+   * @brief Get cells storage type.
+   *
+   * @return backend type.
+   */
+  [[nodiscard]] TapeBackendType getBackendType() const;
+
+  /**
+   * @brief Get metadata of a tape with a header.
+   *
+   * @return metadata or std::nullopt for a raw tape.
+   */
+  [[nodiscard]] const std::optional<TapeMetadata>& getMetadata() const;
+
+  /**
+   * @brief Push written cells and changed metadata to the underlying storage.
+   * Does nothing for a read head.
+   */
+  void flush();
+
+  /**
+   * @brief Check if cells can be read by another head.
+   *
+   * @return true if cells are addressable in memory.
+   */
+  [[nodiscard]] bool hasAddressableCells() const;
+
+  /**
+   * @brief Make one more head over the same cells, starting at the current
+   * position. Cells must not be written while read heads exist, the head
+   * must not outlive the tape and is not to be written through.
+   *
+   * @return read head.
+   */
+  [[nodiscard]] std::unique_ptr<TapeBase> makeReadHead() const;
+
+ private:
+  TapeBase(const TapeBase& other, std::size_t position);
+
+  std::size_t getBlockBegin_(std::size_t cellsCnt, Direction direction) const;
+  void moveTo_(std::size_t position, Direction direction);
+  void setOrder_(TapeOrder order, std::optional<std::int64_t> min,
+                 std::optional<std::int64_t> max);
+  void forgetContents_();
+  void writeHeader_();
+  static std::optional<TapeMetadata> getInitialMetadata_(
+      const std::string& filename, std::size_t cellSize,
+      std::optional<std::size_t> size, TapeBackendType backendType,
+      TapeFormat format);
+  static std::unique_ptr<TapeBackend> makeBackend_(
+      const std::string& filename, std::size_t size, std::size_t cellSize,
+      bool create, std::size_t dataOffset, TapeBackendType backendType,
+      std::size_t readWindowSize, std::size_t writeBufferSize);
+
+ private:
+  std::size_t position_{0};
+  std::string filename_;
+  std::size_t cellSize_;
+  std::optional<TapeMetadata> metadata_;
+  bool contentsKnown_;
+  bool metadataChanged_{false};
+  std::size_t size_;
+  TapeBackendType backendType_;
+  std::unique_ptr<TapeBackend> backend_;
+  std::byte* cells_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline T TapeBase::readAs() {
+  assert(sizeof(T) == cellSize_);
+  auto ret = T{};
+  if (cells_ == nullptr) {
+    backend_->read(position_, reinterpret_cast<std::byte*>(&ret));  // NOLINT
+  } else {
+    std::memcpy(&ret, cells_ + position_ * sizeof(T), sizeof(T));
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void TapeBase::writeAs(const T& x) {
+  assert(sizeof(T) == cellSize_);
+  if (contentsKnown_) {
+    forgetContents_();
+  }
+  if (cells_ == nullptr) {
+    backend_->write(position_,
+                    reinterpret_cast<const std::byte*>(&x));  // NOLINT
+    return;
+  }
+  std::memcpy(cells_ + position_ * sizeof(T), &x, sizeof(T));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void TapeBase::readBlockAs(std::span<T> values, Direction direction) {
+  assert(sizeof(T) == cellSize_);
+  if (values.empty()) {
+    return;
+  }
+  const std::size_t begin = getBlockBegin_(values.size(), direction);
+  if (cells_ == nullptr) {
+    backend_->readCells(begin, std::as_writable_bytes(values));
+  } else {
+    std::memcpy(values.data(), cells_ + begin * sizeof(T),
+                values.size() * sizeof(T));
+  }
+  if (direction == Direction::Left) {
+    std::reverse(values.begin(), values.end());
+  }
+  moveTo_((direction == Direction::Right) ? begin + values.size() - 1 : begin,
+          direction);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void TapeBase::writeBlockAs(std::span<const T> values, Direction direction) {
+  assert(sizeof(T) == cellSize_);
+  if (values.empty()) {
+    return;
+  }
+  const std::size_t begin = getBlockBegin_(values.size(), direction);
+  if (contentsKnown_) {
+    forgetContents_();
+  }
+  auto reversed = std::vector<T>();
+  if (direction == Direction::Left) {
+    reversed.assign(values.rbegin(), values.rend());
+    values = reversed;
+  }
+  if (cells_ == nullptr) {
+    backend_->writeCells(begin, std::as_bytes(values));
+  } else {
+    std::memcpy(cells_ + begin * sizeof(T), values.data(),
+                values.size() * sizeof(T));
+  }
+  moveTo_((direction == Direction::Right) ? begin + values.size() - 1 : begin,
+          direction);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void TapeBase::markSortedAs(TapeOrder order) {
+  assert(sizeof(T) == cellSize_);
+  if (!metadata_.has_value()) {
+    return;
+  }
+  auto min = std::optional<std::int64_t>{};
+  auto max = std::optional<std::int64_t>{};
+  if constexpr (std::is_integral_v<T> &&
+                (std::is_signed_v<T> || sizeof(T) < sizeof(std::int64_t))) {
+    if (size_ != 0) {
+      auto first = T{};
+      auto last = T{};
+      backend_->read(0, reinterpret_cast<std::byte*>(&first));  // NOLINT
+      backend_->read(size_ - 1,
+                     reinterpret_cast<std::byte*>(&last));  // NOLINT
+      min = static_cast<std::int64_t>(std::min(first, last));
+      max = static_cast<std::int64_t>(std::max(first, last));
+    }
+  }
+  setOrder_(order, min, max);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t TapeBase::getPosition() const {
+  return position_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t TapeBase::getSize() const {
+  return size_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t TapeBase::getCellSize() const {
+  return cellSize_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto TapeBase::getCacheStatistics() const -> CacheStatistics {
+  return backend_->getCacheStatistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline auto TapeBase::getMetadata() const
+    -> const std::optional<TapeMetadata>& {
+  return metadata_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline TapeBackendType TapeBase::getBackendType() const {
+  return backendType_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline bool TapeBase::hasAddressableCells() const {
+  return cells_ != nullptr;
+}
+
+#endif  // TAPE_SIMULATION_TAPE_BASE_HPP
@@ -0,0 +1,19 @@
+#ifndef TAPE_SIMULATION_TAPE_HANDLE_HPP
+#define TAPE_SIMULATION_TAPE_HANDLE_HPP
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief struct TapeHandle - key of a tape opened in a TapePool. A slot of a
+/// closed tape is reused by other tapes with a newer generation, so a handle
+/// of a closed tape stays invalid.
+struct TapeHandle {
+  /// Slot index in the pool.
+  std::uint32_t index;
+  /// Count of tapes closed in the slot before.
+  std::uint32_t generation;
+
+  friend bool operator==(const TapeHandle&, const TapeHandle&) = default;
+};
+
+#endif  // TAPE_SIMULATION_TAPE_HANDLE_HPP
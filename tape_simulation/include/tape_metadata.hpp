@@ -0,0 +1,35 @@
+#ifndef TAPE_SIMULATION_TAPE_METADATA_HPP
+#define TAPE_SIMULATION_TAPE_METADATA_HPP
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief enum class TapeFormat - tape file layout.
+enum class TapeFormat {
+  Raw,        ///< Cells only, size is derived from the file size.
+  WithHeader  ///< Cells follow a header with tape metadata.
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief enum class TapeOrder - known order of tape cells.
+enum class TapeOrder : std::uint8_t {
+  Unknown = 0,
+  Increasing = 1,
+  Decreasing = 2
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief struct TapeMetadata - tape description stored in a tape header.
+/// Order and min/max summary are reset by any write and are set by sorters.
+struct TapeMetadata {
+  std::uint64_t elementsCnt;
+  std::uint8_t elementWidth;
+  std::endian endianness;
+  TapeOrder order;
+  std::optional<std::int64_t> min;
+  std::optional<std::int64_t> max;
+};
+
+#endif  // TAPE_SIMULATION_TAPE_METADATA_HPP
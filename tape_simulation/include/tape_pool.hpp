@@ -1,76 +1,288 @@
 #ifndef TAPE_SIMULATION_TAPE_POOL_HPP
 #define TAPE_SIMULATION_TAPE_POOL_HPP
 
+#include <array>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "impl/tape_pool_statistics_base.hpp"
 #include "tape.hpp"
+#include "tape_handle.hpp"
 #include "tape_view.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief class TapePool - tape views fabric, which counts operations.
+/// \brief class TapePool - tape views fabric, which counts operations. Tapes
+/// of different element types may share a pool, a view of a tape must have the
+/// element size the tape was opened or created with. Tapes may be opened,
+/// used and closed from several threads, a single tape must be used by one
+/// thread at a time. Opened tapes are kept in slots and are found by a handle
+/// without a name lookup.
 class TapePool : public TapePoolStatisticsBase {
  public:
   using IOStatistics = TapePoolStatisticsBase::IOStatistics;
+  using CacheStatistics = TapeBase::CacheStatistics;
+
+  /// Tape registry shards count, each is locked on its own.
+  constexpr static std::size_t tapesShardsCnt = 16;
+
+ private:
+  /// Slot indices of opened tapes by names.
+  using Names_ = std::map<std::string, std::uint32_t, std::less<>>;
+
+  /// Opened tape or a free place for one.
+  struct Slot_ {
+    std::optional<TapeBase> tape;
+    std::uint32_t generation{0};
+    Names_::iterator nameIter;
+  };
+
+  /// Tapes with names of the same hash remainder and their lock. Slots are
+  /// never moved, so views keep pointers to their tapes.
+  struct TapesShard_ {
+    mutable std::mutex mutex;
+    Names_ names;
+    std::deque<Slot_> slots;
+    std::vector<std::uint32_t> freeSlots;
+    CacheStatistics closedTapesCacheStatistics{};
+  };
+
+  /// Tape and its handle found by a single lookup.
+  struct FoundTape_ {
+    TapeBase* tape;
+    TapeHandle handle;
+  };
 
  public:
-  TapePool() = default;
+  /**
+   * @brief TapePool constructor.
+   *
+   * @param backendType cells storage of opened tapes and of created tapes
+   * without a backend hint. Memory backed tapes can't be opened.
+   * @param tmpBackendType cells storage which sorting algorithms request for
+   * their temporary tapes.
+   * @param readWindowSize read window size of file backed tapes in cells.
+   * @param writeBufferSize write-back buffer size of file backed tapes in
+   * cells.
+   */
+  explicit TapePool(
+      TapeBackendType backendType = TapeBackendType::File,
+      TapeBackendType tmpBackendType = TapeBackendType::File,
+      std::size_t readWindowSize = TapeBase::defaultReadWindowSize,
+      std::size_t writeBufferSize = TapeBase::defaultWriteBufferSize);
 
   /**
    * @brief Open existing tape from existing file. Tape size depends on a size
    * of existing file.
    *
+   * @tparam T element type.
    * @param filename file to open.
    * @return a view to an opened tape.
    */
-  [[nodiscard]] TapeView openTape(const std::string& filename);
+  template <class T = std::int32_t>
+  [[nodiscard]] BasicTapeView<T> openTape(std::string_view filename);
 
   /**
-   * @brief Create a new tape and a file for it.
+   * @brief Create a new tape and a file for it. Memory backed tapes get no
+   * file, the filename is only a tape name then.
    *
+   * @tparam T element type.
    * @param filename file to create.
    * @param size tape size (cells count).
+   * @param backendHint cells storage of the tape. Pool backend type is used if
+   * not given.
+   * @param format raw cells or cells after a metadata header.
    * @return a view to a created tape.
    */
-  TapeView createTape(const std::string& filename, std::size_t size);
+  template <class T = std::int32_t>
+  BasicTapeView<T> createTape(
+      std::string_view filename, std::size_t size,
+      std::optional<TapeBackendType> backendHint = std::nullopt,
+      TapeFormat format = TapeFormat::Raw);
 
   /**
    * @brief Get view of an opened tape.
    *
+   * @tparam T element type.
    * @param filename name of a tape.
    * @return view to an opened tape.
    */
-  TapeView getOpenedTape(const std::string& filename);
+  template <class T = std::int32_t>
+  BasicTapeView<T> getOpenedTape(std::string_view filename);
+
+  /**
+   * @brief Get view of an opened tape by its handle.
+   *
+   * @tparam T element type.
+   * @param handle handle of an opened tape.
+   * @return view to an opened tape.
+   */
+  template <class T = std::int32_t>
+  BasicTapeView<T> getOpenedTape(TapeHandle handle);
+
+  /**
+   * @brief Find an opened tape.
+   *
+   * @param filename name of a tape.
+   * @return handle of the tape or std::nullopt if it is not opened.
+   */
+  [[nodiscard]] std::optional<TapeHandle> findTape(
+      std::string_view filename) const;
+
+  /**
+   * @brief Check if a handle is of a tape which is still opened.
+   *
+   * @param handle tape handle.
+   * @return true if the tape is opened.
+   */
+  [[nodiscard]] bool isOpened(TapeHandle handle) const;
 
   /**
    * @brief Get or open tape.
    *
+   * @tparam T element type.
    * @param filename tape filename.
    * @return tape view.
    */
-  TapeView getOrOpenTape(const std::string& filename);
+  template <class T = std::int32_t>
+  BasicTapeView<T> getOrOpenTape(std::string_view filename);
 
   /**
    * @brief Remove tape.
    *
    * @param filename tape file to remove.
    */
-  void removeTape(const std::string& filename);
+  void removeTape(std::string_view filename);
 
   /**
-   * @brief Close tape.
+   * @brief Remove tape by its handle.
+   *
+   * @param handle handle of an opened tape.
+   */
+  void removeTape(TapeHandle handle);
+
+  /**
+   * @brief Close tape. Cells and the header are flushed first, the tape stays
+   * opened if it fails.
    * 
    * @param filename tape file to close.
    */
-  void closeTape(const std::string& filename);
+  void closeTape(std::string_view filename);
+
+  /**
+   * @brief Close tape by its handle. Cells and the header are flushed first,
+   * the tape stays opened if it fails.
+   *
+   * @param handle handle of an opened tape.
+   */
+  void closeTape(TapeHandle handle);
+
+  /**
+   * @brief Get read window hits and misses of all tapes ever opened by the
+   * pool. Tapes must not be used by other threads meanwhile.
+   *
+   * @return cache statistics.
+   */
+  [[nodiscard]] CacheStatistics getCacheStatistics() const;
+
+  /**
+   * @brief Get cells storage type for opened tapes.
+   *
+   * @return opened tapes backend type.
+   */
+  [[nodiscard]] TapeBackendType getBackendType() const;
+
+  /**
+   * @brief Get cells storage type for temporary tapes.
+   *
+   * @return temporary tapes backend type.
+   */
+  [[nodiscard]] TapeBackendType getTmpBackendType() const;
 
  private:
-  std::map<std::string, Tape> tapes_;
+  FoundTape_ openTape_(std::string_view filename, std::size_t cellSize);
+  FoundTape_ createTape_(std::string_view filename, std::size_t size,
+                         std::size_t cellSize,
+                         std::optional<TapeBackendType> backendHint,
+                         TapeFormat format);
+  FoundTape_ getOpenedTape_(std::string_view filename, std::size_t cellSize);
+  FoundTape_ getOpenedTape_(TapeHandle handle, std::size_t cellSize);
+  FoundTape_ getOrOpenTape_(std::string_view filename, std::size_t cellSize);
+  [[nodiscard]] static std::size_t getShardIdx_(std::string_view filename);
+  [[nodiscard]] static TapeHandle makeHandle_(std::size_t shardIdx,
+                                              std::uint32_t slotIdx,
+                                              const Slot_& slot);
+  FoundTape_ insertTapeLocked_(std::size_t shardIdx, std::string_view filename,
+                               std::size_t cellSize,
+                               std::optional<std::size_t> size,
+                               TapeBackendType backendType, TapeFormat format);
+  [[nodiscard]] std::uint32_t findSlotLocked_(std::size_t shardIdx,
+                                              TapeHandle handle) const;
+  [[nodiscard]] static FoundTape_ checkCellSize_(std::string_view filename,
+                                                 FoundTape_ found,
+                                                 std::size_t cellSize);
+  static void eraseTapeLocked_(TapesShard_& shard, std::uint32_t slotIdx);
 
  private:
-  friend class TapeView;
+  TapeBackendType backendType_;
+  TapeBackendType tmpBackendType_;
+  std::size_t readWindowSize_;
+  std::size_t writeBufferSize_;
+  std::array<TapesShard_, tapesShardsCnt> shards_;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTapeView<T> TapePool::openTape(std::string_view filename) {
+  const auto found = openTape_(filename, sizeof(T));
+  return BasicTapeView<T>(*this, *found.tape, found.handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTapeView<T> TapePool::createTape(
+    std::string_view filename, std::size_t size,
+    std::optional<TapeBackendType> backendHint, TapeFormat format) {
+  const auto found =
+      createTape_(filename, size, sizeof(T), backendHint, format);
+  return BasicTapeView<T>(*this, *found.tape, found.handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTapeView<T> TapePool::getOpenedTape(std::string_view filename) {
+  const auto found = getOpenedTape_(filename, sizeof(T));
+  return BasicTapeView<T>(*this, *found.tape, found.handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTapeView<T> TapePool::getOpenedTape(TapeHandle handle) {
+  const auto found = getOpenedTape_(handle, sizeof(T));
+  return BasicTapeView<T>(*this, *found.tape, found.handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTapeView<T> TapePool::getOrOpenTape(std::string_view filename) {
+  const auto found = getOrOpenTape_(filename, sizeof(T));
+  return BasicTapeView<T>(*this, *found.tape, found.handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline TapeBackendType TapePool::getBackendType() const {
+  return backendType_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+inline TapeBackendType TapePool::getTmpBackendType() const {
+  return tmpBackendType_;
+}
+
 #endif  // TAPE_SIMULATION_TAPE_POOL_HPP
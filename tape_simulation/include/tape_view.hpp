@@ -2,49 +2,83 @@
 #define TAPE_SIMULATION_TAPE_VIEW_HPP
 
 #include <cstdint>
-#include <fstream>
-#include <string>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
 
+#include "impl/tape_pool_statistics_base.hpp"
 #include "tape.hpp"
+#include "tape_handle.hpp"
 
 class TapePool;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief class TapeView non-owning class for tapes control.
-class TapeView {
+/// \brief class BasicTapeView non-owning class for control of tapes of
+/// elements of type T.
+template <class T>
+class BasicTapeView {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Tape elements must be trivially copyable.");
+
+ public:
+  using ElementType = T;
+
  private:
   /**
    * @brief Constructor for calling inside TapePool.
    *
-   * @param owner pool.
+   * @param owner pool statistics.
    * @param tape tape controlled.
+   * @param handle pool handle of the tape.
    */
-  explicit TapeView(TapePool& owner, Tape& tape);
+  BasicTapeView(TapePoolStatisticsBase& owner, TapeBase& tape,
+                TapeHandle handle);
 
  public:
-  TapeView(TapeView&& other) noexcept = default;
+  BasicTapeView(BasicTapeView&& other) noexcept = default;
 
-  TapeView(const TapeView& other) = delete;
+  BasicTapeView(const BasicTapeView& other) = delete;
 
-  TapeView& operator=(TapeView&& other) noexcept = default;
+  BasicTapeView& operator=(BasicTapeView&& other) noexcept = default;
 
-  TapeView& operator=(const TapeView& other) = delete;
+  BasicTapeView& operator=(const BasicTapeView& other) = delete;
 
-  ~TapeView() = default;
+  ~BasicTapeView() = default;
 
   /**
    * @brief Read current tape and update pool statistics.
    *
-   * @return std::int32_t value read.
+   * @return T value read.
    */
-  std::int32_t read();
+  T read();
 
   /**
    * @brief Write to a current tape and update pool statistics.
    *
    * @param x value to write.
    */
-  void write(std::int32_t x);
+  void write(const T& x);
+
+  /**
+   * @brief Read cells starting from the current one in the given direction.
+   * The head stops on the last read cell. Statistics are updated as if the
+   * cells were read one by one: a read per cell and a move between cells.
+   *
+   * @param values destination, its size is the number of cells to read.
+   * @param direction head travel direction.
+   */
+  void readBlock(std::span<T> values, Direction direction);
+
+  /**
+   * @brief Write cells starting from the current one in the given direction.
+   * The head stops on the last written cell. Statistics are updated as if the
+   * cells were written one by one: a write per cell and a move between cells.
+   *
+   * @param values values to write.
+   * @param direction head travel direction.
+   */
+  void writeBlock(std::span<const T> values, Direction direction);
 
   /**
    * @brief Move head left and update pool statistics.
@@ -52,9 +86,10 @@ class TapeView {
   void moveLeft();
 
   /**
-   * @brief Move left multiple times.
-   * 
-   * @param n
+   * @brief Move left multiple times at once and update pool statistics with n
+   * moves. Nothing moves if the target is out of range.
+   *
+   * @param n moves count.
    */
   void moveLeftRepeated(std::size_t n);
 
@@ -64,12 +99,42 @@ class TapeView {
   void moveRight();
 
   /**
-   * @brief Move left multiple times.
-   * 
-   * @param n
+   * @brief Move right multiple times at once and update pool statistics with n
+   * moves. Nothing moves if the target is out of range.
+   *
+   * @param n moves count.
    */
   void moveRightRepeated(std::size_t n);
 
+  /**
+   * @brief Move head to a cell at once and update pool statistics with the
+   * number of single cell moves it takes.
+   *
+   * @param position target cell index.
+   */
+  void seek(std::size_t position);
+
+  /**
+   * @brief Write buffered cells of the tape to its file. Does not change
+   * statistics.
+   */
+  void flush();
+
+  /**
+   * @brief Get metadata from the tape header.
+   *
+   * @return metadata or std::nullopt for a raw tape.
+   */
+  [[nodiscard]] const std::optional<TapeMetadata>& getMetadata() const;
+
+  /**
+   * @brief Record in the tape header that cells are sorted. Does not change
+   * statistics.
+   *
+   * @param order cells order.
+   */
+  void markSorted(TapeOrder order);
+
   /**
    * @brief Get size of the tape.
    *
@@ -84,24 +149,211 @@ class TapeView {
    */
   [[nodiscard]] std::size_t getPosition() const;
 
+  /**
+   * @brief Check if another head can be made over the tape.
+   *
+   * @return true if makeReadHead can be called.
+   */
+  [[nodiscard]] bool canMakeReadHead() const;
+
+  /**
+   * @brief Get pool handle of the tape.
+   *
+   * @return tape handle.
+   */
+  [[nodiscard]] TapeHandle getHandle() const;
+
+  /**
+   * @brief Make a view with its own head over the same cells, starting at the
+   * current position. Operations through it are counted in other statistics.
+   * The tape must not be written while the head is used.
+   *
+   * @param owner statistics of the new view.
+   * @return read head view.
+   */
+  [[nodiscard]] BasicTapeView makeReadHead(TapePoolStatisticsBase& owner) const;
+
+  /**
+   * @brief Make a view sharing the head of this one, operations through which
+   * are counted in other statistics.
+   *
+   * @param owner statistics of the new view.
+   * @return view of the same tape.
+   */
+  [[nodiscard]] BasicTapeView countedBy(TapePoolStatisticsBase& owner) const;
+
+  /**
+   * @brief Add operations counted elsewhere, for example by views made with
+   * countedBy, to the statistics of this view.
+   *
+   * @param statistics counts to add.
+   */
+  void addStatistics(const TapePoolStatisticsBase::IOStatistics& statistics);
+
  private:
-  Tape* tape_;
-  TapePool* owner_;
-  std::size_t size_;
-  std::fstream file_;
+  TapeBase* tape_;
+  TapePoolStatisticsBase* owner_;
+  TapeHandle handle_;
+  std::unique_ptr<TapeBase> head_;
 
  private:
   friend class TapePool;
 };
 
+using TapeView = BasicTapeView<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+BasicTapeView<T>::BasicTapeView(TapePoolStatisticsBase& owner, TapeBase& tape,
+                                TapeHandle handle)
+    : tape_{&tape}, owner_{&owner}, handle_{handle} {
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-inline std::size_t TapeView::getSize() const {
+template <class T>
+inline T BasicTapeView<T>::read() {
+  owner_->increaseReadsCnt();
+  return tape_->readAs<T>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void BasicTapeView<T>::write(const T& x) {
+  owner_->increaseWritesCnt();
+  tape_->writeAs<T>(x);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::readBlock(std::span<T> values, Direction direction) {
+  if (values.empty()) {
+    return;
+  }
+  tape_->readBlockAs<T>(values, direction);
+  owner_->increaseReadsCnt(values.size());
+  owner_->increaseMovesCnt(values.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::writeBlock(std::span<const T> values,
+                                  Direction direction) {
+  if (values.empty()) {
+    return;
+  }
+  tape_->writeBlockAs<T>(values, direction);
+  owner_->increaseWritesCnt(values.size());
+  owner_->increaseMovesCnt(values.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void BasicTapeView<T>::moveLeft() {
+  tape_->moveLeft();
+  owner_->increaseMovesCnt();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::moveLeftRepeated(std::size_t n) {
+  tape_->moveLeftRepeated(n);
+  owner_->increaseMovesCnt(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline void BasicTapeView<T>::moveRight() {
+  tape_->moveRight();
+  owner_->increaseMovesCnt();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::moveRightRepeated(std::size_t n) {
+  tape_->moveRightRepeated(n);
+  owner_->increaseMovesCnt(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::seek(std::size_t position) {
+  const std::size_t current = tape_->getPosition();
+  tape_->seek(position);
+  owner_->increaseMovesCnt((position < current) ? current - position
+                                                : position - current);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::flush() {
+  tape_->flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline auto BasicTapeView<T>::getMetadata() const
+    -> const std::optional<TapeMetadata>& {
+  return tape_->getMetadata();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::markSorted(TapeOrder order) {
+  tape_->markSortedAs<T>(order);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline std::size_t BasicTapeView<T>::getSize() const {
   return tape_->getSize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-inline std::size_t TapeView::getPosition() const {
+template <class T>
+inline std::size_t BasicTapeView<T>::getPosition() const {
   return tape_->getPosition();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline bool BasicTapeView<T>::canMakeReadHead() const {
+  return tape_->hasAddressableCells();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline TapeHandle BasicTapeView<T>::getHandle() const {
+  return handle_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicTapeView<T>::makeReadHead(TapePoolStatisticsBase& owner) const
+    -> BasicTapeView {
+  auto ret = BasicTapeView(owner, *tape_, handle_);
+  ret.head_ = tape_->makeReadHead();
+  ret.tape_ = ret.head_.get();
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+auto BasicTapeView<T>::countedBy(TapePoolStatisticsBase& owner) const
+    -> BasicTapeView {
+  return BasicTapeView(owner, *tape_, handle_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void BasicTapeView<T>::addStatistics(
+    const TapePoolStatisticsBase::IOStatistics& statistics) {
+  owner_->addStatistics(statistics);
+}
+
+extern template class BasicTapeView<std::int32_t>;
+extern template class BasicTapeView<std::int64_t>;
+extern template class BasicTapeView<std::uint64_t>;
+extern template class BasicTapeView<float>;
+extern template class BasicTapeView<double>;
+
 #endif
@@ -1,44 +1,77 @@
 #ifndef TAPE_SIMULATION_READ_ITERATORS_HPP
 #define TAPE_SIMULATION_READ_ITERATORS_HPP
 
+#include <cstdint>
 #include <iterator>
 
 #include "impl/read_iterator_base.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief RightReadIterator - reading right iterator.
-class RightReadIterator : public ReadIteratorBase<RightReadIterator> {
+/// \brief BasicRightReadIterator - reading right iterator.
+template <class T>
+class BasicRightReadIterator
+    : public ReadIteratorBase<BasicRightReadIterator<T>, T> {
  public:
   using iterator_category = std::input_iterator_tag;
-  using value_type = std::int32_t;
+  using value_type = T;
   using difference_type = void;
-  using pointer = std::int32_t*;
-  using reference = std::int32_t;
+  using pointer = T*;
+  using reference = T;
 
  public:
-  using ReadIteratorBase::ReadIteratorBase;
-  using ReadIteratorBase::operator*;
-  RightReadIterator& operator++();
-  // RightReadIterator operator++(int);
+  using ReadIteratorBase<BasicRightReadIterator<T>, T>::ReadIteratorBase;
+  using ReadIteratorBase<BasicRightReadIterator<T>, T>::operator*;
+  BasicRightReadIterator& operator++();
+  // BasicRightReadIterator operator++(int);
   // Postfix increment operator is created in base class from prefix increment.
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief RightReadIterator - reading right iterator.
-class LeftReadIterator : public ReadIteratorBase<LeftReadIterator> {
+/// \brief BasicLeftReadIterator - reading left iterator.
+template <class T>
+class BasicLeftReadIterator
+    : public ReadIteratorBase<BasicLeftReadIterator<T>, T> {
  public:
   using iterator_category = std::input_iterator_tag;
-  using value_type = std::int32_t;
+  using value_type = T;
   using difference_type = void;
-  using pointer = std::int32_t*;
-  using reference = std::int32_t;
+  using pointer = T*;
+  using reference = T;
 
  public:
-  using ReadIteratorBase::ReadIteratorBase;
-  using ReadIteratorBase::operator*;
-  LeftReadIterator& operator++();
-  // LeftReadIterator operator++(int);
+  using ReadIteratorBase<BasicLeftReadIterator<T>, T>::ReadIteratorBase;
+  using ReadIteratorBase<BasicLeftReadIterator<T>, T>::operator*;
+  BasicLeftReadIterator& operator++();
+  // BasicLeftReadIterator operator++(int);
   // Postfix increment operator is created in base class from prefix increment.
 };
 
+using RightReadIterator = BasicRightReadIterator<std::int32_t>;
+using LeftReadIterator = BasicLeftReadIterator<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline BasicRightReadIterator<T>& BasicRightReadIterator<T>::operator++() {
+  this->getTapeView_().moveRight();
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline BasicLeftReadIterator<T>& BasicLeftReadIterator<T>::operator++() {
+  this->getTapeView_().moveLeft();
+  return *this;
+}
+
+extern template class BasicRightReadIterator<std::int32_t>;
+extern template class BasicRightReadIterator<std::int64_t>;
+extern template class BasicRightReadIterator<std::uint64_t>;
+extern template class BasicRightReadIterator<float>;
+extern template class BasicRightReadIterator<double>;
+extern template class BasicLeftReadIterator<std::int32_t>;
+extern template class BasicLeftReadIterator<std::int64_t>;
+extern template class BasicLeftReadIterator<std::uint64_t>;
+extern template class BasicLeftReadIterator<float>;
+extern template class BasicLeftReadIterator<double>;
+
 #endif  // TAPE_SIMULATION_READ_ITERATORS_HPP
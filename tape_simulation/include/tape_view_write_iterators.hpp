@@ -1,40 +1,76 @@
 #ifndef TAPE_SIMULATION_WRITE_ITERATORS_HPP
 #define TAPE_SIMULATION_WRITE_ITERATORS_HPP
 
+#include <cstdint>
 #include <iterator>
 
 #include "impl/write_iterator_base.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief RightWriteIterator - writing to right iterator. 
-class RightWriteIterator : public WriteIteratorBase<RightWriteIterator> {
+/// \brief BasicRightWriteIterator - writing to right iterator.
+template <class T>
+class BasicRightWriteIterator
+    : public WriteIteratorBase<BasicRightWriteIterator<T>, T> {
  public:
   using iterator_category = std::output_iterator_tag;
   using value_type = void;
   using difference_type = void;
   using pointer = void;
-  using reference = WriteIteratorBase<RightWriteIterator>::WriteRef;
+  using reference =
+      typename WriteIteratorBase<BasicRightWriteIterator<T>, T>::WriteRef;
 
  public:
-  using WriteIteratorBase::WriteIteratorBase;
-  RightWriteIterator& operator++();
-  using WriteIteratorBase::operator++; // Postfix iterator
+  using WriteIteratorBase<BasicRightWriteIterator<T>, T>::WriteIteratorBase;
+  BasicRightWriteIterator& operator++();
+  // Postfix iterator
+  using WriteIteratorBase<BasicRightWriteIterator<T>, T>::operator++;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief RightWriteIterator - writing to left iterator.
-class LeftWriteIterator : public WriteIteratorBase<LeftWriteIterator> {
+/// \brief BasicLeftWriteIterator - writing to left iterator.
+template <class T>
+class BasicLeftWriteIterator
+    : public WriteIteratorBase<BasicLeftWriteIterator<T>, T> {
  public:
   using iterator_category = std::output_iterator_tag;
   using value_type = void;
   using difference_type = void;
   using pointer = void;
-  using reference = WriteIteratorBase<LeftWriteIterator>::WriteRef;
+  using reference =
+      typename WriteIteratorBase<BasicLeftWriteIterator<T>, T>::WriteRef;
 
  public:
-  using WriteIteratorBase::WriteIteratorBase;
-  LeftWriteIterator& operator++();
-  using WriteIteratorBase::operator++;
+  using WriteIteratorBase<BasicLeftWriteIterator<T>, T>::WriteIteratorBase;
+  BasicLeftWriteIterator& operator++();
+  using WriteIteratorBase<BasicLeftWriteIterator<T>, T>::operator++;
 };
 
+using RightWriteIterator = BasicRightWriteIterator<std::int32_t>;
+using LeftWriteIterator = BasicLeftWriteIterator<std::int32_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline BasicRightWriteIterator<T>& BasicRightWriteIterator<T>::operator++() {
+  this->getTapeView_().moveRight();
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline BasicLeftWriteIterator<T>& BasicLeftWriteIterator<T>::operator++() {
+  this->getTapeView_().moveLeft();
+  return *this;
+}
+
+extern template class BasicRightWriteIterator<std::int32_t>;
+extern template class BasicRightWriteIterator<std::int64_t>;
+extern template class BasicRightWriteIterator<std::uint64_t>;
+extern template class BasicRightWriteIterator<float>;
+extern template class BasicRightWriteIterator<double>;
+extern template class BasicLeftWriteIterator<std::int32_t>;
+extern template class BasicLeftWriteIterator<std::int64_t>;
+extern template class BasicLeftWriteIterator<std::uint64_t>;
+extern template class BasicLeftWriteIterator<float>;
+extern template class BasicLeftWriteIterator<double>;
+
 #endif  // TAPE_SIMULATION_WRITE_ITERATORS_HPP
@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <impl/async_file_io.hpp>
+#include <impl/file_io.hpp>
+#include <impl/task_worker.hpp>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define TAPE_SIMULATION_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+std::system_error makeTransferError(int error, bool write,
+                                    const std::string& filename) {
+  std::stringstream messageStream;
+  messageStream << "Failed to " << (write ? "write" : "read") << " file \""
+                << filename << "\".";
+  return {error, std::generic_category(), messageStream.str()};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TaskWorker& getSharedWorker() {
+  // Workers live until the exit, files wait for their requests before.
+  static auto workers =
+      std::array<TaskWorker, PooledAsyncFileIo::threadsCnt>{};
+  static auto nextWorkerIdx = std::atomic<std::size_t>{0};
+  return workers[nextWorkerIdx.fetch_add(1, std::memory_order_relaxed) %
+                 workers.size()];
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<AsyncFileIo> makeAsyncFileIo(int fd,
+                                             const std::string& filename) {
+  try {
+    return std::make_unique<IoUringAsyncFileIo>(fd, filename);
+  } catch (const std::system_error&) {
+    // Not supported by the kernel or forbidden, e.g. by a seccomp filter.
+    return std::make_unique<PooledAsyncFileIo>(fd, filename);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledAsyncFileIo::PooledAsyncFileIo(int fd, std::string filename)
+    : fd_{fd}, filename_{std::move(filename)} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledAsyncFileIo::~PooledAsyncFileIo() {
+  // Tasks use buffers and the descriptor of the caller.
+  for (auto& [request, finished] : requests_) {
+    finished.wait();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto PooledAsyncFileIo::submitRead(std::byte* data, std::size_t bytesCnt,
+                                   std::size_t offset) -> Request {
+  return submit_(getSharedWorker().submit([this, data, bytesCnt, offset]() {
+#ifndef _WIN32
+    readFileExactly(fd_, data, bytesCnt, offset, filename_);
+#endif
+  }));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto PooledAsyncFileIo::submitWrite(const std::byte* data,
+                                    std::size_t bytesCnt, std::size_t offset)
+    -> Request {
+  return submit_(getSharedWorker().submit([this, data, bytesCnt, offset]() {
+#ifndef _WIN32
+    writeFileExactly(fd_, data, bytesCnt, offset, filename_);
+#endif
+  }));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PooledAsyncFileIo::isFinished(Request request) {
+  return requests_.at(request).wait_for(std::chrono::seconds(0)) ==
+         std::future_status::ready;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledAsyncFileIo::wait(Request request) {
+  auto finished = std::move(requests_.at(request));
+  requests_.erase(request);
+  finished.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto PooledAsyncFileIo::submit_(std::future<void> finished) -> Request {
+  const Request request = nextRequest_++;
+  requests_.emplace(request, std::move(finished));
+  return request;
+}
+
+#ifdef TAPE_SIMULATION_HAS_IO_URING
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t* getRingField(void* ring, std::uint32_t offset) {
+  return reinterpret_cast<std::uint32_t*>(  // NOLINT
+      static_cast<std::byte*>(ring) + offset);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t loadAcquire(std::uint32_t* field) {
+  return std::atomic_ref<std::uint32_t>(*field).load(std::memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void storeRelease(std::uint32_t* field, std::uint32_t value) {
+  std::atomic_ref<std::uint32_t>(*field).store(value,
+                                               std::memory_order_release);
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+IoUringAsyncFileIo::IoUringAsyncFileIo(int fd, std::string filename)
+    : fd_{fd}, filename_{std::move(filename)} {
+  auto params = io_uring_params{};
+  ringFd_ = static_cast<int>(
+      ::syscall(__NR_io_uring_setup, entriesCnt, &params));  // NOLINT
+  if (ringFd_ == -1) {
+    throwFileError("set up io_uring for", filename_);
+  }
+  // Reads and writes without vectors came with fast poll in Linux 5.7.
+  if ((params.features & IORING_FEAT_FAST_POLL) == 0) {
+    ::close(ringFd_);
+    throw std::system_error(ENOSYS, std::generic_category(),
+                            "io_uring of this kernel is too old.");
+  }
+  sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+  cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (singleMmap) {
+    sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+  }
+  sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+  const auto map = [this](std::size_t size, off_t offset) -> void* {
+    void* ret = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ringFd_, offset);
+    if (ret == MAP_FAILED) {  // NOLINT
+      const int error = errno;
+      unmap_();
+      ::close(ringFd_);
+      errno = error;
+      throwFileError("map io_uring of", filename_);
+    }
+    return ret;
+  };
+  sqRing_ = map(sqRingSize_, IORING_OFF_SQ_RING);
+  cqRing_ = singleMmap ? sqRing_ : map(cqRingSize_, IORING_OFF_CQ_RING);
+  sqes_ = map(sqesSize_, IORING_OFF_SQES);
+
+  sqHead_ = getRingField(sqRing_, params.sq_off.head);
+  sqTail_ = getRingField(sqRing_, params.sq_off.tail);
+  sqMask_ = *getRingField(sqRing_, params.sq_off.ring_mask);
+  sqArray_ = getRingField(sqRing_, params.sq_off.array);
+  cqHead_ = getRingField(cqRing_, params.cq_off.head);
+  cqTail_ = getRingField(cqRing_, params.cq_off.tail);
+  cqMask_ = *getRingField(cqRing_, params.cq_off.ring_mask);
+  cqes_ = static_cast<std::byte*>(cqRing_) + params.cq_off.cqes;  // NOLINT
+}
+
+////////////////////////////////////////////////////////////////////////////////
+IoUringAsyncFileIo::~IoUringAsyncFileIo() {
+  // The kernel uses buffers of the caller until requests complete.
+  try {
+    while (inFlightCnt_ != 0) {
+      reap_(true);
+    }
+  } catch (const std::system_error&) {
+  }
+  unmap_();
+  ::close(ringFd_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto IoUringAsyncFileIo::submitRead(std::byte* data, std::size_t bytesCnt,
+                                    std::size_t offset) -> Request {
+  const Request request = nextRequest_++;
+  const auto& transfer =
+      transfers_.emplace(request, Transfer_{false, data, bytesCnt, offset})
+          .first->second;
+  push_(request, transfer);
+  return request;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto IoUringAsyncFileIo::submitWrite(const std::byte* data,
+                                     std::size_t bytesCnt, std::size_t offset)
+    -> Request {
+  const Request request = nextRequest_++;
+  // The buffer is only read by the kernel for writes.
+  auto* buffer = const_cast<std::byte*>(data);  // NOLINT
+  const auto& transfer =
+      transfers_.emplace(request, Transfer_{true, buffer, bytesCnt, offset})
+          .first->second;
+  push_(request, transfer);
+  return request;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool IoUringAsyncFileIo::isFinished(Request request) {
+  if (!transfers_.at(request).finished) {
+    reap_(false);
+  }
+  return transfers_.at(request).finished;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::wait(Request request) {
+  while (!transfers_.at(request).finished) {
+    reap_(true);
+  }
+  const auto transfer = transfers_.at(request);
+  transfers_.erase(request);
+  if (transfer.error != 0) {
+    throw makeTransferError(transfer.error, transfer.write, filename_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::push_(Request request, const Transfer_& transfer) {
+  // Completions are reaped before the queue can overflow them.
+  while (inFlightCnt_ == entriesCnt) {
+    reap_(true);
+  }
+  const std::uint32_t tail = *sqTail_;
+  const std::uint32_t idx = tail & sqMask_;
+  auto* sqe = static_cast<io_uring_sqe*>(sqes_) + idx;  // NOLINT
+  std::memset(sqe, 0, sizeof(io_uring_sqe));
+  sqe->opcode = transfer.write ? IORING_OP_WRITE : IORING_OP_READ;
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<std::uint64_t>(transfer.data);  // NOLINT
+  sqe->len = static_cast<std::uint32_t>(
+      std::min<std::size_t>(transfer.bytesLeft, 1U << 30U));
+  sqe->off = transfer.offset;
+  sqe->user_data = request;
+  sqArray_[idx] = idx;  // NOLINT
+  storeRelease(sqTail_, tail + 1);
+  ++inFlightCnt_;
+  enter_(1, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::reap_(bool block) {
+  std::uint32_t head = *cqHead_;
+  if (block && head == loadAcquire(cqTail_)) {
+    enter_(0, 1);
+  }
+  // Completions are taken out first, resubmitting may reap again.
+  auto completions = std::vector<std::pair<Request, std::int32_t>>{};
+  for (const std::uint32_t tail = loadAcquire(cqTail_); head != tail; ++head) {
+    const auto& cqe =
+        static_cast<const io_uring_cqe*>(cqes_)[head & cqMask_];  // NOLINT
+    completions.emplace_back(cqe.user_data, cqe.res);
+  }
+  storeRelease(cqHead_, head);
+  inFlightCnt_ -= completions.size();
+  for (const auto& [request, result] : completions) {
+    complete_(request, result);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::complete_(Request request, std::int32_t result) {
+  auto& transfer = transfers_.at(request);
+  if (result == -EINTR || result == -EAGAIN) {
+    push_(request, transfer);
+    return;
+  }
+  if (result <= 0) {
+    // A read past the end of a file transfers nothing.
+    transfer.error = (result == 0) ? EIO : -result;
+    transfer.finished = true;
+    return;
+  }
+  const auto transferredCnt = static_cast<std::size_t>(result);
+  transfer.data += transferredCnt;  // NOLINT
+  transfer.offset += transferredCnt;
+  transfer.bytesLeft -= transferredCnt;
+  if (transfer.bytesLeft == 0) {
+    transfer.finished = true;
+  } else {
+    push_(request, transfer);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::enter_(std::uint32_t submitCnt,
+                                std::uint32_t waitCnt) {
+  const std::uint32_t flags = (waitCnt != 0) ? IORING_ENTER_GETEVENTS : 0;
+  while (::syscall(__NR_io_uring_enter, ringFd_, submitCnt, waitCnt,  // NOLINT
+                   flags, nullptr, 0) == -1) {
+    if (errno != EINTR) {
+      throwFileError("submit io_uring requests of", filename_);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::unmap_() noexcept {
+  if (sqes_ != nullptr) {
+    ::munmap(sqes_, sqesSize_);
+  }
+  if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+    ::munmap(cqRing_, cqRingSize_);
+  }
+  if (sqRing_ != nullptr) {
+    ::munmap(sqRing_, sqRingSize_);
+  }
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////
+IoUringAsyncFileIo::IoUringAsyncFileIo(int fd, std::string filename)
+    : fd_{fd}, filename_{std::move(filename)} {
+  throw std::system_error(ENOSYS, std::generic_category(),
+                          "io_uring is not supported on this platform.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+IoUringAsyncFileIo::~IoUringAsyncFileIo() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+auto IoUringAsyncFileIo::submitRead(std::byte* /*data*/,
+                                    std::size_t /*bytesCnt*/,
+                                    std::size_t /*offset*/) -> Request {
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto IoUringAsyncFileIo::submitWrite(const std::byte* /*data*/,
+                                     std::size_t /*bytesCnt*/,
+                                     std::size_t /*offset*/) -> Request {
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool IoUringAsyncFileIo::isFinished(Request /*request*/) {
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IoUringAsyncFileIo::wait(Request /*request*/) {
+}
+
+#endif
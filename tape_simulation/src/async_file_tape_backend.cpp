@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <impl/async_file_tape_backend.hpp>
+#include <impl/file_io.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncFileTapeBackend::AsyncFileTapeBackend(const std::string& filename,
+                                           std::size_t size,
+                                           std::size_t cellSize, bool create,
+                                           std::size_t dataOffset,
+                                           std::size_t chunkSize)
+    : TapeBackend(cellSize),
+      filename_{filename},
+      size_{size},
+      dataOffset_{dataOffset},
+      chunkSize_{chunkSize},
+      chunksCnt_{(size + chunkSize - 1) / chunkSize} {
+#ifdef _WIN32
+  throw std::runtime_error(
+      "Asynchronous file tapes are not supported on this platform.");
+#else
+  const int flags = O_RDWR | (create ? (O_CREAT | O_TRUNC) : 0);
+  fd_ = ::open(filename_.c_str(), flags, 0644);  // NOLINT
+  if (fd_ == -1) {
+    throwFileError("open", filename_);
+  }
+  if (create &&
+      ::ftruncate(fd_, static_cast<off_t>(dataOffset_ + size_ * cellSize)) ==
+          -1) {
+    ::close(fd_);
+    throwFileError("resize", filename_);
+  }
+  try {
+    io_ = makeAsyncFileIo(fd_, filename_);
+  } catch (...) {
+    ::close(fd_);
+    throw;
+  }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncFileTapeBackend::~AsyncFileTapeBackend() {
+  // Errors can't be reported from here, flush() shows them to a caller.
+  try {
+    flush();
+  } catch (const std::system_error&) {
+  }
+  // Prefetches may still fill chunks and use the descriptor.
+  io_.reset();
+#ifndef _WIN32
+  ::close(fd_);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::read(std::size_t position, std::byte* cell) {
+  const std::size_t chunkIdx = position / chunkSize_;
+  std::memcpy(cell,
+              getChunk_(chunkIdx).cells.data() +
+                  (position - chunkIdx * chunkSize_) * getCellSize(),
+              getCellSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::write(std::size_t position, const std::byte* cell) {
+  const std::size_t chunkIdx = position / chunkSize_;
+  auto& chunk = getChunk_(chunkIdx);
+  const std::size_t cellIdx = position - chunkIdx * chunkSize_;
+  std::memcpy(chunk.cells.data() + cellIdx * getCellSize(), cell,
+              getCellSize());
+  if (chunk.dirtyBegin == chunk.dirtyEnd) {
+    chunk.dirtyBegin = cellIdx;
+    chunk.dirtyEnd = cellIdx + 1;
+  } else {
+    chunk.dirtyBegin = std::min(chunk.dirtyBegin, cellIdx);
+    chunk.dirtyEnd = std::max(chunk.dirtyEnd, cellIdx + 1);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::headMoved(std::size_t position,
+                                     Direction direction) {
+  movingLeft_ = direction == Direction::Left;
+  const std::size_t chunkIdx = position / chunkSize_;
+  if (chunkIdx == headChunkIdx_) {
+    return;
+  }
+  // The head left a chunk, its written cells go to the file in background.
+  if (const auto chunkIter = chunks_.find(headChunkIdx_);
+      chunkIter != chunks_.end()) {
+    writeBehind_(headChunkIdx_, *chunkIter->second);
+  }
+  headChunkIdx_ = chunkIdx;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::flush() {
+  for (auto& [chunkIdx, chunk] : chunks_) {
+    writeBehind_(chunkIdx, *chunk);
+  }
+  // Every write is waited for before the cells are freed.
+  const auto pendingWrites = std::exchange(pendingWrites_, {});
+  std::exception_ptr error;
+  for (const auto& pendingWrite : pendingWrites) {
+    try {
+      io_->wait(pendingWrite.request);
+    } catch (const std::system_error&) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto AsyncFileTapeBackend::getChunk_(std::size_t chunkIdx) -> Chunk& {
+  if (lastChunk_ != nullptr && chunkIdx == lastChunkIdx_) {
+    return *lastChunk_;
+  }
+  // Hits and misses are counted when the head enters a chunk: a hit means
+  // the chunk was already read ahead.
+  auto chunkIter = chunks_.find(chunkIdx);
+  Chunk* chunk = nullptr;
+  if (chunkIter == chunks_.end()) {
+    ++cacheStatistics_.missCnt;
+    chunk = &loadChunk_(chunkIdx);
+  } else {
+    chunk = chunkIter->second.get();
+    const bool ready =
+        !chunk->loading.has_value() || io_->isFinished(*chunk->loading);
+    ++(ready ? cacheStatistics_.hitCnt : cacheStatistics_.missCnt);
+  }
+  if (chunk->loading.has_value()) {
+    io_->wait(*std::exchange(chunk->loading, std::nullopt));
+  }
+  lastChunk_ = chunk;
+  lastChunkIdx_ = chunkIdx;
+
+  for (std::size_t i = 1; i <= chunksAhead; ++i) {
+    if (movingLeft_ && chunkIdx >= i) {
+      prefetch_(chunkIdx - i);
+    } else if (!movingLeft_ && chunkIdx + i < chunksCnt_) {
+      prefetch_(chunkIdx + i);
+    }
+  }
+  evictFarChunks_(chunkIdx);
+  return *chunk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto AsyncFileTapeBackend::loadChunk_(std::size_t chunkIdx) -> Chunk& {
+  const std::size_t begin = chunkIdx * chunkSize_;
+  auto chunk = std::make_unique<Chunk>();
+  chunk->cells.resize(std::min(chunkSize_, size_ - begin) * getCellSize());
+  // Requests are not ordered, cells written behind must reach the file first.
+  waitChunkWrites_(chunkIdx);
+  chunk->loading = io_->submitRead(chunk->cells.data(), chunk->cells.size(),
+                                   dataOffset_ + begin * getCellSize());
+  return *chunks_.emplace(chunkIdx, std::move(chunk)).first->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::prefetch_(std::size_t chunkIdx) {
+  if (chunks_.find(chunkIdx) == chunks_.end()) {
+    loadChunk_(chunkIdx);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::evictFarChunks_(std::size_t chunkIdx) {
+  constexpr std::size_t maxChunksCnt = 2 * chunksAhead + 2;
+  while (chunks_.size() > maxChunksCnt) {
+    const auto first = chunks_.begin();
+    const auto last = std::prev(chunks_.end());
+    const auto evicted =
+        (chunkIdx - first->first > last->first - chunkIdx) ? first : last;
+    if (evicted->second->loading.has_value()) {
+      io_->wait(*std::exchange(evicted->second->loading, std::nullopt));
+    }
+    writeBehind_(evicted->first, *evicted->second);
+    if (lastChunk_ == evicted->second.get()) {
+      lastChunk_ = nullptr;
+    }
+    chunks_.erase(evicted);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::writeBehind_(std::size_t chunkIdx, Chunk& chunk) {
+  if (chunk.dirtyBegin == chunk.dirtyEnd) {
+    return;
+  }
+  checkFinishedWrites_();
+  // Requests are not ordered, an older write must not land over this one.
+  waitChunkWrites_(chunkIdx);
+  // Cells are copied, so the chunk stays usable while the write is in flight.
+  auto cells = std::vector<std::byte>(
+      chunk.cells.begin() +
+          static_cast<std::ptrdiff_t>(chunk.dirtyBegin * getCellSize()),
+      chunk.cells.begin() +
+          static_cast<std::ptrdiff_t>(chunk.dirtyEnd * getCellSize()));
+  const std::size_t offset =
+      dataOffset_ + (chunkIdx * chunkSize_ + chunk.dirtyBegin) * getCellSize();
+  // Moving the vector keeps its buffer, the request may use it.
+  const auto request = io_->submitWrite(cells.data(), cells.size(), offset);
+  pendingWrites_.push_back({chunkIdx, request, std::move(cells)});
+  chunk.dirtyBegin = 0;
+  chunk.dirtyEnd = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::checkFinishedWrites_() {
+  auto pendingIter = pendingWrites_.begin();
+  while (pendingIter != pendingWrites_.end()) {
+    if (io_->isFinished(pendingIter->request)) {
+      // The cells are kept until the request is finished.
+      const auto pendingWrite = std::move(*pendingIter);
+      pendingIter = pendingWrites_.erase(pendingIter);
+      io_->wait(pendingWrite.request);
+    } else {
+      ++pendingIter;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncFileTapeBackend::waitChunkWrites_(std::size_t chunkIdx) {
+  auto pendingIter = pendingWrites_.begin();
+  while (pendingIter != pendingWrites_.end()) {
+    if (pendingIter->chunkIdx == chunkIdx) {
+      // The cells are kept until the request is finished.
+      const auto pendingWrite = std::move(*pendingIter);
+      pendingIter = pendingWrites_.erase(pendingIter);
+      io_->wait(pendingWrite.request);
+    } else {
+      ++pendingIter;
+    }
+  }
+}
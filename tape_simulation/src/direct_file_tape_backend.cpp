@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <impl/direct_file_tape_backend.hpp>
+#include <impl/file_io.hpp>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t roundUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t getBufferBytesCnt(std::size_t bufferSize, std::size_t cellSize) {
+  // A cell crossing a block boundary needs one more block to fit whole.
+  const std::size_t minBytesCnt =
+      (DirectFileTapeBackend::blockSize % cellSize == 0)
+          ? DirectFileTapeBackend::blockSize
+          : cellSize + DirectFileTapeBackend::blockSize;
+  return roundUp(std::max(bufferSize * cellSize, minBytesCnt),
+                 DirectFileTapeBackend::blockSize);
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::FreeDeleter::operator()(std::byte* data) const {
+  std::free(data);  // NOLINT
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DirectFileTapeBackend::DirectFileTapeBackend(const std::string& filename,
+                                             std::size_t size,
+                                             std::size_t cellSize, bool create,
+                                             std::size_t dataOffset,
+                                             std::size_t bufferSize)
+    : TapeBackend(cellSize),
+      filename_{filename},
+      size_{size},
+      dataOffset_{dataOffset},
+      bufferSize_{getBufferBytesCnt(bufferSize, cellSize)},
+      buffer_{static_cast<std::byte*>(
+          std::aligned_alloc(blockSize, bufferSize_))} {
+  if (buffer_ == nullptr) {
+    throw std::bad_alloc();
+  }
+#ifdef _WIN32
+  throw std::runtime_error(
+      "Direct I/O tapes are not supported on this platform.");
+#else
+  auto flags = O_RDWR | (create ? (O_CREAT | O_TRUNC) : 0);
+#ifdef O_DIRECT
+  flags |= O_DIRECT;
+#endif
+  fd_ = ::open(filename_.c_str(), flags, 0644);  // NOLINT
+  if (fd_ == -1) {
+    throwFileError((errno == EINVAL) ? "open for direct I/O" : "open",
+                   filename_);
+  }
+#ifdef __APPLE__
+  if (::fcntl(fd_, F_NOCACHE, 1) == -1) {
+    ::close(fd_);
+    throwFileError("disable caching for", filename_);
+  }
+#endif
+  // Files being opened are never resized: the final partial block is read
+  // short and written without direct I/O.
+  if (create) {
+    const auto bytesCnt =
+        static_cast<off_t>(dataOffset_ + size_ * getCellSize());
+    if (::ftruncate(fd_, bytesCnt) == -1) {
+      ::close(fd_);
+      throwFileError("resize", filename_);
+    }
+  }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DirectFileTapeBackend::~DirectFileTapeBackend() {
+#ifndef _WIN32
+  // Errors can't be reported from here, flush() shows them to a caller.
+  try {
+    writeBack_();
+  } catch (const std::system_error&) {
+  }
+  ::close(fd_);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::read(std::size_t position, std::byte* cell) {
+  std::memcpy(cell, getCell_(position), getCellSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::write(std::size_t position, const std::byte* cell) {
+  std::memcpy(getCell_(position), cell, getCellSize());
+  const std::size_t cellBegin = position * getCellSize();
+  const std::size_t cellEnd = cellBegin + getCellSize();
+  if (dirtyBegin_ == dirtyEnd_) {
+    dirtyBegin_ = cellBegin;
+    dirtyEnd_ = cellEnd;
+  } else {
+    dirtyBegin_ = std::min(dirtyBegin_, cellBegin);
+    dirtyEnd_ = std::max(dirtyEnd_, cellEnd);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::headMoved(std::size_t /*position*/,
+                                      Direction direction) {
+  movingLeft_ = direction == Direction::Left;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::flush() {
+  writeBack_();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::byte* DirectFileTapeBackend::getCell_(std::size_t position) {
+  const std::size_t cellBegin = position * getCellSize();
+  if (cellBegin < bufferBegin_ ||
+      cellBegin + getCellSize() > bufferBegin_ + bufferLength_) {
+    ++cacheStatistics_.missCnt;
+    load_(position);
+  } else {
+    ++cacheStatistics_.hitCnt;
+  }
+  return buffer_.get() + (cellBegin - bufferBegin_);  // NOLINT
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::load_(std::size_t position) {
+  writeBack_();
+  // The buffer is placed ahead of the head in its travel direction. Both ends
+  // stay on block boundaries.
+  const std::size_t cellBegin = position * getCellSize();
+  auto begin = std::size_t{0};
+  if (movingLeft_) {
+    const std::size_t end = roundUp(cellBegin + getCellSize(), blockSize);
+    begin = (end > bufferSize_) ? end - bufferSize_ : 0;
+  } else {
+    begin = cellBegin / blockSize * blockSize;
+  }
+  const std::size_t length =
+      std::min(begin + bufferSize_, size_ * getCellSize()) - begin;
+#ifndef _WIN32
+  // The final block may be partial, the rest of the buffer is not used.
+  readFileAtLeast(fd_, buffer_.get(), roundUp(length, blockSize), length,
+                  dataOffset_ + begin, filename_);
+#endif
+  bufferBegin_ = begin;
+  bufferLength_ = length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::writeBack_() {
+  if (dirtyBegin_ == dirtyEnd_) {
+    return;
+  }
+  const std::size_t begin = dirtyBegin_ / blockSize * blockSize;
+  const std::size_t end =
+      std::min(roundUp(dirtyEnd_, blockSize), bufferBegin_ + bufferLength_);
+  const std::size_t alignedEnd = std::max(begin, end / blockSize * blockSize);
+  dirtyBegin_ = 0;
+  dirtyEnd_ = 0;
+#ifndef _WIN32
+  if (alignedEnd != begin) {
+    writeFileExactly(fd_, buffer_.get() + (begin - bufferBegin_),  // NOLINT
+                     alignedEnd - begin, dataOffset_ + begin, filename_);
+  }
+  if (alignedEnd != end) {
+    writeTail_(alignedEnd, end);
+  }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DirectFileTapeBackend::writeTail_(std::size_t begin, std::size_t end) {
+#ifndef _WIN32
+  // Only the final block of a tape is partial. Direct I/O can only write it
+  // whole, which would grow the file past the last cell.
+#ifdef O_DIRECT
+  const int flags = ::fcntl(fd_, F_GETFL);
+  if (flags == -1 || ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT) == -1) {
+    throwFileError("disable direct I/O for", filename_);
+  }
+  try {
+    writeFileExactly(fd_, buffer_.get() + (begin - bufferBegin_),  // NOLINT
+                     end - begin, dataOffset_ + begin, filename_);
+  } catch (const std::system_error&) {
+    ::fcntl(fd_, F_SETFL, flags);
+    throw;
+  }
+  if (::fcntl(fd_, F_SETFL, flags) == -1) {
+    throwFileError("enable direct I/O for", filename_);
+  }
+#else
+  writeFileExactly(fd_, buffer_.get() + (begin - bufferBegin_),  // NOLINT
+                   end - begin, dataOffset_ + begin, filename_);
+#endif
+#endif
+}
@@ -0,0 +1,73 @@
+#include <cerrno>
+#include <impl/file_io.hpp>
+#include <sstream>
+#include <system_error>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+void throwFileError(const std::string& action, const std::string& filename) {
+  std::stringstream messageStream;
+  messageStream << "Failed to " << action << " file \"" << filename << "\".";
+  throw std::system_error(errno, std::generic_category(), messageStream.str());
+}
+
+#ifndef _WIN32
+
+////////////////////////////////////////////////////////////////////////////////
+void readFileExactly(int fd, void* data, std::size_t bytesCnt,
+                     std::size_t offset, const std::string& filename) {
+  readFileAtLeast(fd, data, bytesCnt, bytesCnt, offset, filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t readFileAtLeast(int fd, void* data, std::size_t bytesCnt,
+                            std::size_t minBytesCnt, std::size_t offset,
+                            const std::string& filename) {
+  auto* bytes = static_cast<char*>(data);
+  std::size_t totalCnt = 0;
+  while (totalCnt < minBytesCnt) {
+    const auto readCnt = ::pread(fd, bytes, bytesCnt - totalCnt,
+                                 static_cast<off_t>(offset));
+    if (readCnt == -1 && errno == EINTR) {
+      continue;
+    }
+    if (readCnt == 0) {
+      // pread does not set errno at the end of a file.
+      std::stringstream messageStream;
+      messageStream << "Unexpected end of file \"" << filename << "\".";
+      throw std::system_error(EIO, std::generic_category(),
+                              messageStream.str());
+    }
+    if (readCnt == -1) {
+      throwFileError("read", filename);
+    }
+    bytes += readCnt;  // NOLINT
+    totalCnt += static_cast<std::size_t>(readCnt);
+    offset += static_cast<std::size_t>(readCnt);
+  }
+  return totalCnt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void writeFileExactly(int fd, const void* data, std::size_t bytesCnt,
+                      std::size_t offset, const std::string& filename) {
+  const auto* bytes = static_cast<const char*>(data);
+  while (bytesCnt != 0) {
+    const auto writtenCnt =
+        ::pwrite(fd, bytes, bytesCnt, static_cast<off_t>(offset));
+    if (writtenCnt == -1 && errno == EINTR) {
+      continue;
+    }
+    if (writtenCnt <= 0) {
+      throwFileError("write", filename);
+    }
+    bytes += writtenCnt;  // NOLINT
+    bytesCnt -= static_cast<std::size_t>(writtenCnt);
+    offset += static_cast<std::size_t>(writtenCnt);
+  }
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <impl/file_tape_backend.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+FileTapeBackend::FileTapeBackend(const std::string& filename, std::size_t size,
+                                 std::size_t cellSize, bool create,
+                                 std::size_t dataOffset,
+                                 std::size_t readWindowSize,
+                                 std::size_t writeBufferSize)
+    : TapeBackend(cellSize),
+      size_{size},
+      dataOffset_{dataOffset},
+      readWindowSize_{readWindowSize},
+      writeBufferSize_{writeBufferSize} {
+  // Existing tapes are opened without `app`, otherwise every write would land
+  // at the end of the file regardless of the head position.
+  file_.open(filename, std::ios_base::in | std::ios_base::out |
+                           (create ? std::ios_base::trunc
+                                   : std::ios_base::openmode{}) |
+                           std::ios_base::binary);
+  if (create) {
+    std::filesystem::resize_file(filename, dataOffset_ + size_ * cellSize);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileTapeBackend::~FileTapeBackend() {
+  flushWriteBuffer_();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::read(std::size_t position, std::byte* cell) {
+  if (readWindowSize_ != 0) {
+    readThroughWindow_(position, cell);
+    return;
+  }
+  if (position >= dirtyBegin_ && position < dirtyEnd_) {
+    std::memcpy(cell,
+                writeBuffer_.data() + (position - writeBufferBegin_) *
+                                          getCellSize(),
+                getCellSize());
+    return;
+  }
+  readFromFile_(position, reinterpret_cast<char*>(cell), 1);  // NOLINT
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::readThroughWindow_(std::size_t position,
+                                         std::byte* cell) {
+  if (position < windowBegin_ || position >= windowBegin_ + windowLength_) {
+    ++cacheStatistics_.missCnt;
+    fillWindow_(position);
+  } else {
+    ++cacheStatistics_.hitCnt;
+  }
+  std::memcpy(cell, window_.data() + (position - windowBegin_) * getCellSize(),
+              getCellSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::fillWindow_(std::size_t position) {
+  // The window is stretched ahead of the head in its travel direction, so a
+  // sequential scan either way misses once per window.
+  const std::size_t alignment = std::min(readWindowSize_, readWindowAlignment);
+  auto begin = std::size_t{0};
+  if (movingLeft_) {
+    const std::size_t end =
+        std::min((position / alignment + 1) * alignment, size_);
+    begin = (end > readWindowSize_) ? end - readWindowSize_ : 0;
+  } else {
+    begin = position / alignment * alignment;
+  }
+  const std::size_t length = std::min(begin + readWindowSize_, size_) - begin;
+  flushWriteBuffer_();
+  window_.resize(readWindowSize_ * getCellSize());
+  readFromFile_(begin, reinterpret_cast<char*>(window_.data()),  // NOLINT
+                length);
+  windowBegin_ = begin;
+  windowLength_ = length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::write(std::size_t position, const std::byte* cell) {
+  if (position >= windowBegin_ && position < windowBegin_ + windowLength_) {
+    std::memcpy(window_.data() + (position - windowBegin_) * getCellSize(),
+                cell, getCellSize());
+  }
+  if (writeBufferSize_ != 0) {
+    bufferWrite_(position, cell);
+    return;
+  }
+  writeToFile_(position, reinterpret_cast<const char*>(cell), 1);  // NOLINT
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::bufferWrite_(std::size_t position,
+                                   const std::byte* cell) {
+  const bool continuesRun = dirtyBegin_ != dirtyEnd_ &&
+                            position + 1 >= dirtyBegin_ &&
+                            position <= dirtyEnd_ &&
+                            position >= writeBufferBegin_ &&
+                            position < writeBufferBegin_ + writeBufferSize_;
+  if (!continuesRun) {
+    flushWriteBuffer_();
+    // The buffer is placed ahead of the head in its travel direction.
+    writeBufferBegin_ =
+        movingLeft_
+            ? ((position + 1 > writeBufferSize_)
+                   ? position + 1 - writeBufferSize_
+                   : 0)
+            : position;
+    dirtyBegin_ = position;
+    dirtyEnd_ = position;
+    writeBuffer_.resize(writeBufferSize_ * getCellSize());
+  }
+  std::memcpy(
+      writeBuffer_.data() + (position - writeBufferBegin_) * getCellSize(),
+      cell, getCellSize());
+  dirtyBegin_ = std::min(dirtyBegin_, position);
+  dirtyEnd_ = std::max(dirtyEnd_, position + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::readCells(std::size_t begin,
+                                std::span<std::byte> cells) {
+  // The window is kept coherent with writes, so only buffered cells need to
+  // reach the file before it is read directly.
+  flushWriteBuffer_();
+  readFromFile_(begin, reinterpret_cast<char*>(cells.data()),  // NOLINT
+                cells.size() / getCellSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::writeCells(std::size_t begin,
+                                 std::span<const std::byte> cells) {
+  const std::size_t cellsCnt = cells.size() / getCellSize();
+  flushWriteBuffer_();
+  writeToFile_(begin, reinterpret_cast<const char*>(cells.data()),  // NOLINT
+               cellsCnt);
+  const std::size_t overlapBegin = std::max(begin, windowBegin_);
+  const std::size_t overlapEnd =
+      std::min(begin + cellsCnt, windowBegin_ + windowLength_);
+  if (overlapBegin < overlapEnd) {
+    std::memcpy(window_.data() + (overlapBegin - windowBegin_) * getCellSize(),
+                cells.data() + (overlapBegin - begin) * getCellSize(),
+                (overlapEnd - overlapBegin) * getCellSize());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::headMoved(std::size_t position, Direction direction) {
+  movingLeft_ = direction == Direction::Left;
+  if (dirtyBegin_ != dirtyEnd_ &&
+      (position < writeBufferBegin_ ||
+       position >= writeBufferBegin_ + writeBufferSize_)) {
+    flushWriteBuffer_();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::flush() {
+  flushWriteBuffer_();
+  file_.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::flushWriteBuffer_() {
+  if (dirtyBegin_ == dirtyEnd_) {
+    return;
+  }
+  writeToFile_(dirtyBegin_,
+               reinterpret_cast<const char*>(  // NOLINT
+                   writeBuffer_.data() +
+                   (dirtyBegin_ - writeBufferBegin_) * getCellSize()),
+               dirtyEnd_ - dirtyBegin_);
+  dirtyBegin_ = 0;
+  dirtyEnd_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::seekTo_(std::size_t position, FileAccess access) {
+  // The stream has a single file position shared by reads and writes. Switching
+  // between reading and writing requires a seek even in place, so the access
+  // kind is tracked along with the position.
+  if (position == filePosition_ && access == lastAccess_) {
+    return;
+  }
+  ++cacheStatistics_.seekCnt;
+  const auto offset =
+      static_cast<std::ptrdiff_t>(dataOffset_ + position * getCellSize());
+  if (access == FileAccess::Read) {
+    file_.seekg(offset);
+  } else {
+    file_.seekp(offset);
+  }
+  filePosition_ = position;
+  lastAccess_ = access;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::readFromFile_(std::size_t position, char* data,
+                                    std::size_t cellsCnt) {
+  seekTo_(position, FileAccess::Read);
+  file_.read(data, static_cast<std::streamsize>(cellsCnt * getCellSize()));
+  filePosition_ += cellsCnt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTapeBackend::writeToFile_(std::size_t position, const char* data,
+                                   std::size_t cellsCnt) {
+  seekTo_(position, FileAccess::Write);
+  file_.write(data, static_cast<std::streamsize>(cellsCnt * getCellSize()));
+  filePosition_ += cellsCnt;
+}
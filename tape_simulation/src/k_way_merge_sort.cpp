@@ -0,0 +1,7 @@
+#include <k_way_merge_sort.hpp>
+
+template class BasicKWayMergeSort<std::int32_t>;
+template class BasicKWayMergeSort<std::int64_t>;
+template class BasicKWayMergeSort<std::uint64_t>;
+template class BasicKWayMergeSort<float>;
+template class BasicKWayMergeSort<double>;
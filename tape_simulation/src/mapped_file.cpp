@@ -0,0 +1,74 @@
+#include <impl/file_io.hpp>
+#include <impl/mapped_file.hpp>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string& filename, std::size_t bytesCnt,
+                       bool create)
+    : size_{bytesCnt} {
+#ifdef _WIN32
+  throw std::runtime_error(
+      "Memory mapped tapes are not supported on this platform.");
+#else
+  const int flags = O_RDWR | (create ? (O_CREAT | O_TRUNC) : 0);
+  const int fd = ::open(filename.c_str(), flags, 0644);  // NOLINT
+  if (fd == -1) {
+    throwFileError("open", filename);
+  }
+  if (create && ::ftruncate(fd, static_cast<off_t>(bytesCnt)) == -1) {
+    ::close(fd);
+    throwFileError("resize", filename);
+  }
+  if (bytesCnt != 0) {
+    void* mapped = ::mmap(nullptr, bytesCnt, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {  // NOLINT
+      ::close(fd);
+      throwFileError("map", filename);
+    }
+    data_ = static_cast<std::byte*>(mapped);
+  }
+  // Mapping stays valid after the descriptor is closed.
+  ::close(fd);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    unmap_();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::~MappedFile() {
+  unmap_();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFile::unmap_() noexcept {
+#ifndef _WIN32
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
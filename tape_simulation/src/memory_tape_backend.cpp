@@ -0,0 +1,22 @@
+#include <cstring>
+#include <impl/memory_tape_backend.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryTapeBackend::MemoryTapeBackend(std::size_t size, std::size_t cellSize)
+    : TapeBackend(cellSize), cells_(size * cellSize) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::byte* MemoryTapeBackend::getCells() {
+  return cells_.data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryTapeBackend::read(std::size_t position, std::byte* cell) {
+  std::memcpy(cell, cells_.data() + position * getCellSize(), getCellSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryTapeBackend::write(std::size_t position, const std::byte* cell) {
+  std::memcpy(cells_.data() + position * getCellSize(), cell, getCellSize());
+}
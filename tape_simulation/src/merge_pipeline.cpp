@@ -0,0 +1,40 @@
+#include <merge_pipeline.hpp>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+MergePipeline::MergePipeline(std::size_t ringCapacity,
+                             std::size_t minElementsCnt)
+    : ringCapacity_{ringCapacity}, minElementsCnt_{minElementsCnt} {
+  if (ringCapacity_ == 0) {
+    throw std::invalid_argument(
+        "Merge pipeline ring capacity can not be zero.");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MergePipeline::isWorthPipelining(std::size_t elementsCnt) const {
+  return elementsCnt >= minElementsCnt_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto MergePipeline::getStatistics() const -> Statistics {
+  const auto lock = std::lock_guard(mutex_);
+  return statistics_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t MergePipeline::getMergesCnt() const {
+  const auto lock = std::lock_guard(mutex_);
+  return mergesCnt_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MergePipeline::addStatistics_(const Statistics& statistics) {
+  const auto lock = std::lock_guard(mutex_);
+  statistics_.readerStallCnt0 += statistics.readerStallCnt0;
+  statistics_.readerStallCnt1 += statistics.readerStallCnt1;
+  statistics_.mergerInputStallCnt += statistics.mergerInputStallCnt;
+  statistics_.mergerOutputStallCnt += statistics.mergerOutputStallCnt;
+  statistics_.writerStallCnt += statistics.writerStallCnt;
+  ++mergesCnt_;
+}
@@ -66,3 +66,29 @@ auto MergeSortArithmeticsBase::calcCounts_(std::size_t blocksCnt0,
     return {blocksCnt0 * blockSize, elementsCnt_ - blocksCnt0 * blockSize};
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+auto MergeSortArithmeticsBase::calcMergedRuns_(RunsCouple_ runs)
+    -> RunsCouple_ {
+  auto merged = RunsCouple_{};
+  for (std::size_t runIdx = 0; !runs.runs0.empty(); ++runIdx) {
+    std::size_t length = runs.runs0.back();
+    runs.runs0.pop_back();
+    if (!runs.runs1.empty()) {
+      length += runs.runs1.back();
+      runs.runs1.pop_back();
+    }
+    auto& outRuns = (runIdx % 2 == 0) ? merged.runs0 : merged.runs1;
+    outRuns.push_back(length);
+  }
+  return merged;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t MergeSortArithmeticsBase::calcRunsIterationsCnt_(
+    std::size_t runsCnt) {
+  std::size_t iterationsCnt = 0;
+  for (; runsCnt > 2; runsCnt = (runsCnt + 1) / 2, ++iterationsCnt) {
+  }
+  return iterationsCnt;
+}
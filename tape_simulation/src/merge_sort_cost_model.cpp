@@ -0,0 +1,79 @@
+#include <impl/merge_sort_cost_model.hpp>
+#include <limits>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+MergeSortCostModel::MergeSortCostModel(std::size_t elementsCnt,
+                                       std::size_t initialBlockSize)
+    : MergeSortArithmeticsBase(checkSize_(elementsCnt),
+                               checkSize_(initialBlockSize)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto MergeSortCostModel::predict() const -> IOStatistics {
+  auto stats = IOStatistics{};
+  // Four temporary tapes and the output tape are created and removed or
+  // closed, the input tape is opened and closed.
+  stats.createCnt = 5;
+  stats.openCnt = 1;
+  stats.closeCnt = 2;
+  stats.removeCnt = 4;
+
+  if (elementsCnt_ == 0) {
+    return stats;
+  }
+
+  if (elementsCnt_ <= initialBlockSize_) {
+    // Sorted in memory in a single pass.
+    stats.readCnt = elementsCnt_;
+    stats.writeCnt = elementsCnt_;
+    stats.moveCnt = 2 * (elementsCnt_ - 1);
+    return stats;
+  }
+
+  // Moves are about twice as many as reads.
+  if (elementsCnt_ > std::numeric_limits<std::size_t>::max() /
+                         (2 * (iterationsCnt_ + 2))) {
+    throw std::overflow_error("Operations counts do not fit std::size_t.");
+  }
+
+  // Initial blocks, merge iterations and the last merge.
+  stats.readCnt = elementsCnt_ * (iterationsCnt_ + 2);
+  stats.writeCnt = stats.readCnt;
+
+  // Every tape is passed once in each direction, its head stays on the last
+  // cell passed.
+  stats.moveCnt = elementsCnt_ - 1 + calcMovesCnt_(calcTapesCounts_(
+                                         initialBlockSize_));
+  for (std::size_t blockSize = initialBlockSize_; blockSize < maxBlockSize_;
+       blockSize *= 2) {
+    stats.moveCnt += calcMovesCnt_(calcTapesCounts_(blockSize)) +
+                     calcMovesCnt_(calcTapesCounts_(blockSize * 2));
+  }
+  stats.moveCnt +=
+      calcMovesCnt_({maxBlockSize_, elementsCnt_ - maxBlockSize_}) +
+      elementsCnt_ - 1;
+  return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t MergeSortCostModel::checkSize_(std::size_t size) {
+  // Blocks are doubled while shorter than the input.
+  if (size > std::numeric_limits<std::size_t>::max() / 2) {
+    throw std::overflow_error("Operations counts do not fit std::size_t.");
+  }
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto MergeSortCostModel::calcTapesCounts_(std::size_t blockSize) const
+    -> Counts_ {
+  const auto [blocksCnt0, blocksCnt1] = getBlocksCnts_(blockSize);
+  return calcCounts_(blocksCnt0, blocksCnt1, blockSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t MergeSortCostModel::calcMovesCnt_(Counts_ counts) {
+  return ((counts.cnt0 == 0) ? 0 : counts.cnt0 - 1) +
+         ((counts.cnt1 == 0) ? 0 : counts.cnt1 - 1);
+}
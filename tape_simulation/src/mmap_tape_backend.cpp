@@ -0,0 +1,26 @@
+#include <cstring>
+#include <impl/mmap_tape_backend.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+MmapTapeBackend::MmapTapeBackend(const std::string& filename, std::size_t size,
+                                 std::size_t cellSize, bool create,
+                                 std::size_t dataOffset)
+    : TapeBackend(cellSize),
+      mappedFile_(filename, dataOffset + size * cellSize, create),
+      cells_{mappedFile_.data() + dataOffset} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::byte* MmapTapeBackend::getCells() {
+  return cells_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MmapTapeBackend::read(std::size_t position, std::byte* cell) {
+  std::memcpy(cell, cells_ + position * getCellSize(), getCellSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MmapTapeBackend::write(std::size_t position, const std::byte* cell) {
+  std::memcpy(cells_ + position * getCellSize(), cell, getCellSize());
+}
@@ -0,0 +1,7 @@
+#include <parallel_tape_sort.hpp>
+
+template class BasicParallelTapeSort<std::int32_t>;
+template class BasicParallelTapeSort<std::int64_t>;
+template class BasicParallelTapeSort<std::uint64_t>;
+template class BasicParallelTapeSort<float>;
+template class BasicParallelTapeSort<double>;
@@ -0,0 +1,7 @@
+#include <polyphase_merge_sort.hpp>
+
+template class BasicPolyphaseMergeSort<std::int32_t>;
+template class BasicPolyphaseMergeSort<std::int64_t>;
+template class BasicPolyphaseMergeSort<std::uint64_t>;
+template class BasicPolyphaseMergeSort<float>;
+template class BasicPolyphaseMergeSort<double>;
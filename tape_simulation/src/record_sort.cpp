@@ -0,0 +1 @@
+#include <record_sort.hpp>
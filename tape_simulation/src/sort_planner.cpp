@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <impl/merge_sort_cost_model.hpp>
+#include <limits>
+#include <sort_planner.hpp>
+#include <sstream>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t addOperationsTime(std::size_t time, std::size_t operationsCnt,
+                              std::size_t operationTime) {
+  constexpr auto maxTime = std::numeric_limits<std::size_t>::max();
+  if (operationTime != 0 && operationsCnt > (maxTime - time) / operationTime) {
+    throw std::overflow_error("Modelled time does not fit std::size_t.");
+  }
+  return time + operationsCnt * operationTime;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SortPlanner::NotEnoughTapes::NotEnoughTapes(std::size_t tapesCnt)
+    : std::invalid_argument(generateMessage_(tapesCnt)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string SortPlanner::NotEnoughTapes::generateMessage_(
+    std::size_t tapesCnt) {
+  std::stringstream messageStream;
+  messageStream << "Merge sorts need " << requiredTapesCnt
+                << " tapes, but only " << tapesCnt << " are available.";
+  return messageStream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SortPlanner::NotAvailable::NotAvailable(Algorithm algorithm)
+    : std::invalid_argument(generateMessage_(algorithm)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string SortPlanner::NotAvailable::generateMessage_(Algorithm algorithm) {
+  std::stringstream messageStream;
+  messageStream << getName(algorithm) << " is not available, "
+                << "it needs memory for at least one element.";
+  return messageStream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SortPlanner::SortPlanner(std::size_t elementsCnt, std::size_t memoryLimit,
+                         std::size_t tapesCnt, const OperationTimes& times)
+    : elementsCnt_{elementsCnt}, times_{times} {
+  if (tapesCnt < requiredTapesCnt) {
+    throw NotEnoughTapes(tapesCnt);
+  }
+  plans_.push_back(makePlan_(Algorithm::MergeSort, 1));
+  if (memoryLimit != 0) {
+    plans_.push_back(makePlan_(Algorithm::ImprovedMergeSort, memoryLimit));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto SortPlanner::getPlans() const -> const std::vector<Plan>& {
+  return plans_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto SortPlanner::getPlan(Algorithm algorithm) const -> const Plan& {
+  const auto plan =
+      std::find_if(plans_.begin(), plans_.end(), [algorithm](const Plan& plan) {
+        return plan.algorithm == algorithm;
+      });
+  if (plan == plans_.end()) {
+    throw NotAvailable(algorithm);
+  }
+  return *plan;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto SortPlanner::choose() const -> const Plan& {
+  return *std::min_element(
+      plans_.begin(), plans_.end(),
+      [](const Plan& lhs, const Plan& rhs) { return lhs.time < rhs.time; });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t SortPlanner::calcTime(const IOStatistics& statistics,
+                                  const OperationTimes& times) {
+  std::size_t time = 0;
+  time = addOperationsTime(time, statistics.moveCnt, times.moveTime);
+  time = addOperationsTime(time, statistics.readCnt, times.readTime);
+  time = addOperationsTime(time, statistics.writeCnt, times.writeTime);
+  time = addOperationsTime(time, statistics.openCnt, times.openTime);
+  time = addOperationsTime(time, statistics.createCnt, times.createTime);
+  time = addOperationsTime(time, statistics.closeCnt, times.closeTime);
+  time = addOperationsTime(time, statistics.removeCnt, times.removeTime);
+  return time;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string_view SortPlanner::getName(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::MergeSort:
+      return "MergeSort";
+    case Algorithm::ImprovedMergeSort:
+      return "ImprovedMergeSortImproved";
+  }
+  return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto SortPlanner::makePlan_(Algorithm algorithm,
+                            std::size_t initialBlockSize) const -> Plan {
+  const auto statistics =
+      MergeSortCostModel(elementsCnt_, initialBlockSize).predict();
+  return {algorithm, statistics, calcTime(statistics, times_)};
+}
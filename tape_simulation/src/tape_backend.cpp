@@ -0,0 +1,39 @@
+#include <tape_backend.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+TapeBackend::TapeBackend(std::size_t cellSize) : cellSize_{cellSize} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::byte* TapeBackend::getCells() {
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBackend::readCells(std::size_t begin, std::span<std::byte> cells) {
+  for (std::size_t i = 0; i * cellSize_ < cells.size(); ++i) {
+    read(begin + i, cells.data() + i * cellSize_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBackend::writeCells(std::size_t begin,
+                             std::span<const std::byte> cells) {
+  for (std::size_t i = 0; i * cellSize_ < cells.size(); ++i) {
+    write(begin + i, cells.data() + i * cellSize_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBackend::headMoved(std::size_t /*position*/,
+                            Direction /*direction*/) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBackend::flush() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapeBackend::getCacheStatistics() const -> CacheStatistics {
+  return {};
+}
@@ -0,0 +1,288 @@
+#include <filesystem>
+#include <impl/async_file_tape_backend.hpp>
+#include <impl/direct_file_tape_backend.hpp>
+#include <impl/file_tape_backend.hpp>
+#include <impl/memory_tape_backend.hpp>
+#include <impl/mmap_tape_backend.hpp>
+#include <impl/tape_header.hpp>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <tape_base.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+TapeBase::RightOutOfRange::RightOutOfRange(const std::string& filename,
+                                           std::size_t position)
+    : std::out_of_range(generateMessage_(filename, position)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string TapeBase::RightOutOfRange::generateMessage_(
+    const std::string& filename, std::size_t position) {
+  std::stringstream messageStream;
+  messageStream << "Trying moving right from the most right position ("
+                << position << ") in tape \"" << filename << "\".";
+  return messageStream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TapeBase::LeftOutOfRange::LeftOutOfRange(const std::string& filename)
+    : std::out_of_range(generateMessage_(filename)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string TapeBase::LeftOutOfRange::generateMessage_(
+    const std::string& filename) {
+  std::stringstream messageStream;
+  messageStream
+      << "Trying moving left from the most left position (0) in tape \""
+      << filename << "\".";
+  return messageStream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TapeBase::TapeBase(std::string_view filename, std::size_t cellSize,
+                   std::optional<std::size_t> size,
+                   TapeBackendType backendType, std::size_t readWindowSize,
+                   std::size_t writeBufferSize, TapeFormat format)
+    : filename_{filename},
+      cellSize_{cellSize},
+      metadata_{getInitialMetadata_(filename_, cellSize_, size, backendType,
+                                    format)},
+      contentsKnown_{metadata_.has_value() &&
+                     (metadata_->order != TapeOrder::Unknown ||
+                      metadata_->min.has_value())},
+      size_{size.has_value()        ? *size
+            : metadata_.has_value() ? metadata_->elementsCnt
+                                    : std::filesystem::file_size(filename_) /
+                                          cellSize_},
+      backendType_{backendType},
+      backend_{makeBackend_(
+          filename_, size_, cellSize_, size.has_value(),
+          (metadata_.has_value() && backendType != TapeBackendType::Memory)
+              ? tapeHeaderSize
+              : 0,
+          backendType, readWindowSize, writeBufferSize)},
+      cells_{backend_->getCells()} {
+  if (size.has_value() && metadata_.has_value()) {
+    writeHeader_();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TapeBase::TapeBase(const TapeBase& other, std::size_t position)
+    : position_{position},
+      filename_{other.filename_},
+      cellSize_{other.cellSize_},
+      metadata_{other.metadata_},
+      contentsKnown_{false},
+      size_{other.size_},
+      backendType_{other.backendType_},
+      cells_{other.cells_} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TapeBase::~TapeBase() {
+  // A moved-from tape has no backend and nothing to write. Errors can't be
+  // reported from here, flush() shows them to a caller.
+  if (backend_ != nullptr && metadataChanged_) {
+    try {
+      writeHeader_();
+    } catch (const std::runtime_error&) {
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::optional<TapeMetadata> TapeBase::getInitialMetadata_(
+    const std::string& filename, std::size_t cellSize,
+    std::optional<std::size_t> size, TapeBackendType backendType,
+    TapeFormat format) {
+  if (size.has_value()) {
+    if (format == TapeFormat::Raw) {
+      return std::nullopt;
+    }
+    if (cellSize > std::numeric_limits<std::uint8_t>::max()) {
+      std::stringstream messageStream;
+      messageStream << "Trying creating tape \"" << filename
+                    << "\" with a header and cells of " << cellSize
+                    << " bytes. Header can describe cells up to "
+                    << int{std::numeric_limits<std::uint8_t>::max()}
+                    << " bytes.";
+      throw std::invalid_argument(messageStream.str());
+    }
+    return TapeMetadata{*size,
+                        static_cast<std::uint8_t>(cellSize),
+                        std::endian::native,
+                        TapeOrder::Unknown,
+                        std::nullopt,
+                        std::nullopt};
+  }
+  if (backendType == TapeBackendType::Memory) {
+    std::stringstream messageStream;
+    messageStream << "Trying opening memory backed tape \"" << filename
+                  << "\". Memory backed tapes can only be created.";
+    throw std::invalid_argument(messageStream.str());
+  }
+  auto ret = readTapeHeader(filename);
+  if (ret.has_value() && ret->elementWidth != cellSize) {
+    std::stringstream messageStream;
+    messageStream << "Tape \"" << filename << "\" has elements of "
+                  << static_cast<int>(ret->elementWidth) << " bytes, expected "
+                  << cellSize << ".";
+    throw std::invalid_argument(messageStream.str());
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<TapeBackend> TapeBase::makeBackend_(
+    const std::string& filename, std::size_t size, std::size_t cellSize,
+    bool create, std::size_t dataOffset, TapeBackendType backendType,
+    std::size_t readWindowSize, std::size_t writeBufferSize) {
+  switch (backendType) {
+    case TapeBackendType::File:
+      return std::make_unique<FileTapeBackend>(filename, size, cellSize,
+                                               create, dataOffset,
+                                               readWindowSize, writeBufferSize);
+    case TapeBackendType::Mmap:
+      return std::make_unique<MmapTapeBackend>(filename, size, cellSize, create,
+                                               dataOffset);
+    case TapeBackendType::Memory:
+      return std::make_unique<MemoryTapeBackend>(size, cellSize);
+    case TapeBackendType::Async:
+      return std::make_unique<AsyncFileTapeBackend>(
+          filename, size, cellSize, create, dataOffset,
+          (readWindowSize != 0) ? readWindowSize
+                                : AsyncFileTapeBackend::defaultChunkSize);
+    case TapeBackendType::Direct:
+      return std::make_unique<DirectFileTapeBackend>(
+          filename, size, cellSize, create, dataOffset,
+          (readWindowSize != 0) ? readWindowSize : defaultReadWindowSize);
+  }
+  throw std::invalid_argument("Unknown tape backend type.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t TapeBase::getBlockBegin_(std::size_t cellsCnt,
+                                     Direction direction) const {
+  if (direction == Direction::Right) {
+    if (position_ + cellsCnt > size_) {
+      throw RightOutOfRange(filename_, size_ - 1);
+    }
+    return position_;
+  }
+  if (cellsCnt > position_ + 1) {
+    throw LeftOutOfRange(filename_);
+  }
+  return position_ + 1 - cellsCnt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::setOrder_(TapeOrder order, std::optional<std::int64_t> min,
+                         std::optional<std::int64_t> max) {
+  metadata_->order = order;
+  metadata_->min = min;
+  metadata_->max = max;
+  contentsKnown_ = true;
+  metadataChanged_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::forgetContents_() {
+  metadata_->order = TapeOrder::Unknown;
+  metadata_->min = std::nullopt;
+  metadata_->max = std::nullopt;
+  contentsKnown_ = false;
+  metadataChanged_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::writeHeader_() {
+  metadataChanged_ = false;
+  if (backendType_ != TapeBackendType::Memory) {
+    writeTapeHeader(filename_, *metadata_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::flush() {
+  if (backend_ == nullptr) {
+    return;
+  }
+  backend_->flush();
+  if (metadataChanged_) {
+    writeHeader_();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<TapeBase> TapeBase::makeReadHead() const {
+  if (cells_ == nullptr) {
+    std::stringstream messageStream;
+    messageStream << "Tape \"" << filename_
+                  << "\" cells are not addressable for another head.";
+    throw std::logic_error(messageStream.str());
+  }
+  // Private constructor is not reachable from std::make_unique.
+  return std::unique_ptr<TapeBase>(new TapeBase(*this, position_));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::moveLeft() {
+  if (position_ == 0) {
+    throw LeftOutOfRange(filename_);
+  }
+  --position_;
+  if (cells_ == nullptr) {
+    backend_->headMoved(position_, Direction::Left);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::moveRight() {
+  if (position_ + 1 == size_) {
+    throw RightOutOfRange(filename_, position_);
+  }
+  ++position_;
+  if (cells_ == nullptr) {
+    backend_->headMoved(position_, Direction::Right);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::moveLeftRepeated(std::size_t n) {
+  if (n > position_) {
+    throw LeftOutOfRange(filename_);
+  }
+  moveTo_(position_ - n, Direction::Left);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::moveRightRepeated(std::size_t n) {
+  if (n >= size_ - position_) {
+    throw RightOutOfRange(filename_, size_ - 1);
+  }
+  moveTo_(position_ + n, Direction::Right);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::seek(std::size_t position) {
+  if (position >= size_) {
+    throw RightOutOfRange(filename_, size_ - 1);
+  }
+  moveTo_(position,
+          (position < position_) ? Direction::Left : Direction::Right);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapeBase::moveTo_(std::size_t position, Direction direction) {
+  if (position == position_) {
+    return;
+  }
+  position_ = position;
+  if (cells_ == nullptr) {
+    backend_->headMoved(position_, direction);
+  }
+}
@@ -0,0 +1,114 @@
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <impl/tape_header.hpp>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Layout: magic[8], version u16, element width u8, endianness u8, order u8,
+// min/max presence u8, reserved u16, elements count u64, min i64, max i64.
+// Fields are stored in the byte order named by the endianness field.
+constexpr std::array<char, 8> magic = {'T', 'A', 'P', 'E', 'H', 'D', 'R', 0};
+constexpr std::size_t versionOffset = 8;
+constexpr std::size_t widthOffset = 10;
+constexpr std::size_t endiannessOffset = 11;
+constexpr std::size_t orderOffset = 12;
+constexpr std::size_t minMaxOffset = 13;
+constexpr std::size_t countOffset = 16;
+constexpr std::size_t minOffset = 24;
+constexpr std::size_t maxOffset = 32;
+constexpr std::size_t usedBytesCnt = 40;
+
+using HeaderBytes = std::array<char, usedBytesCnt>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+T load(const HeaderBytes& bytes, std::size_t offset) {
+  auto ret = T{};
+  std::memcpy(&ret, bytes.data() + offset, sizeof(T));
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void store(HeaderBytes& bytes, std::size_t offset, T value) {
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+[[noreturn]] void throwInvalidHeader(const std::string& filename,
+                                     std::string_view reason) {
+  std::stringstream messageStream;
+  messageStream << "Invalid header of tape \"" << filename << "\": " << reason
+                << ".";
+  throw std::runtime_error(messageStream.str());
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+std::optional<TapeMetadata> readTapeHeader(const std::string& filename) {
+  const auto fileSize = std::filesystem::file_size(filename);
+  if (fileSize < tapeHeaderSize) {
+    return std::nullopt;
+  }
+  auto bytes = HeaderBytes{};
+  auto file = std::ifstream(filename, std::ios_base::binary);
+  file.read(bytes.data(), bytes.size());
+  if (!std::equal(magic.begin(), magic.end(), bytes.begin())) {
+    return std::nullopt;
+  }
+
+  const auto endianness =
+      (bytes[endiannessOffset] == 0) ? std::endian::little : std::endian::big;
+  if (endianness != std::endian::native) {
+    throwInvalidHeader(filename, "byte order differs from the native one");
+  }
+  if (load<std::uint16_t>(bytes, versionOffset) > tapeHeaderVersion) {
+    throwInvalidHeader(filename, "unsupported version");
+  }
+  auto ret = TapeMetadata{};
+  ret.elementsCnt = load<std::uint64_t>(bytes, countOffset);
+  ret.elementWidth = static_cast<std::uint8_t>(bytes[widthOffset]);
+  ret.endianness = endianness;
+  ret.order = static_cast<TapeOrder>(bytes[orderOffset]);
+  if (bytes[minMaxOffset] != 0) {
+    ret.min = load<std::int64_t>(bytes, minOffset);
+    ret.max = load<std::int64_t>(bytes, maxOffset);
+  }
+  if (tapeHeaderSize + ret.elementsCnt * ret.elementWidth != fileSize) {
+    throwInvalidHeader(filename, "elements count does not match file size");
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void writeTapeHeader(const std::string& filename,
+                     const TapeMetadata& metadata) {
+  auto bytes = HeaderBytes{};
+  std::copy(magic.begin(), magic.end(), bytes.begin());
+  store(bytes, versionOffset, tapeHeaderVersion);
+  bytes[widthOffset] = static_cast<char>(metadata.elementWidth);
+  bytes[endiannessOffset] =
+      static_cast<char>(metadata.endianness == std::endian::little ? 0 : 1);
+  bytes[orderOffset] = static_cast<char>(metadata.order);
+  const bool hasMinMax = metadata.min.has_value() && metadata.max.has_value();
+  bytes[minMaxOffset] = static_cast<char>(hasMinMax ? 1 : 0);
+  store(bytes, countOffset, metadata.elementsCnt);
+  if (hasMinMax) {
+    store(bytes, minOffset, *metadata.min);
+    store(bytes, maxOffset, *metadata.max);
+  }
+  auto file = std::fstream(
+      filename, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+  file.write(bytes.data(), bytes.size());
+  file.flush();
+  if (!file) {
+    std::stringstream messageStream;
+    messageStream << "Failed to write header of tape \"" << filename << "\".";
+    throw std::runtime_error(messageStream.str());
+  }
+}
@@ -1,81 +1,303 @@
 #include <cassert>
 #include <filesystem>
+#include <functional>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <tape_pool.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
-TapeView TapePool::openTape(const std::string& filename) {
+TapePool::TapePool(TapeBackendType backendType, TapeBackendType tmpBackendType,
+                   std::size_t readWindowSize, std::size_t writeBufferSize)
+    : backendType_{backendType},
+      tmpBackendType_{tmpBackendType},
+      readWindowSize_{readWindowSize},
+      writeBufferSize_{writeBufferSize} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapePool::openTape_(std::string_view filename, std::size_t cellSize)
+    -> FoundTape_ {
   increaseOpenCnt();
-  if (tapes_.find(filename) != tapes_.end()) {
-    std::stringstream messageStream;
-    messageStream << "Trying opening tape(" << filename << ") twice.";
-    throw std::logic_error(messageStream.str());
-  }
-  tapes_.emplace(filename, Tape(filename));
-  return TapeView(*this, tapes_.at(filename));
+  const std::size_t shardIdx = getShardIdx_(filename);
+  const auto lock = std::lock_guard(shards_[shardIdx].mutex);
+  return insertTapeLocked_(shardIdx, filename, cellSize, std::nullopt,
+                           backendType_, TapeFormat::Raw);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-TapeView TapePool::createTape(const std::string& filename, std::size_t size) {
+auto TapePool::createTape_(std::string_view filename, std::size_t size,
+                           std::size_t cellSize,
+                           std::optional<TapeBackendType> backendHint,
+                           TapeFormat format) -> FoundTape_ {
+  const auto backendType = backendHint.value_or(backendType_);
   increaseCreateCnt();
-  if (tapes_.find(filename) != tapes_.end()) {
+  const std::size_t shardIdx = getShardIdx_(filename);
+  const auto lock = std::lock_guard(shards_[shardIdx].mutex);
+  if (shards_[shardIdx].names.contains(filename)) {
     std::stringstream messageStream;
     messageStream << "Trying creating a tape(" << filename
                   << ") which is already opened.";
     throw std::logic_error(messageStream.str());
   }
-  if (std::filesystem::exists(filename)) {
+  if (backendType != TapeBackendType::Memory &&
+      std::filesystem::exists(filename)) {
     std::stringstream messageStream;
     messageStream << "Trying creating a tape(" << filename
                   << ") with filename which already exists.";
     throw std::logic_error(messageStream.str());
   }
-  tapes_.emplace(filename, Tape(filename, size));
-  return TapeView(*this, tapes_.at(filename));
+  return insertTapeLocked_(shardIdx, filename, cellSize, size, backendType,
+                           format);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-TapeView TapePool::getOpenedTape(const std::string& filename) {
-  if (tapes_.find(filename) == tapes_.end()) {
+auto TapePool::getOpenedTape_(std::string_view filename, std::size_t cellSize)
+    -> FoundTape_ {
+  const std::size_t shardIdx = getShardIdx_(filename);
+  auto& shard = shards_[shardIdx];
+  const auto lock = std::lock_guard(shard.mutex);
+  const auto nameIter = shard.names.find(filename);
+  if (nameIter == shard.names.end()) {
     std::stringstream messageStream;
     messageStream
         << "Trying getting a view to a tape that was not opened or created yet("
         << filename << ").";
     throw std::logic_error(messageStream.str());
   }
-  return TapeView(*this, tapes_.at(filename));
+  auto& slot = shard.slots[nameIter->second];
+  return checkCellSize_(
+      filename,
+      {&*slot.tape, makeHandle_(shardIdx, nameIter->second, slot)},
+      cellSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapePool::getOpenedTape_(TapeHandle handle, std::size_t cellSize)
+    -> FoundTape_ {
+  const std::size_t shardIdx = handle.index % tapesShardsCnt;
+  auto& shard = shards_[shardIdx];
+  const auto lock = std::lock_guard(shard.mutex);
+  auto& slot = shard.slots[findSlotLocked_(shardIdx, handle)];
+  return checkCellSize_(slot.nameIter->first, {&*slot.tape, handle},
+                        cellSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapePool::getOrOpenTape_(std::string_view filename, std::size_t cellSize)
+    -> FoundTape_ {
+  const std::size_t shardIdx = getShardIdx_(filename);
+  auto& shard = shards_[shardIdx];
+  const auto lock = std::lock_guard(shard.mutex);
+  const auto nameIter = shard.names.find(filename);
+  if (nameIter != shard.names.end()) {
+    auto& slot = shard.slots[nameIter->second];
+    return checkCellSize_(
+        filename,
+        {&*slot.tape, makeHandle_(shardIdx, nameIter->second, slot)},
+        cellSize);
+  }
+  increaseOpenCnt();
+  return insertTapeLocked_(shardIdx, filename, cellSize, std::nullopt,
+                           backendType_, TapeFormat::Raw);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-TapeView TapePool::getOrOpenTape(const std::string& filename) {
-  if (tapes_.find(filename) != tapes_.end()) {
-    return TapeView(*this, tapes_.at(filename));
+std::optional<TapeHandle> TapePool::findTape(std::string_view filename) const {
+  const std::size_t shardIdx = getShardIdx_(filename);
+  const auto& shard = shards_[shardIdx];
+  const auto lock = std::lock_guard(shard.mutex);
+  const auto nameIter = shard.names.find(filename);
+  if (nameIter == shard.names.end()) {
+    return std::nullopt;
   }
-  return openTape(filename);
+  return makeHandle_(shardIdx, nameIter->second,
+                     shard.slots[nameIter->second]);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void TapePool::removeTape(const std::string& filename) {
-  if (tapes_.find(filename) == tapes_.end()) {
+bool TapePool::isOpened(TapeHandle handle) const {
+  const auto& shard = shards_[handle.index % tapesShardsCnt];
+  const auto lock = std::lock_guard(shard.mutex);
+  const std::size_t slotIdx = handle.index / tapesShardsCnt;
+  return slotIdx < shard.slots.size() &&
+         shard.slots[slotIdx].tape.has_value() &&
+         shard.slots[slotIdx].generation == handle.generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapePool::removeTape(std::string_view filename) {
+  auto& shard = shards_[getShardIdx_(filename)];
+  const auto lock = std::lock_guard(shard.mutex);
+  const auto nameIter = shard.names.find(filename);
+  if (nameIter == shard.names.end()) {
     std::stringstream messageStream;
     messageStream << "Trying removing tape (" << filename
                   << ") which is not opened." << std::endl;
     throw std::logic_error(messageStream.str());
   }
   increaseRemoveCnt();
-  tapes_.erase(filename);
-  std::filesystem::remove(filename);
+  const std::uint32_t slotIdx = nameIter->second;
+  const bool hasFile = shard.slots[slotIdx].tape->getBackendType() !=
+                       TapeBackendType::Memory;
+  eraseTapeLocked_(shard, slotIdx);
+  if (hasFile) {
+    std::filesystem::remove(filename);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapePool::removeTape(TapeHandle handle) {
+  const std::size_t shardIdx = handle.index % tapesShardsCnt;
+  auto& shard = shards_[shardIdx];
+  const auto lock = std::lock_guard(shard.mutex);
+  const std::uint32_t slotIdx = findSlotLocked_(shardIdx, handle);
+  increaseRemoveCnt();
+  auto& slot = shard.slots[slotIdx];
+  const auto path = (slot.tape->getBackendType() != TapeBackendType::Memory)
+                        ? std::optional(std::filesystem::path(
+                              slot.nameIter->first))
+                        : std::nullopt;
+  eraseTapeLocked_(shard, slotIdx);
+  if (path.has_value()) {
+    std::filesystem::remove(*path);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void TapePool::closeTape(const std::string& filename) {
-  if (tapes_.find(filename) == tapes_.end()) {
+void TapePool::closeTape(std::string_view filename) {
+  auto& shard = shards_[getShardIdx_(filename)];
+  const auto lock = std::lock_guard(shard.mutex);
+  const auto nameIter = shard.names.find(filename);
+  if (nameIter == shard.names.end()) {
     std::stringstream messageStream;
     messageStream << "Trying closing tape (" << filename
                   << ") which is not opened." << std::endl;
     throw std::logic_error(messageStream.str());
   }
+  // Errors of writing the rest reach the caller, the tape stays opened then.
+  shard.slots[nameIter->second].tape->flush();
   increaseCloseCnt();
-  tapes_.erase(filename);
+  eraseTapeLocked_(shard, nameIter->second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapePool::closeTape(TapeHandle handle) {
+  const std::size_t shardIdx = handle.index % tapesShardsCnt;
+  auto& shard = shards_[shardIdx];
+  const auto lock = std::lock_guard(shard.mutex);
+  const std::uint32_t slotIdx = findSlotLocked_(shardIdx, handle);
+  shard.slots[slotIdx].tape->flush();
+  increaseCloseCnt();
+  eraseTapeLocked_(shard, slotIdx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapePool::getCacheStatistics() const -> CacheStatistics {
+  auto ret = CacheStatistics{};
+  for (const auto& shard : shards_) {
+    const auto lock = std::lock_guard(shard.mutex);
+    ret.hitCnt += shard.closedTapesCacheStatistics.hitCnt;
+    ret.missCnt += shard.closedTapesCacheStatistics.missCnt;
+    ret.seekCnt += shard.closedTapesCacheStatistics.seekCnt;
+    for (const auto& slot : shard.slots) {
+      if (!slot.tape.has_value()) {
+        continue;
+      }
+      const auto tapeStatistics = slot.tape->getCacheStatistics();
+      ret.hitCnt += tapeStatistics.hitCnt;
+      ret.missCnt += tapeStatistics.missCnt;
+      ret.seekCnt += tapeStatistics.seekCnt;
+    }
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t TapePool::getShardIdx_(std::string_view filename) {
+  return std::hash<std::string_view>()(filename) % tapesShardsCnt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TapeHandle TapePool::makeHandle_(std::size_t shardIdx, std::uint32_t slotIdx,
+                                 const Slot_& slot) {
+  return {static_cast<std::uint32_t>(slotIdx * tapesShardsCnt + shardIdx),
+          slot.generation};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapePool::insertTapeLocked_(std::size_t shardIdx,
+                                 std::string_view filename,
+                                 std::size_t cellSize,
+                                 std::optional<std::size_t> size,
+                                 TapeBackendType backendType,
+                                 TapeFormat format) -> FoundTape_ {
+  auto& shard = shards_[shardIdx];
+  const auto [nameIter, inserted] = shard.names.emplace(filename, 0);
+  if (!inserted) {
+    std::stringstream messageStream;
+    messageStream << "Trying opening tape(" << filename << ") twice.";
+    throw std::logic_error(messageStream.str());
+  }
+  std::uint32_t slotIdx = 0;
+  if (shard.freeSlots.empty()) {
+    slotIdx = static_cast<std::uint32_t>(shard.slots.size());
+    shard.slots.emplace_back();
+  } else {
+    slotIdx = shard.freeSlots.back();
+    shard.freeSlots.pop_back();
+  }
+  auto& slot = shard.slots[slotIdx];
+  try {
+    slot.tape.emplace(filename, cellSize, size, backendType, readWindowSize_,
+                      writeBufferSize_, format);
+  } catch (...) {
+    shard.names.erase(nameIter);
+    shard.freeSlots.push_back(slotIdx);
+    throw;
+  }
+  nameIter->second = slotIdx;
+  slot.nameIter = nameIter;
+  return {&*slot.tape, makeHandle_(shardIdx, slotIdx, slot)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t TapePool::findSlotLocked_(std::size_t shardIdx,
+                                        TapeHandle handle) const {
+  const auto& shard = shards_[shardIdx];
+  const std::size_t slotIdx = handle.index / tapesShardsCnt;
+  if (slotIdx >= shard.slots.size() || !shard.slots[slotIdx].tape ||
+      shard.slots[slotIdx].generation != handle.generation) {
+    std::stringstream messageStream;
+    messageStream << "Trying using a handle(" << handle.index << ", "
+                  << handle.generation << ") of a tape which is not opened.";
+    throw std::logic_error(messageStream.str());
+  }
+  return static_cast<std::uint32_t>(slotIdx);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+auto TapePool::checkCellSize_(std::string_view filename, FoundTape_ found,
+                              std::size_t cellSize) -> FoundTape_ {
+  if (found.tape->getCellSize() != cellSize) {
+    std::stringstream messageStream;
+    messageStream << "Trying getting a view with elements of " << cellSize
+                  << " bytes to a tape(" << filename << ") with cells of "
+                  << found.tape->getCellSize() << " bytes.";
+    throw std::logic_error(messageStream.str());
+  }
+  return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TapePool::eraseTapeLocked_(TapesShard_& shard, std::uint32_t slotIdx) {
+  auto& slot = shard.slots[slotIdx];
+  const auto tapeStatistics = slot.tape->getCacheStatistics();
+  shard.closedTapesCacheStatistics.hitCnt += tapeStatistics.hitCnt;
+  shard.closedTapesCacheStatistics.missCnt += tapeStatistics.missCnt;
+  shard.closedTapesCacheStatistics.seekCnt += tapeStatistics.seekCnt;
+  slot.tape.reset();
+  shard.names.erase(slot.nameIter);
+  ++slot.generation;
+  shard.freeSlots.push_back(slotIdx);
 }
@@ -0,0 +1,7 @@
+#include <impl/tape_sort_base.hpp>
+
+template class TapeSortBase<std::int32_t>;
+template class TapeSortBase<std::int64_t>;
+template class TapeSortBase<std::uint64_t>;
+template class TapeSortBase<float>;
+template class TapeSortBase<double>;
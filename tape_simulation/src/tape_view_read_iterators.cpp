@@ -1,13 +1,12 @@
 #include <tape_view_read_iterators.hpp>
 
-////////////////////////////////////////////////////////////////////////////////
-RightReadIterator& RightReadIterator::operator++() {
-  getTapeView_().moveRight();
-  return *this;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-LeftReadIterator& LeftReadIterator::operator++() {
-  getTapeView_().moveLeft();
-  return *this;
-}
+template class BasicRightReadIterator<std::int32_t>;
+template class BasicRightReadIterator<std::int64_t>;
+template class BasicRightReadIterator<std::uint64_t>;
+template class BasicRightReadIterator<float>;
+template class BasicRightReadIterator<double>;
+template class BasicLeftReadIterator<std::int32_t>;
+template class BasicLeftReadIterator<std::int64_t>;
+template class BasicLeftReadIterator<std::uint64_t>;
+template class BasicLeftReadIterator<float>;
+template class BasicLeftReadIterator<double>;
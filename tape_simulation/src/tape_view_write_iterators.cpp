@@ -1,13 +1,12 @@
 #include <tape_view_write_iterators.hpp>
 
-////////////////////////////////////////////////////////////////////////////////
-RightWriteIterator& RightWriteIterator::operator++() {
-  getTapeView_().moveRight();
-  return *this;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-LeftWriteIterator& LeftWriteIterator::operator++() {
-  getTapeView_().moveLeft();
-  return *this;
-}
+template class BasicRightWriteIterator<std::int32_t>;
+template class BasicRightWriteIterator<std::int64_t>;
+template class BasicRightWriteIterator<std::uint64_t>;
+template class BasicRightWriteIterator<float>;
+template class BasicRightWriteIterator<double>;
+template class BasicLeftWriteIterator<std::int32_t>;
+template class BasicLeftWriteIterator<std::int64_t>;
+template class BasicLeftWriteIterator<std::uint64_t>;
+template class BasicLeftWriteIterator<float>;
+template class BasicLeftWriteIterator<double>;
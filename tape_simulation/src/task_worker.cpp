@@ -0,0 +1,51 @@
+#include <impl/task_worker.hpp>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+TaskWorker::TaskWorker() : thread_{[this]() { run_(); }} {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TaskWorker::~TaskWorker() {
+  {
+    const auto lock = std::lock_guard(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+  thread_.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::future<void> TaskWorker::submit(std::function<void()> task) {
+  auto packagedTask = std::packaged_task<void()>(std::move(task));
+  auto ret = packagedTask.get_future();
+  {
+    const auto lock = std::lock_guard(mutex_);
+    tasks_.push_back(std::move(packagedTask));
+  }
+  condition_.notify_one();
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TaskWorker::wait() {
+  // Tasks run in order, so an empty task finishes after all previous ones.
+  submit([]() {}).wait();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TaskWorker::run_() {
+  while (true) {
+    auto task = std::packaged_task<void()>{};
+    {
+      auto lock = std::unique_lock(mutex_);
+      condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
@@ -0,0 +1,7 @@
+#include <impl/tmp_tapes_manager.hpp>
+
+template class TmpTapesManager<std::int32_t>;
+template class TmpTapesManager<std::int64_t>;
+template class TmpTapesManager<std::uint64_t>;
+template class TmpTapesManager<float>;
+template class TmpTapesManager<double>;
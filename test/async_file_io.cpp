@@ -0,0 +1,181 @@
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <impl/async_file_io.hpp>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cert-err58-cpp)
+
+namespace {
+
+using MakeIo = std::function<std::unique_ptr<AsyncFileIo>(int fd,
+                                                          std::string name)>;
+
+////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<AsyncFileIo> makePooledIo(int fd, std::string name) {
+  return std::make_unique<PooledAsyncFileIo>(fd, std::move(name));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<AsyncFileIo> makeIoUringIo(int fd, std::string name) {
+  return std::make_unique<IoUringAsyncFileIo>(fd, std::move(name));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool isIoUringSupported() {
+  try {
+    IoUringAsyncFileIo(-1, "");
+    return true;
+  } catch (const std::system_error&) {
+    return false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::byte> makeBytes(std::size_t size, std::size_t seed) {
+  auto ret = std::vector<std::byte>(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    ret[i] = static_cast<std::byte>((i * 31 + seed) % 251);
+  }
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void writeAndReadBack(const std::string& filename, const MakeIo& makeIo) {
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  // More requests than io_uring entries, of sizes not aligned to pages.
+  constexpr std::size_t requestsCnt = 100;
+  constexpr std::size_t requestSize = 12345;
+  const int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  ASSERT_NE(fd, -1);
+  {
+    auto io = makeIo(fd, filename);
+    auto written = std::vector<std::vector<std::byte>>{};
+    auto requests = std::vector<AsyncFileIo::Request>{};
+    for (std::size_t i = 0; i < requestsCnt; ++i) {
+      written.push_back(makeBytes(requestSize, i));
+      requests.push_back(io->submitWrite(written.back().data(), requestSize,
+                                         i * requestSize));
+    }
+    for (const auto request : requests) {
+      io->wait(request);
+    }
+    auto read = std::vector<std::vector<std::byte>>(
+        requestsCnt, std::vector<std::byte>(requestSize));
+    requests.clear();
+    for (std::size_t i = 0; i < requestsCnt; ++i) {
+      requests.push_back(
+          io->submitRead(read[i].data(), requestSize, i * requestSize));
+    }
+    for (const auto request : requests) {
+      io->wait(request);
+    }
+    EXPECT_EQ(read, written);
+  }
+  ::close(fd);
+  EXPECT_EQ(std::filesystem::file_size(filename), requestsCnt * requestSize);
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void readPastEndThrows(const std::string& filename, const MakeIo& makeIo) {
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  const int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  ASSERT_NE(fd, -1);
+  {
+    auto io = makeIo(fd, filename);
+    auto data = makeBytes(16, 0);
+    io->wait(io->submitWrite(data.data(), data.size(), 0));
+    const auto request = io->submitRead(data.data(), data.size(), 8);
+    try {
+      io->wait(request);
+      ADD_FAILURE() << "Read past the end did not throw.";
+    } catch (const std::system_error& e) {
+      EXPECT_EQ(e.code().value(), EIO);
+    }
+  }
+  ::close(fd);
+  std::filesystem::remove(filename);
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, PooledWriteAndReadBack) {
+  writeAndReadBack("pooled_write_and_read_back", makePooledIo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, PooledReadPastEndThrows) {
+  readPastEndThrows("pooled_read_past_end_throws", makePooledIo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, PooledFilesShareThreads) {
+  constexpr auto filename = "pooled_files_share_threads";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  const int fd = ::open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  ASSERT_NE(fd, -1);
+  {
+    // Files share the threads, requests of one do not wait for another.
+    auto first = makePooledIo(fd, filename);
+    auto second = makePooledIo(fd, filename);
+    auto data = makeBytes(1 << 20, 1);
+    const auto firstRequest = first->submitWrite(data.data(), data.size(), 0);
+    const auto secondRequest =
+        second->submitWrite(data.data(), data.size(), data.size());
+    first->wait(firstRequest);
+    second->wait(secondRequest);
+  }
+  ::close(fd);
+  EXPECT_EQ(std::filesystem::file_size(filename), 2 << 20);
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, IoUringWriteAndReadBack) {
+  if (!isIoUringSupported()) {
+    GTEST_SKIP() << "io_uring is not available.";
+  }
+  writeAndReadBack("io_uring_write_and_read_back", makeIoUringIo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, IoUringReadPastEndThrows) {
+  if (!isIoUringSupported()) {
+    GTEST_SKIP() << "io_uring is not available.";
+  }
+  readPastEndThrows("io_uring_read_past_end_throws", makeIoUringIo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, IoUringBadDescriptorThrows) {
+  if (!isIoUringSupported()) {
+    GTEST_SKIP() << "io_uring is not available.";
+  }
+  auto io = makeIoUringIo(-1, "bad_descriptor");
+  auto data = std::vector<std::byte>(16);
+  const auto request = io->submitRead(data.data(), data.size(), 0);
+  EXPECT_THROW(io->wait(request), std::system_error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(AsyncFileIo, MadeIoWritesFile) {
+  writeAndReadBack("made_io_write_and_read_back", makeAsyncFileIo);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cert-err58-cpp)
@@ -3,10 +3,13 @@
 #include <copy_n.hpp>
 #include <filesystem>
 #include <improved_merge_sort.hpp>
+#include <iterator>
+#include <random>
 #include <vector>
 
 #include "common_utils.hpp"
 #include "improved_merge_sort_tests_utils.hpp"
+#include "merge_sort_tests_utils.hpp"
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
 // cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
@@ -122,7 +125,399 @@ INSTANTIATE_TEST_SUITE_P(
       return paramInfo.param.testDescription;
     });
 
+class ReplacementSelectionMergeSortTest
+    : public testing::TestWithParam<ImprovedMergeSortTestParam> {};
+
+TEST_P(ReplacementSelectionMergeSortTest, CompareWithStdSort) {
+  const auto& params = ReplacementSelectionMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_rs_in_file";
+  const auto outFilename = params.testDescription + "_rs_out_file";
+  const auto tmpDirectory = params.testDescription + "_rs_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    ImprovedMergeSortImproved(tapePool, inFilename, tmpDirectory,
+                              params.increasing, params.heapSizeLimit,
+                              RunGeneration::ReplacementSelection)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(), [&params](auto v0, auto v1) {
+      return params.increasing ? (v0 < v1) : (v0 > v1);
+    });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes, ReplacementSelectionMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSized, ReplacementSelectionMergeSortTest,
+                         testing::ValuesIn(threePowSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(
+    DecreasingTwoPowSizedWithRatios, ReplacementSelectionMergeSortTest,
+    testing::ValuesIn(twoPowSizedDecreasingTestCasesWithRatios),
+    [](const auto& paramInfo) {
+      return paramInfo.param.testDescription;
+    });
+
+class PreScanImprovedMergeSortTest
+    : public testing::TestWithParam<ImprovedMergeSortTestParam> {};
+
+TEST_P(PreScanImprovedMergeSortTest, CompareWithStdSort) {
+  const auto& params = PreScanImprovedMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_pre_scan_in_file";
+  const auto outFilename = params.testDescription + "_pre_scan_out_file";
+  const auto tmpDirectory = params.testDescription + "_pre_scan_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    ImprovedMergeSortImproved(tapePool, inFilename, tmpDirectory,
+                              params.increasing, params.heapSizeLimit,
+                              RunGeneration::FixedBlocks, true)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(), [&params](auto v0, auto v1) {
+      return params.increasing ? (v0 < v1) : (v0 > v1);
+    });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes, PreScanImprovedMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSized, PreScanImprovedMergeSortTest,
+                         testing::ValuesIn(threePowSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(
+    DecreasingTwoPowSizedWithRatios, PreScanImprovedMergeSortTest,
+    testing::ValuesIn(twoPowSizedDecreasingTestCasesWithRatios),
+    [](const auto& paramInfo) {
+      return paramInfo.param.testDescription;
+    });
+
+class ParallelPassesImprovedMergeSortTest
+    : public testing::TestWithParam<ImprovedMergeSortTestParam> {};
+
+TEST_P(ParallelPassesImprovedMergeSortTest, CompareWithStdSort) {
+  const auto& params = ParallelPassesImprovedMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_parallel_in_file";
+  const auto outFilename = params.testDescription + "_parallel_out_file";
+  const auto tmpDirectory = params.testDescription + "_parallel_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool(TapeBackendType::File, TapeBackendType::Mmap);
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    ImprovedMergeSortImproved(tapePool, inFilename, tmpDirectory,
+                              params.increasing, params.heapSizeLimit,
+                              RunGeneration::FixedBlocks, false, true)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(), [&params](auto v0, auto v1) {
+      return params.increasing ? (v0 < v1) : (v0 > v1);
+    });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes, ParallelPassesImprovedMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSized, ParallelPassesImprovedMergeSortTest,
+                         testing::ValuesIn(threePowSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(
+    DecreasingTwoPowSizedWithRatios, ParallelPassesImprovedMergeSortTest,
+    testing::ValuesIn(twoPowSizedDecreasingTestCasesWithRatios),
+    [](const auto& paramInfo) {
+      return paramInfo.param.testDescription;
+    });
+
+class ParallelRunGenerationImprovedMergeSortTest
+    : public testing::TestWithParam<ImprovedMergeSortTestParam> {};
+
+TEST_P(ParallelRunGenerationImprovedMergeSortTest, CompareWithStdSort) {
+  const auto& params = ParallelRunGenerationImprovedMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_sort_threads_in_file";
+  const auto outFilename = params.testDescription + "_sort_threads_out_file";
+  const auto tmpDirectory = params.testDescription + "_sort_threads_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    ImprovedMergeSortImproved(tapePool, inFilename, tmpDirectory,
+                              params.increasing, params.heapSizeLimit,
+                              RunGeneration::FixedBlocks, false, false,
+                              nullptr, 3)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(), [&params](auto v0, auto v1) {
+      return params.increasing ? (v0 < v1) : (v0 > v1);
+    });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes,
+                         ParallelRunGenerationImprovedMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSized,
+                         ParallelRunGenerationImprovedMergeSortTest,
+                         testing::ValuesIn(threePowSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(
+    DecreasingTwoPowSizedWithRatios, ParallelRunGenerationImprovedMergeSortTest,
+    testing::ValuesIn(twoPowSizedDecreasingTestCasesWithRatios),
+    [](const auto& paramInfo) {
+      return paramInfo.param.testDescription;
+    });
+
+TapePool::IOStatistics sortAndGetStatistics(
+    const std::vector<std::int32_t>& values, std::size_t heapSizeLimit,
+    RunGeneration runGeneration, bool preScan = false,
+    std::size_t sortThreadsCnt = 1) {
+  return sort_and_get_statistics(
+      "run_generation", values,
+      [&](TapePool& tapePool, const std::string& inFilename,
+          const std::string& tmpDirectory, const std::string& outFilename) {
+        ImprovedMergeSortImproved(tapePool, inFilename, tmpDirectory, true,
+                                  heapSizeLimit, runGeneration, preScan,
+                                  false, nullptr, sortThreadsCnt)
+            .perform(outFilename);
+      });
+}
+
 }  // namespace
 
+TEST(ReplacementSelection, RunsAreTwiceHeapSizeOnRandomInput) {
+  auto generator = std::mt19937(47);
+  auto values = std::vector<std::int32_t>(100000);
+  for (auto& value : values) {
+    value = static_cast<std::int32_t>(generator());
+  }
+  auto out0 = std::vector<std::int32_t>{};
+  auto out1 = std::vector<std::int32_t>{};
+  const auto runs = replacement_selection<std::less<>>(
+      values.begin(), values.size(),
+      std::vector{std::back_inserter(out0), std::back_inserter(out1)}, 100);
+  const std::size_t runsCnt = runs[0].size() + runs[1].size();
+  EXPECT_GT(runsCnt, 450);
+  EXPECT_LT(runsCnt, 550);
+  EXPECT_EQ(out0.size() + out1.size(), values.size());
+  std::size_t begin = 0;
+  for (const std::size_t length : runs[0]) {
+    EXPECT_TRUE(std::is_sorted(out0.begin() + begin,
+                               out0.begin() + begin + length));
+    begin += length;
+  }
+}
+
+TEST(ReplacementSelection, FewerOperationsThanFixedBlocks) {
+  auto generator = std::mt19937(48);
+  auto values = std::vector<std::int32_t>(4096);
+  for (auto& value : values) {
+    value = static_cast<std::int32_t>(generator());
+  }
+  const auto blocksStats =
+      sortAndGetStatistics(values, 24, RunGeneration::FixedBlocks);
+  const auto replacementStats =
+      sortAndGetStatistics(values, 24, RunGeneration::ReplacementSelection);
+  EXPECT_LT(replacementStats.readCnt, blocksStats.readCnt);
+  EXPECT_LT(replacementStats.writeCnt, blocksStats.writeCnt);
+}
+
+TEST(ReplacementSelection, NearlySortedInputIsOneRun) {
+  // Neighbouring couples are swapped.
+  auto values = std::vector<std::int32_t>(4096);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::int32_t>(i ^ 1U);
+  }
+  const auto stats =
+      sortAndGetStatistics(values, 256, RunGeneration::ReplacementSelection);
+  // Runs are made and copied into the output tape.
+  EXPECT_EQ(stats.readCnt, 2 * values.size());
+  EXPECT_EQ(stats.writeCnt, 2 * values.size());
+}
+
+TEST(PreScan, ManyRunsFallBackToBlocks) {
+  auto generator = std::mt19937(49);
+  auto values = std::vector<std::int32_t>(4096);
+  for (auto& value : values) {
+    value = static_cast<std::int32_t>(generator());
+  }
+  const auto blocksStats =
+      sortAndGetStatistics(values, 16, RunGeneration::FixedBlocks);
+  const auto preScanStats =
+      sortAndGetStatistics(values, 16, RunGeneration::FixedBlocks, true);
+  // The scan is the only extra work.
+  EXPECT_EQ(preScanStats.scanReadCnt, values.size());
+  EXPECT_EQ(preScanStats.readCnt, blocksStats.readCnt + values.size());
+  EXPECT_EQ(preScanStats.writeCnt, blocksStats.writeCnt);
+}
+
+TEST(PreScan, FewRunsAreMergedFromScan) {
+  // Four increasing runs, each much longer than an initial block.
+  auto values = std::vector<std::int32_t>(4096);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::int32_t>((i % 1024) * 4 + i / 1024);
+  }
+  const auto blocksStats =
+      sortAndGetStatistics(values, 16, RunGeneration::FixedBlocks);
+  const auto preScanStats =
+      sortAndGetStatistics(values, 16, RunGeneration::FixedBlocks, true);
+  EXPECT_LT(preScanStats.readCnt, blocksStats.readCnt);
+  EXPECT_LT(preScanStats.writeCnt, blocksStats.writeCnt);
+}
+
+TEST(PreScan, ReverseSortedInputIsWrittenLeft) {
+  auto values = std::vector<std::int32_t>(4096);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::int32_t>(values.size() - i);
+  }
+  const auto stats =
+      sortAndGetStatistics(values, 16, RunGeneration::FixedBlocks, true);
+  // A scan and a single pass.
+  EXPECT_EQ(stats.readCnt, 2 * values.size());
+  EXPECT_EQ(stats.writeCnt, values.size());
+}
+
+template <class T>
+void checkTypedImprovedMergeSort(const std::string& name,
+                                 std::uint32_t seed) {
+  auto generator = std::mt19937(seed);
+  auto values = std::vector<T>(333);
+  for (auto& value : values) {
+    value = static_cast<T>(generator()) - static_cast<T>(generator());
+  }
+  const auto inFilename = name + "_in_file";
+  const auto outFilename = name + "_out_file";
+  const auto tmpDirectory = name + "_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape<T>(inFilename, values.size());
+    copy_n(values.begin(), values.size(), BasicRightWriteIterator<T>(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+    BasicImprovedMergeSortImproved<T>(tapePool, inFilename, tmpDirectory, true,
+                                      10)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape<T>(outFilename);
+    auto result = std::vector<T>{};
+    copy_n(BasicRightReadIterator<T>(outTape), values.size(),
+           std::back_inserter(result));
+    std::sort(values.begin(), values.end());
+    EXPECT_TRUE(eq(values, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+TEST(ParallelRunGeneration, SameStatisticsAsSingleThread) {
+  auto generator = std::mt19937(53);
+  auto values = std::vector<std::int32_t>(1000);
+  std::generate(values.begin(), values.end(), generator);
+  for (const std::size_t heapSizeLimit : {7, 37, 250}) {
+    const auto single =
+        sortAndGetStatistics(values, heapSizeLimit, RunGeneration::FixedBlocks);
+    const auto parallel = sortAndGetStatistics(
+        values, heapSizeLimit, RunGeneration::FixedBlocks, false, 4);
+    EXPECT_EQ(single.readCnt, parallel.readCnt);
+    EXPECT_EQ(single.writeCnt, parallel.writeCnt);
+    EXPECT_EQ(single.moveCnt, parallel.moveCnt);
+    EXPECT_EQ(single.createCnt, parallel.createCnt);
+  }
+}
+
+TEST(ParallelRunGeneration, ZeroSortThreadsThrow) {
+  const std::string inFilename = "zero_sort_threads_in_file";
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  tapePool.createTape(inFilename, 10);
+  const auto construct = [&]() {
+    ImprovedMergeSortImproved(tapePool, inFilename, "zero_sort_threads_tmp",
+                              true, 4, RunGeneration::FixedBlocks, false,
+                              false, nullptr, 0);
+  };
+  EXPECT_THROW(construct(), std::logic_error);
+}
+
+TEST(ImprovedMergeSort, SortsOtherElementTypes) {
+  checkTypedImprovedMergeSort<std::int64_t>("improved_merge_sort_int64", 43);
+  checkTypedImprovedMergeSort<std::uint64_t>("improved_merge_sort_uint64", 44);
+  checkTypedImprovedMergeSort<float>("improved_merge_sort_float", 45);
+  checkTypedImprovedMergeSort<double>("improved_merge_sort_double", 46);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
 // cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
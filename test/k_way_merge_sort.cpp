@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <k_way_merge_sort.hpp>
+#include <merge_sort.hpp>
+#include <string>
+#include <vector>
+
+#include "common_utils.hpp"
+#include "merge_sort_tests_utils.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
+
+namespace {
+
+struct KWayMergeSortTestParam {
+  std::size_t size;
+  std::size_t waysCnt;
+  std::size_t initialBlockSize;
+  bool increasing;
+};
+
+class KWayMergeSortTest
+    : public testing::TestWithParam<KWayMergeSortTestParam> {};
+
+TEST_P(KWayMergeSortTest, CompareWithStdSort) {
+  const auto& params = GetParam();
+  expect_sort_like_std_sort(
+      "k_way_merge_sort", generate_values(params.size, 42), params.increasing,
+      [&params](TapePool& tapePool, const std::string& inFilename,
+                const std::string& tmpDirectory,
+                const std::string& outFilename) {
+        KWayMergeSort(tapePool, inFilename, tmpDirectory, params.increasing,
+                      params.waysCnt, params.initialBlockSize)
+            .perform(outFilename);
+      });
+}
+
+auto generateKWayMergeSortParams() {
+  auto params = std::vector<KWayMergeSortTestParam>{};
+  for (const std::size_t size : {0, 1, 2, 5, 16, 17, 100, 243, 1000}) {
+    for (const std::size_t waysCnt : {2, 3, 4, 7}) {
+      for (const std::size_t initialBlockSize : {1, 5}) {
+        for (const bool increasing : {true, false}) {
+          params.push_back({size, waysCnt, initialBlockSize, increasing});
+        }
+      }
+    }
+  }
+  return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KWayMergeSorts, KWayMergeSortTest,
+    testing::ValuesIn(generateKWayMergeSortParams()),
+    [](const auto& paramInfo) {
+      const auto& param = paramInfo.param;
+      return "size_" + std::to_string(param.size) + "_k_" +
+             std::to_string(param.waysCnt) + "_block_" +
+             std::to_string(param.initialBlockSize) +
+             (param.increasing ? "_increasing" : "_decreasing");
+    });
+
+}  // namespace
+
+TEST(KWayMergeSort, FewerOperationsThanMergeSort) {
+  const auto values = generate_values(4096, 43);
+  const auto sort = [&](std::size_t waysCnt) {
+    return sort_and_get_statistics(
+        "k_way_fewer_operations", values,
+        [waysCnt](TapePool& tapePool, const std::string& inFilename,
+                  const std::string& tmpDirectory,
+                  const std::string& outFilename) {
+          if (waysCnt == 2) {
+            MergeSort(tapePool, inFilename, tmpDirectory, true)
+                .perform(outFilename);
+          } else {
+            KWayMergeSort(tapePool, inFilename, tmpDirectory, true, waysCnt)
+                .perform(outFilename);
+          }
+        });
+  };
+  // 4096 runs: distribution and 12 passes of MergeSort, distribution and 6
+  // passes with k = 4.
+  const auto twoWayStats = sort(2);
+  const auto fourWayStats = sort(4);
+  EXPECT_EQ(twoWayStats.readCnt, 13 * values.size());
+  EXPECT_EQ(fourWayStats.readCnt, 7 * values.size());
+  EXPECT_EQ(fourWayStats.writeCnt, 7 * values.size());
+  EXPECT_LT(fourWayStats.moveCnt, 7 * 2 * values.size());
+  EXPECT_LT(13 * fourWayStats.moveCnt, 7 * twoWayStats.moveCnt);
+}
+
+TEST(KWayMergeSort, NeedsTwoWays) {
+  constexpr auto filename = "k_way_needs_two_ways";
+  remove_all(filename);
+  {
+    auto tapePool = TapePool();
+    tapePool.createTape(filename, 1);
+    EXPECT_THROW(KWayMergeSort(tapePool, filename, "tmp", true, 1),
+                 KWayMergeSort::InvalidWaysCnt);
+  }
+  remove_all(filename);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
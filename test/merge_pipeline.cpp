@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <merge_pipeline.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "common_utils.hpp"
+#include "merge_test_utils.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// class PipelinedMergeTest for doing TEST_P
+class PipelinedMergeTest : public testing::TestWithParam<MergeTestParam> {};
+
+TEST_P(PipelinedMergeTest, CompareWithStdMerge) {
+  const auto& params = PipelinedMergeTest::GetParam();
+
+  for (const std::size_t ringCapacity : {1, 2, 64}) {
+    auto result = std::vector<std::int32_t>{};
+    auto expected = std::vector<std::int32_t>(params.input0.size() +
+                                              params.input1.size());
+    if (params.increasing) {
+      pipelined_merge<std::less<>>(
+          params.input0.begin(), params.input0.size(), params.input1.begin(),
+          params.input1.size(), std::back_inserter(result), ringCapacity);
+      std::merge(params.input0.begin(), params.input0.end(),
+                 params.input1.begin(), params.input1.end(),
+                 expected.begin());
+    } else {
+      pipelined_merge<std::greater<>>(
+          params.input0.begin(), params.input0.size(), params.input1.begin(),
+          params.input1.size(), std::back_inserter(result), ringCapacity);
+      std::merge(params.input0.rbegin(), params.input0.rend(),
+                 params.input1.rbegin(), params.input1.rend(),
+                 expected.rbegin());
+    }
+    EXPECT_TRUE(eq(result, expected));
+  }
+}
+
+const static auto generatedIncreasingMergeInputs =
+    generate_merge_tapes_test_cases_of_sizes(
+        43, true, {{1, 1}, {2, 3}, {6, 10}, {31, 44}, {1000, 1}, {500, 700}});
+
+INSTANTIATE_TEST_SUITE_P(GeneratedIncreasingMerges, PipelinedMergeTest,
+                         testing::ValuesIn(generatedIncreasingMergeInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.description;
+                         });
+
+const static auto generatedDecreasingMergeInputs =
+    generate_merge_tapes_test_cases_of_sizes(
+        43, false, {{1, 1}, {2, 3}, {6, 10}, {31, 44}, {1, 1000}, {700, 500}});
+
+INSTANTIATE_TEST_SUITE_P(GeneratedDecreasingMerges, PipelinedMergeTest,
+                         testing::ValuesIn(generatedDecreasingMergeInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.description;
+                         });
+
+////////////////////////////////////////////////////////////////////////////////
+/// class FailingIterator - input iterator throwing on a dereference of the
+/// element of index `failIdx`.
+class FailingIterator {
+ public:
+  explicit FailingIterator(std::size_t failIdx) : failIdx_{failIdx} {
+  }
+
+  int operator*() const {
+    if (idx_ == failIdx_) {
+      throw std::runtime_error("Source failed.");
+    }
+    return static_cast<int>(idx_);
+  }
+
+  FailingIterator& operator++() {
+    ++idx_;
+    return *this;
+  }
+
+ private:
+  std::size_t idx_{0};
+  std::size_t failIdx_;
+};
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(SpscRing, KeepsOrderAndCapacity) {
+  auto ring = SpscRing<int>(2);
+  auto value = int{};
+  EXPECT_FALSE(ring.tryPop(value));
+  EXPECT_TRUE(ring.tryPush(1));
+  EXPECT_TRUE(ring.tryPush(2));
+  EXPECT_FALSE(ring.tryPush(3));
+  EXPECT_TRUE(ring.tryPop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(ring.tryPush(3));
+  EXPECT_TRUE(ring.tryPop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(ring.tryPop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(ring.tryPop(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(SpscRing, ZeroCapacityThrows) {
+  EXPECT_THROW(SpscRing<int>(0), std::invalid_argument);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(PipelinedMerge, EmptySourcesThrow) {
+  const auto src = std::array<int, 3>{1, 2, 3};
+  auto target = std::vector<int>{};
+  const auto perform = [&](std::size_t cnt0, std::size_t cnt1) {
+    pipelined_merge<std::less<>>(src.begin(), cnt0, src.begin(), cnt1,
+                                 std::back_inserter(target), 2);
+  };
+  EXPECT_THROW(perform(0, 0), std::logic_error);
+  EXPECT_THROW(perform(3, 0), std::logic_error);
+  EXPECT_THROW(perform(0, 3), std::logic_error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(PipelinedMerge, SourceErrorIsRethrown) {
+  auto source1 = std::vector<int>(1000);
+  std::iota(source1.begin(), source1.end(), 0);
+  auto target = std::vector<int>{};
+  const auto perform = [&]() {
+    pipelined_merge<std::less<>>(FailingIterator(500), 1000, source1.begin(),
+                                 source1.size(), std::back_inserter(target),
+                                 4);
+  };
+  EXPECT_THROW(perform(), std::runtime_error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(MergePipeline, SumsStallsOfMerges) {
+  auto source = std::vector<int>(10000);
+  std::iota(source.begin(), source.end(), 0);
+  auto mergePipeline = MergePipeline(1, 100);
+  EXPECT_FALSE(mergePipeline.isWorthPipelining(99));
+  EXPECT_TRUE(mergePipeline.isWorthPipelining(100));
+
+  auto result = std::vector<int>{};
+  for (std::size_t i = 0; i < 2; ++i) {
+    result.clear();
+    mergePipeline.merge<std::less<>>(source.begin(), source.size(),
+                                     source.begin(), source.size(),
+                                     std::back_inserter(result));
+  }
+  EXPECT_EQ(result.size(), 2 * source.size());
+  EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+  EXPECT_EQ(mergePipeline.getMergesCnt(), 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(MergePipeline, ZeroRingCapacityThrows) {
+  EXPECT_THROW(MergePipeline(0), std::invalid_argument);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <array>
 #include <copy_n.hpp>
 #include <filesystem>
+#include <functional>
+#include <merge_pipeline.hpp>
 #include <merge_sort.hpp>
+#include <numeric>
+#include <random>
+#include <utility>
 #include <vector>
 
 #include "common_utils.hpp"
@@ -116,7 +122,558 @@ INSTANTIATE_TEST_SUITE_P(ThreePowSizedDecreasingMergeSorts, MergeSortTest,
                            return paramInfo.param.testDescription;
                          });
 
+class NaturalMergeSortTest
+    : public testing::TestWithParam<MergeSortTestParam> {};
+
+TEST_P(NaturalMergeSortTest, CompareWithStdSort) {
+  const auto& params = NaturalMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_natural_in_file";
+  const auto outFilename = params.testDescription + "_natural_out_file";
+  const auto tmpDirectory = params.testDescription + "_natural_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    MergeSort(tapePool, inFilename, tmpDirectory, params.increasing,
+              RunGeneration::NaturalRuns)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(),
+              [&params](auto v1, auto v2) -> bool {
+                return params.increasing ? (v1 < v2) : (v1 > v2);
+              });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes, NaturalMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSizedIncreasing, NaturalMergeSortTest,
+                         testing::ValuesIn(threePowIncreasingSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSizedDecreasing, NaturalMergeSortTest,
+                         testing::ValuesIn(threePowDecreasingSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+class PreScanMergeSortTest
+    : public testing::TestWithParam<MergeSortTestParam> {};
+
+TEST_P(PreScanMergeSortTest, CompareWithStdSort) {
+  const auto& params = PreScanMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_pre_scan_in_file";
+  const auto outFilename = params.testDescription + "_pre_scan_out_file";
+  const auto tmpDirectory = params.testDescription + "_pre_scan_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    MergeSort(tapePool, inFilename, tmpDirectory, params.increasing,
+              RunGeneration::FixedBlocks, true)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(),
+              [&params](auto v1, auto v2) -> bool {
+                return params.increasing ? (v1 < v2) : (v1 > v2);
+              });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes, PreScanMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSizedIncreasing, PreScanMergeSortTest,
+                         testing::ValuesIn(threePowIncreasingSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSizedDecreasing, PreScanMergeSortTest,
+                         testing::ValuesIn(threePowDecreasingSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+class ParallelPassesMergeSortTest
+    : public testing::TestWithParam<MergeSortTestParam> {};
+
+TEST_P(ParallelPassesMergeSortTest, CompareWithStdSort) {
+  const auto& params = ParallelPassesMergeSortTest::GetParam();
+  const auto inFilename = params.testDescription + "_parallel_in_file";
+  const auto outFilename = params.testDescription + "_parallel_out_file";
+  const auto tmpDirectory = params.testDescription + "_parallel_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool(TapeBackendType::File, TapeBackendType::Memory);
+    auto inTape = tapePool.createTape(inFilename, params.values.size());
+    copy_n(params.values.begin(), params.values.size(),
+           RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+
+    MergeSort(tapePool, inFilename, tmpDirectory, params.increasing,
+              RunGeneration::FixedBlocks, false, true)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), params.values.size(),
+           std::back_inserter(result));
+
+    auto expected = std::vector<std::int32_t>(params.values);
+    std::sort(expected.begin(), expected.end(),
+              [&params](auto v1, auto v2) -> bool {
+                return params.increasing ? (v1 < v2) : (v1 > v2);
+              });
+    EXPECT_TRUE(eq(expected, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimpleTapes, ParallelPassesMergeSortTest,
+                         testing::ValuesIn(simpleMergeSortInputs),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSizedIncreasing, ParallelPassesMergeSortTest,
+                         testing::ValuesIn(threePowIncreasingSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+INSTANTIATE_TEST_SUITE_P(ThreePowSizedDecreasing, ParallelPassesMergeSortTest,
+                         testing::ValuesIn(threePowDecreasingSizedTestCases),
+                         [](const auto& paramInfo) {
+                           return paramInfo.param.testDescription;
+                         });
+
+std::pair<std::vector<std::int32_t>, TapePool::IOStatistics>
+sortWithMergeOptions(const std::vector<std::int32_t>& values,
+                     TapeBackendType tmpBackendType, bool parallelPasses,
+                     MergePipeline* mergePipeline = nullptr) {
+  const std::string inFilename = "merge_options_in_file";
+  const std::string outFilename = "merge_options_out_file";
+  const std::string tmpDirectory = "merge_options_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  auto result = std::vector<std::int32_t>{};
+  auto stats = TapePool::IOStatistics{};
+  {
+    auto tapePool = TapePool(TapeBackendType::File, tmpBackendType);
+    {
+      auto inTape = tapePool.createTape(inFilename, values.size());
+      copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+      inTape.seek(0);
+    }
+    MergeSort(tapePool, inFilename, tmpDirectory, true,
+              RunGeneration::FixedBlocks, false, parallelPasses,
+              mergePipeline)
+        .perform(outFilename);
+    stats = tapePool.getStatistics();
+    auto outTape = tapePool.openTape(outFilename);
+    copy_n(RightReadIterator(outTape), values.size(),
+           std::back_inserter(result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+  return {result, stats};
+}
+
+TapePool::IOStatistics sortNaturalRuns(const std::vector<std::int32_t>& values,
+                                       bool increasing) {
+  const std::string inFilename = "natural_runs_in_file";
+  const std::string outFilename = "natural_runs_out_file";
+  remove_all(inFilename, outFilename);
+  auto tapePool = TapePool(TapeBackendType::File, TapeBackendType::Memory);
+  {
+    auto inTape = tapePool.createTape(inFilename, values.size());
+    copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+    inTape.seek(0);
+  }
+  const auto statsBefore = tapePool.getStatistics();
+  MergeSort(tapePool, inFilename, "natural_runs_tmp", increasing,
+            RunGeneration::NaturalRuns)
+      .perform(outFilename);
+  auto stats = tapePool.getStatistics();
+  stats.readCnt -= statsBefore.readCnt;
+  stats.writeCnt -= statsBefore.writeCnt;
+  stats.moveCnt -= statsBefore.moveCnt;
+
+  auto result = std::vector<std::int32_t>{};
+  auto sortedTape = tapePool.openTape(outFilename);
+  copy_n(RightReadIterator(sortedTape), values.size(),
+         std::back_inserter(result));
+  auto expected = values;
+  std::sort(expected.begin(), expected.end());
+  if (!increasing) {
+    std::reverse(expected.begin(), expected.end());
+  }
+  EXPECT_TRUE(eq(expected, result));
+  remove_all(inFilename, outFilename);
+  return stats;
+}
+
+/**
+ * @brief Make values of `runsCnt` increasing runs, all of the same length.
+ */
+std::vector<std::int32_t> makeIncreasingRuns(std::size_t size,
+                                             std::size_t runsCnt) {
+  auto values = std::vector<std::int32_t>(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const std::size_t runLength = size / runsCnt;
+    values[i] = static_cast<std::int32_t>((i % runLength) * runsCnt +
+                                          i / runLength);
+  }
+  return values;
+}
+
 }  // namespace
 
+TEST(NaturalMergeSort, SortedInputTakesSinglePass) {
+  auto values = std::vector<std::int32_t>(1024);
+  std::iota(values.begin(), values.end(), 0);
+  for (const bool increasing : {true, false}) {
+    const auto stats = sortNaturalRuns(values, increasing);
+    // A scan and a copy.
+    EXPECT_EQ(stats.readCnt, 2 * values.size());
+    EXPECT_EQ(stats.writeCnt, values.size());
+  }
+}
+
+TEST(NaturalMergeSort, PassesScaleWithRunsCount) {
+  // Distribution, two merge iterations and the output tape for eight runs and
+  // one more iteration for sixteen runs.
+  const auto eightRunsStats =
+      sortNaturalRuns(makeIncreasingRuns(1024, 8), true);
+  EXPECT_EQ(eightRunsStats.writeCnt, 4 * 1024);
+  const auto sixteenRunsStats =
+      sortNaturalRuns(makeIncreasingRuns(1024, 16), true);
+  EXPECT_EQ(sixteenRunsStats.writeCnt, 5 * 1024);
+}
+
+TEST(NaturalMergeSort, DecreasingRunsAreReversed) {
+  auto values = makeIncreasingRuns(1024, 8);
+  for (std::size_t runIdx = 1; runIdx < 8; runIdx += 2) {
+    std::reverse(values.begin() + static_cast<std::ptrdiff_t>(runIdx * 128),
+                 values.begin() +
+                     static_cast<std::ptrdiff_t>((runIdx + 1) * 128));
+  }
+  const auto stats = sortNaturalRuns(values, false);
+  EXPECT_LE(stats.writeCnt, 4 * 1024);
+}
+
+TEST(PreScanMergeSort, SortedInputCreatesNoTmpTapes) {
+  const std::string inFilename = "pre_scan_sorted_in_file";
+  const std::string outFilename = "pre_scan_sorted_out_file";
+  auto values = std::vector<std::int32_t>(1024);
+  std::iota(values.begin(), values.end(), 0);
+  for (const bool increasing : {true, false}) {
+    auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+    {
+      auto inTape = tapePool.createTape(inFilename, values.size());
+      copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+      inTape.seek(0);
+    }
+    const auto statsBefore = tapePool.getStatistics();
+    MergeSort(tapePool, inFilename, "pre_scan_sorted_tmp", increasing,
+              RunGeneration::FixedBlocks, true)
+        .perform(outFilename);
+    const auto stats = tapePool.getStatistics();
+    // A scan and a copy, written left if the input is reverse sorted.
+    EXPECT_EQ(stats.readCnt - statsBefore.readCnt, 2 * values.size());
+    EXPECT_EQ(stats.writeCnt - statsBefore.writeCnt, values.size());
+    EXPECT_EQ(stats.scanReadCnt, values.size());
+    EXPECT_EQ(stats.scanMoveCnt, 2 * (values.size() - 1));
+    // Only the output tape is created.
+    EXPECT_EQ(stats.createCnt - statsBefore.createCnt, 1);
+  }
+}
+
+TEST(PreScanMergeSort, FewerOperationsThanFixedBlocks) {
+  const auto values = makeIncreasingRuns(1024, 8);
+  const std::string inFilename = "pre_scan_runs_in_file";
+  const std::string outFilename = "pre_scan_runs_out_file";
+  auto stats = std::array<TapePool::IOStatistics, 2>{};
+  for (const bool preScan : {false, true}) {
+    auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+    {
+      auto inTape = tapePool.createTape(inFilename, values.size());
+      copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+      inTape.seek(0);
+    }
+    const auto statsBefore = tapePool.getStatistics();
+    MergeSort(tapePool, inFilename, "pre_scan_runs_tmp", true,
+              RunGeneration::FixedBlocks, preScan)
+        .perform(outFilename);
+    stats[preScan ? 1 : 0] = tapePool.getStatistics();
+    stats[preScan ? 1 : 0].readCnt -= statsBefore.readCnt;
+    stats[preScan ? 1 : 0].writeCnt -= statsBefore.writeCnt;
+  }
+  EXPECT_EQ(stats[0].scanReadCnt, 0);
+  EXPECT_LT(stats[1].readCnt, stats[0].readCnt);
+  EXPECT_LT(stats[1].writeCnt, stats[0].writeCnt);
+}
+
+TEST(ParallelPassesMergeSort, SameReadsAndWritesAsSequential) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({1000}, true, 43).front().values;
+  const auto [sequentialResult, sequentialStats] =
+      sortWithMergeOptions(values, TapeBackendType::Memory, false);
+  const auto [parallelResult, parallelStats] =
+      sortWithMergeOptions(values, TapeBackendType::Memory, true);
+  EXPECT_TRUE(std::is_sorted(parallelResult.begin(), parallelResult.end()));
+  EXPECT_TRUE(eq(sequentialResult, parallelResult));
+  EXPECT_EQ(sequentialStats.readCnt, parallelStats.readCnt);
+  EXPECT_EQ(sequentialStats.writeCnt, parallelStats.writeCnt);
+  EXPECT_EQ(sequentialStats.createCnt, parallelStats.createCnt);
+  EXPECT_EQ(sequentialStats.removeCnt, parallelStats.removeCnt);
+  // Other heads travel over blocks already merged by the first ones.
+  EXPECT_GT(parallelStats.moveCnt, sequentialStats.moveCnt);
+}
+
+TEST(ParallelPassesMergeSort, FileTmpTapesAreMergedSequentially) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({100}, true, 47).front().values;
+  const auto [sequentialResult, sequentialStats] =
+      sortWithMergeOptions(values, TapeBackendType::File, false);
+  const auto [parallelResult, parallelStats] =
+      sortWithMergeOptions(values, TapeBackendType::File, true);
+  EXPECT_TRUE(eq(sequentialResult, parallelResult));
+  EXPECT_EQ(sequentialStats.readCnt, parallelStats.readCnt);
+  EXPECT_EQ(sequentialStats.writeCnt, parallelStats.writeCnt);
+  EXPECT_EQ(sequentialStats.moveCnt, parallelStats.moveCnt);
+}
+
+TEST(PipelinedMergeSort, SameResultAndStatistics) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({1000}, true, 53).front().values;
+  const auto [sequentialResult, sequentialStats] =
+      sortWithMergeOptions(values, TapeBackendType::File, false);
+  for (const auto tmpBackendType :
+       {TapeBackendType::File, TapeBackendType::Memory}) {
+    auto mergePipeline = MergePipeline(3, 1);
+    const auto [pipelinedResult, pipelinedStats] = sortWithMergeOptions(
+        values, tmpBackendType, false, &mergePipeline);
+    EXPECT_GT(mergePipeline.getMergesCnt(), 0);
+    EXPECT_TRUE(eq(sequentialResult, pipelinedResult));
+    EXPECT_EQ(sequentialStats.readCnt, pipelinedStats.readCnt);
+    EXPECT_EQ(sequentialStats.writeCnt, pipelinedStats.writeCnt);
+    EXPECT_EQ(sequentialStats.moveCnt, pipelinedStats.moveCnt);
+  }
+}
+
+TEST(PipelinedMergeSort, WorksWithParallelPasses) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({1000}, true, 59).front().values;
+  const auto [parallelResult, parallelStats] =
+      sortWithMergeOptions(values, TapeBackendType::Memory, true);
+  auto mergePipeline = MergePipeline(8, 16);
+  const auto [pipelinedResult, pipelinedStats] =
+      sortWithMergeOptions(values, TapeBackendType::Memory, true,
+                           &mergePipeline);
+  EXPECT_TRUE(std::is_sorted(pipelinedResult.begin(), pipelinedResult.end()));
+  EXPECT_TRUE(eq(parallelResult, pipelinedResult));
+  EXPECT_EQ(parallelStats.readCnt, pipelinedStats.readCnt);
+  EXPECT_EQ(parallelStats.writeCnt, pipelinedStats.writeCnt);
+  EXPECT_EQ(parallelStats.moveCnt, pipelinedStats.moveCnt);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(MergeSort, BackendsKeepResultAndStatistics) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({243}, true, 42).front().values;
+
+  const auto sortWithBackend = [&values](TapeBackendType backendType) {
+    const std::string inFilename = "backends_sort_in_file";
+    const std::string outFilename = "backends_sort_out_file";
+    remove_all(inFilename, outFilename, "tmp");
+
+    auto result = std::vector<std::int32_t>{};
+    auto stats = TapePool::IOStatistics{};
+    {
+      auto tapePool = TapePool(backendType, backendType, 16);
+      auto inTape = tapePool.createTape(inFilename, values.size());
+      copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+      inTape.moveLeftRepeated(inTape.getPosition());
+
+      MergeSort(tapePool, inFilename, "tmp", true).perform(outFilename);
+      stats = tapePool.getStatistics();
+
+      auto outTape = tapePool.openTape(outFilename);
+      copy_n(RightReadIterator(outTape), values.size(),
+             std::back_inserter(result));
+    }
+    remove_all(inFilename, outFilename);
+    return std::make_pair(result, stats);
+  };
+
+  const auto [fileResult, fileStats] = sortWithBackend(TapeBackendType::File);
+  for (const auto backendType :
+       {TapeBackendType::Mmap, TapeBackendType::Async,
+        TapeBackendType::Direct}) {
+    const auto [result, stats] = sortWithBackend(backendType);
+
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+    EXPECT_TRUE(eq(fileResult, result));
+    EXPECT_EQ(fileStats.readCnt, stats.readCnt);
+    EXPECT_EQ(fileStats.writeCnt, stats.writeCnt);
+    EXPECT_EQ(fileStats.moveCnt, stats.moveCnt);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(MergeSort, MemoryTmpTapesKeepResultAndStatistics) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({243}, true, 37).front().values;
+
+  const auto sortWithTmpBackend = [&values](TapeBackendType tmpBackendType) {
+    const std::string inFilename = "memory_tmp_sort_in_file";
+    const std::string outFilename = "memory_tmp_sort_out_file";
+    const std::string tmpDirectory = "memory_tmp_sort_tmp";
+    remove_all(inFilename, outFilename, tmpDirectory);
+
+    auto result = std::vector<std::int32_t>{};
+    auto stats = TapePool::IOStatistics{};
+    {
+      auto tapePool = TapePool(TapeBackendType::File, tmpBackendType);
+      auto inTape = tapePool.createTape(inFilename, values.size());
+      copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+      inTape.moveLeftRepeated(inTape.getPosition());
+
+      {
+        auto sort = MergeSort(tapePool, inFilename, tmpDirectory, true);
+        EXPECT_EQ(std::filesystem::exists(tmpDirectory),
+                  tmpBackendType != TapeBackendType::Memory);
+        std::move(sort).perform(outFilename);
+      }
+      stats = tapePool.getStatistics();
+
+      auto outTape = tapePool.openTape(outFilename);
+      copy_n(RightReadIterator(outTape), values.size(),
+             std::back_inserter(result));
+    }
+    EXPECT_FALSE(std::filesystem::exists(tmpDirectory));
+    remove_all(inFilename, outFilename);
+    return std::make_pair(result, stats);
+  };
+
+  const auto [fileResult, fileStats] =
+      sortWithTmpBackend(TapeBackendType::File);
+  const auto [memoryResult, memoryStats] =
+      sortWithTmpBackend(TapeBackendType::Memory);
+
+  EXPECT_TRUE(std::is_sorted(memoryResult.begin(), memoryResult.end()));
+  EXPECT_TRUE(eq(fileResult, memoryResult));
+  EXPECT_EQ(fileStats.readCnt, memoryStats.readCnt);
+  EXPECT_EQ(fileStats.writeCnt, memoryStats.writeCnt);
+  EXPECT_EQ(fileStats.moveCnt, memoryStats.moveCnt);
+  EXPECT_EQ(fileStats.createCnt, memoryStats.createCnt);
+  EXPECT_EQ(fileStats.removeCnt, memoryStats.removeCnt);
+}
+
+TEST(MergeSort, SortedHeaderTapeIsCopied) {
+  const auto values =
+      generate_merge_sort_test_cases_of_sizes({100}, true, 41).front().values;
+  const std::string inFilename = "sorted_header_in_file";
+  const std::string sortedFilename = "sorted_header_sorted_file";
+  const std::string outFilename = "sorted_header_out_file";
+  const std::string tmpDirectory = "sorted_header_tmp";
+  remove_all(inFilename, sortedFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape(inFilename, values.size(), std::nullopt,
+                                      TapeFormat::WithHeader);
+    copy_n(values.begin(), values.size(), RightWriteIterator(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+    MergeSort(tapePool, inFilename, tmpDirectory, true).perform(sortedFilename);
+
+    const auto statsBefore = tapePool.getStatistics();
+    MergeSort(tapePool, sortedFilename, tmpDirectory, true)
+        .perform(outFilename);
+    const auto stats = tapePool.getStatistics();
+    EXPECT_EQ(stats.readCnt - statsBefore.readCnt, values.size());
+    EXPECT_EQ(stats.writeCnt - statsBefore.writeCnt, values.size());
+
+    auto outTape = tapePool.openTape(outFilename);
+    ASSERT_TRUE(outTape.getMetadata().has_value());
+    EXPECT_EQ(outTape.getMetadata()->order, TapeOrder::Increasing);
+    auto result = std::vector<std::int32_t>{};
+    copy_n(RightReadIterator(outTape), values.size(),
+           std::back_inserter(result));
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+    EXPECT_EQ(outTape.getMetadata()->min, result.front());
+    EXPECT_EQ(outTape.getMetadata()->max, result.back());
+  }
+  remove_all(inFilename, sortedFilename, outFilename, tmpDirectory);
+}
+
+template <class T>
+void checkTypedMergeSort(const std::string& name, std::uint32_t seed) {
+  auto generator = std::mt19937(seed);
+  auto values = std::vector<T>(333);
+  for (auto& value : values) {
+    value = static_cast<T>(generator()) - static_cast<T>(generator());
+  }
+  const auto inFilename = name + "_in_file";
+  const auto outFilename = name + "_out_file";
+  const auto tmpDirectory = name + "_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape<T>(inFilename, values.size());
+    copy_n(values.begin(), values.size(), BasicRightWriteIterator<T>(inTape));
+    inTape.moveLeftRepeated(inTape.getPosition());
+    BasicMergeSort<T>(tapePool, inFilename, tmpDirectory, false)
+        .perform(outFilename);
+
+    auto outTape = tapePool.openTape<T>(outFilename);
+    auto result = std::vector<T>{};
+    copy_n(BasicRightReadIterator<T>(outTape), values.size(),
+           std::back_inserter(result));
+    std::sort(values.begin(), values.end(), std::greater<>());
+    EXPECT_TRUE(eq(values, result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+TEST(MergeSort, SortsOtherElementTypes) {
+  checkTypedMergeSort<std::int64_t>("merge_sort_int64", 43);
+  checkTypedMergeSort<std::uint64_t>("merge_sort_uint64", 44);
+  checkTypedMergeSort<float>("merge_sort_float", 45);
+  checkTypedMergeSort<double>("merge_sort_double", 46);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
 // cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
@@ -1,7 +1,16 @@
 #include "merge_sort_tests_utils.hpp"
 
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <copy_n.hpp>
+#include <filesystem>
 #include <random>
 #include <sstream>
+#include <tape_view_read_iterators.hpp>
+#include <tape_view_write_iterators.hpp>
+
+#include "common_utils.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<MergeSortTestParam> generate_merge_sort_test_cases_of_sizes(
@@ -23,3 +32,71 @@ std::vector<MergeSortTestParam> generate_merge_sort_test_cases_of_sizes(
 
   return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::int32_t> generate_values(std::size_t size,
+                                          std::uint32_t seed) {
+  auto gen = std::mt19937(seed);
+  auto values = std::vector<std::int32_t>(size);
+  for (auto& value : values) {
+    value = static_cast<std::int32_t>(gen() % 1000);
+  }
+  return values;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void write_values_to_tape(TapePool& tapePool, const std::string& filename,
+                          const std::vector<std::int32_t>& values) {
+  auto tape = tapePool.createTape(filename, values.size());
+  if (!values.empty()) {
+    copy_n(values.begin(), values.size(), RightWriteIterator(tape));
+    tape.seek(0);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void expect_sort_like_std_sort(const std::string& name,
+                               std::vector<std::int32_t> values,
+                               bool increasing, const SortTapeFunction& sort,
+                               TapeBackendType tmpBackendType) {
+  const auto inFilename = name + "_in_file";
+  const auto outFilename = name + "_out_file";
+  const auto tmpDirectory = name + "_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  {
+    auto tapePool = TapePool(TapeBackendType::File, tmpBackendType);
+    write_values_to_tape(tapePool, inFilename, values);
+    sort(tapePool, inFilename, tmpDirectory, outFilename);
+
+    auto outTape = tapePool.openTape(outFilename);
+    auto result = std::vector<std::int32_t>{};
+    if (!values.empty()) {
+      copy_n(RightReadIterator(outTape), values.size(),
+             std::back_inserter(result));
+    }
+    if (increasing) {
+      std::sort(values.begin(), values.end());
+    } else {
+      std::sort(values.begin(), values.end(), std::greater<>());
+    }
+    EXPECT_TRUE(eq(values, result));
+  }
+  EXPECT_FALSE(std::filesystem::exists(tmpDirectory));
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TapePool::IOStatistics sort_and_get_statistics(
+    const std::string& name, const std::vector<std::int32_t>& values,
+    const SortTapeFunction& sort) {
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  const auto inFilename = name + "_in_file";
+  write_values_to_tape(tapePool, inFilename, values);
+  const auto statsBefore = tapePool.getStatistics();
+  sort(tapePool, inFilename, name + "_tmp", name + "_out_file");
+  auto stats = tapePool.getStatistics();
+  stats.readCnt -= statsBefore.readCnt;
+  stats.writeCnt -= statsBefore.writeCnt;
+  stats.moveCnt -= statsBefore.moveCnt;
+  return stats;
+}
@@ -2,7 +2,9 @@
 #define TEST_SORT_TESTS_UTILS_HPP
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <tape_pool.hpp>
 #include <vector>
 
 struct MergeSortTestParam {
@@ -15,4 +17,28 @@ std::vector<MergeSortTestParam> generate_merge_sort_test_cases_of_sizes(
     std::initializer_list<std::size_t> sizes, bool increasing,
     std::uint32_t seed);
 
+/// Sort of a tape of the pool: input, temporary directory and output names.
+using SortTapeFunction = std::function<void(
+    TapePool&, const std::string&, const std::string&, const std::string&)>;
+
+/// Values in [0, 1000), so that there are equal ones.
+std::vector<std::int32_t> generate_values(std::size_t size,
+                                          std::uint32_t seed);
+
+void write_values_to_tape(TapePool& tapePool, const std::string& filename,
+                          const std::vector<std::int32_t>& values);
+
+/// Sorts values written to "<name>_in_file" of a file backed pool into
+/// "<name>_out_file" and expects the result of std::sort and no temporary
+/// directory left.
+void expect_sort_like_std_sort(
+    const std::string& name, std::vector<std::int32_t> values,
+    bool increasing, const SortTapeFunction& sort,
+    TapeBackendType tmpBackendType = TapeBackendType::File);
+
+/// Reads, writes and moves of a sort of values with memory backed tapes.
+TapePool::IOStatistics sort_and_get_statistics(
+    const std::string& name, const std::vector<std::int32_t>& values,
+    const SortTapeFunction& sort);
+
 #endif  // TEST_GENERATE_SORT_TESTS_HPP
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <parallel_tape_sort.hpp>
+#include <string>
+#include <vector>
+
+#include "common_utils.hpp"
+#include "merge_sort_tests_utils.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
+
+namespace {
+
+struct ParallelTapeSortTestParam {
+  std::size_t size;
+  std::size_t workersCnt;
+  TapeBackendType tmpBackendType;
+  bool increasing;
+};
+
+class ParallelTapeSortTest
+    : public testing::TestWithParam<ParallelTapeSortTestParam> {};
+
+TapePool::IOStatistics sum(const std::vector<TapePool::IOStatistics>& all) {
+  auto counter = TapeOperationsCounter();
+  for (const auto& statistics : all) {
+    counter.addStatistics(statistics);
+  }
+  return counter.getStatistics();
+}
+
+TEST_P(ParallelTapeSortTest, CompareWithStdSort) {
+  const auto& params = GetParam();
+  expect_sort_like_std_sort(
+      "parallel_tape_sort", generate_values(params.size, 42),
+      params.increasing,
+      [&params](TapePool& tapePool, const std::string& inFilename,
+                const std::string& tmpDirectory,
+                const std::string& outFilename) {
+        const auto report =
+            ParallelTapeSort(tapePool, inFilename, tmpDirectory,
+                             params.increasing, 7, params.workersCnt)
+                .perform(outFilename);
+        EXPECT_EQ(report.workerStatistics.size(),
+                  std::min(params.workersCnt, params.size));
+      },
+      params.tmpBackendType);
+}
+
+auto generateParallelTapeSortParams() {
+  auto params = std::vector<ParallelTapeSortTestParam>{};
+  for (const std::size_t size : {0, 1, 2, 5, 17, 100, 1000}) {
+    for (const std::size_t workersCnt : {1, 2, 3, 8}) {
+      for (const auto tmpBackendType :
+           {TapeBackendType::File, TapeBackendType::Memory}) {
+        for (const bool increasing : {true, false}) {
+          params.push_back({size, workersCnt, tmpBackendType, increasing});
+        }
+      }
+    }
+  }
+  return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParallelTapeSorts, ParallelTapeSortTest,
+    testing::ValuesIn(generateParallelTapeSortParams()),
+    [](const auto& paramInfo) {
+      const auto& param = paramInfo.param;
+      return "size_" + std::to_string(param.size) + "_workers_" +
+             std::to_string(param.workersCnt) +
+             (param.tmpBackendType == TapeBackendType::Memory ? "_memory"
+                                                              : "_file") +
+             (param.increasing ? "_increasing" : "_decreasing");
+    });
+
+}  // namespace
+
+TEST(ParallelTapeSort, AggregateIsSumOfWorkersAndMerge) {
+  const std::string inFilename = "parallel_tape_sort_aggregate_in_file";
+  const std::string outFilename = "parallel_tape_sort_aggregate_out_file";
+  const std::string tmpDirectory = "parallel_tape_sort_aggregate_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  const auto values = generate_values(1000, 43);
+  {
+    auto tapePool = TapePool(TapeBackendType::File, TapeBackendType::Memory);
+    write_values_to_tape(tapePool, inFilename, values);
+    auto sort = ParallelTapeSort(tapePool, inFilename, tmpDirectory, true, 16,
+                                 4);
+    const auto before = tapePool.getStatistics();
+    const auto report = std::move(sort).perform(outFilename);
+    const auto after = tapePool.getStatistics();
+
+    ASSERT_EQ(report.workerStatistics.size(), 4);
+    for (const auto& workerStatistics : report.workerStatistics) {
+      // Every worker copies and sorts 250 elements.
+      EXPECT_GE(workerStatistics.readCnt, 500);
+      EXPECT_GE(workerStatistics.writeCnt, 500);
+    }
+    // The final merge reads and writes every element once.
+    EXPECT_EQ(report.mergeStatistics.readCnt, values.size());
+    EXPECT_EQ(report.mergeStatistics.writeCnt, values.size());
+    EXPECT_EQ(report.mergeStatistics.openCnt, 4);
+    EXPECT_EQ(report.mergeStatistics.removeCnt, 4);
+
+    auto expected = sum(report.workerStatistics);
+    auto counter = TapeOperationsCounter();
+    counter.addStatistics(expected);
+    counter.addStatistics(report.mergeStatistics);
+    expected = counter.getStatistics();
+    const auto& aggregate = report.aggregateStatistics;
+    EXPECT_EQ(aggregate.readCnt, expected.readCnt);
+    EXPECT_EQ(aggregate.writeCnt, expected.writeCnt);
+    EXPECT_EQ(aggregate.moveCnt, expected.moveCnt);
+    EXPECT_EQ(aggregate.createCnt, expected.createCnt);
+    EXPECT_EQ(aggregate.removeCnt, expected.removeCnt);
+    // Worker statistics are added to the calling pool.
+    EXPECT_EQ(after.readCnt - before.readCnt, aggregate.readCnt);
+    EXPECT_EQ(after.writeCnt - before.writeCnt, aggregate.writeCnt);
+    EXPECT_EQ(after.moveCnt - before.moveCnt, aggregate.moveCnt);
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+TEST(ParallelTapeSort, SingleWorkerSortsWholeTape) {
+  const std::string inFilename = "parallel_tape_sort_single_in_file";
+  const std::string outFilename = "parallel_tape_sort_single_out_file";
+  const std::string tmpDirectory = "parallel_tape_sort_single_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  const auto values = generate_values(100, 44);
+  {
+    auto tapePool = TapePool();
+    write_values_to_tape(tapePool, inFilename, values);
+    const auto report =
+        ParallelTapeSort(tapePool, inFilename, tmpDirectory, true, 10, 1)
+            .perform(outFilename);
+    ASSERT_EQ(report.workerStatistics.size(), 1);
+    // Copy of the segment and reads of the merge sort.
+    EXPECT_GT(report.workerStatistics[0].readCnt, values.size());
+    EXPECT_EQ(report.mergeStatistics.readCnt, values.size());
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+TEST(ParallelTapeSort, ZeroWorkersThrow) {
+  const std::string inFilename = "parallel_tape_sort_zero_workers_in_file";
+  remove_all(inFilename);
+  {
+    auto tapePool = TapePool();
+    write_values_to_tape(tapePool, inFilename, {3, 1, 2});
+    EXPECT_THROW(ParallelTapeSort(tapePool, inFilename, "tmp", true, 2, 0),
+                 std::logic_error);
+  }
+  remove_all(inFilename);
+}
+
+TEST(ParallelTapeSort, MemoryBackendThrows) {
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  write_values_to_tape(tapePool, "parallel_tape_sort_memory_in", {3, 1, 2});
+  EXPECT_THROW(ParallelTapeSort(tapePool, "parallel_tape_sort_memory_in",
+                                "tmp", true, 2, 2),
+               std::invalid_argument);
+}
+
+TEST(ParallelTapeSort, DirectAndAsyncBackendsThrow) {
+  const std::string inFilename = "parallel_tape_sort_direct_in_file";
+  remove_all(inFilename);
+  {
+    auto tapePool = TapePool();
+    write_values_to_tape(tapePool, inFilename, {3, 1, 2});
+  }
+  for (const auto backendType :
+       {TapeBackendType::Direct, TapeBackendType::Async}) {
+    auto tapePool = TapePool(backendType, TapeBackendType::Memory);
+    EXPECT_THROW(ParallelTapeSort(tapePool, inFilename, "tmp", true, 2, 2),
+                 std::invalid_argument);
+  }
+  remove_all(inFilename);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
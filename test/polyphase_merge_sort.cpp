@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <copy_n.hpp>
+#include <merge_sort.hpp>
+#include <polyphase_merge_sort.hpp>
+#include <string>
+#include <vector>
+
+#include "common_utils.hpp"
+#include "merge_sort_tests_utils.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
+
+namespace {
+
+struct PolyphaseMergeSortTestParam {
+  std::size_t size;
+  std::size_t tapesCnt;
+  std::size_t initialBlockSize;
+  bool increasing;
+};
+
+class PolyphaseMergeSortTest
+    : public testing::TestWithParam<PolyphaseMergeSortTestParam> {};
+
+TEST_P(PolyphaseMergeSortTest, CompareWithStdSort) {
+  const auto& params = GetParam();
+  expect_sort_like_std_sort(
+      "polyphase_merge_sort", generate_values(params.size, 42),
+      params.increasing,
+      [&params](TapePool& tapePool, const std::string& inFilename,
+                const std::string& tmpDirectory,
+                const std::string& outFilename) {
+        PolyphaseMergeSort(tapePool, inFilename, tmpDirectory,
+                           params.increasing, params.tapesCnt,
+                           params.initialBlockSize)
+            .perform(outFilename);
+      });
+}
+
+auto generatePolyphaseMergeSortParams() {
+  auto params = std::vector<PolyphaseMergeSortTestParam>{};
+  for (const std::size_t size : {0, 1, 2, 3, 5, 8, 13, 14, 100, 1000}) {
+    for (const std::size_t tapesCnt : {3, 4, 6}) {
+      for (const std::size_t initialBlockSize : {1, 5}) {
+        for (const bool increasing : {true, false}) {
+          params.push_back({size, tapesCnt, initialBlockSize, increasing});
+        }
+      }
+    }
+  }
+  return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PolyphaseMergeSorts, PolyphaseMergeSortTest,
+    testing::ValuesIn(generatePolyphaseMergeSortParams()),
+    [](const auto& paramInfo) {
+      const auto& param = paramInfo.param;
+      return "size_" + std::to_string(param.size) + "_tapes_" +
+             std::to_string(param.tapesCnt) + "_block_" +
+             std::to_string(param.initialBlockSize) +
+             (param.increasing ? "_increasing" : "_decreasing");
+    });
+
+}  // namespace
+
+TEST(PolyphaseMergeSort, UsesThreeWorkingTapes) {
+  const std::string inFilename = "polyphase_three_working_tapes_in_file";
+  const std::string outFilename = "polyphase_three_working_tapes_out_file";
+  const std::string tmpDirectory = "polyphase_three_working_tapes_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  const auto values = generate_values(1000, 43);
+  {
+    auto tapePool = TapePool();
+    write_values_to_tape(tapePool, inFilename, values);
+    const auto statsBefore = tapePool.getStatistics();
+    PolyphaseMergeSort(tapePool, inFilename, tmpDirectory, true)
+        .perform(outFilename);
+    const auto stats = tapePool.getStatistics();
+    // Two temporary tapes and the output one.
+    EXPECT_EQ(stats.createCnt - statsBefore.createCnt, 3);
+    auto result = std::vector<std::int32_t>{};
+    auto outTape = tapePool.openTape(outFilename);
+    copy_n(RightReadIterator(outTape), values.size(),
+           std::back_inserter(result));
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+}
+
+TEST(PolyphaseMergeSort, FewerOperationsThanMergeSort) {
+  const auto values = generate_values(4096, 44);
+  const auto sort = [&](std::size_t tapesCnt) {
+    return sort_and_get_statistics(
+        "polyphase_fewer_operations", values,
+        [tapesCnt](TapePool& tapePool, const std::string& inFilename,
+                   const std::string& tmpDirectory,
+                   const std::string& outFilename) {
+          if (tapesCnt == 0) {
+            MergeSort(tapePool, inFilename, tmpDirectory, true)
+                .perform(outFilename);
+          } else {
+            PolyphaseMergeSort(tapePool, inFilename, tmpDirectory, true,
+                               tapesCnt)
+                .perform(outFilename);
+          }
+        });
+  };
+  const auto mergeSortStats = sort(0);
+  const auto polyphaseStats = sort(4);
+  EXPECT_EQ(polyphaseStats.readCnt, polyphaseStats.writeCnt);
+  EXPECT_LT(polyphaseStats.readCnt, mergeSortStats.readCnt);
+  EXPECT_LT(polyphaseStats.moveCnt, mergeSortStats.moveCnt);
+}
+
+TEST(PolyphaseMergeSort, NeedsThreeTapes) {
+  constexpr auto filename = "polyphase_needs_three_tapes";
+  remove_all(filename);
+  {
+    auto tapePool = TapePool();
+    tapePool.createTape(filename, 1);
+    EXPECT_THROW(PolyphaseMergeSort(tapePool, filename, "tmp", true, 2),
+                 PolyphaseMergeSort::InvalidTapesCnt);
+  }
+  remove_all(filename);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
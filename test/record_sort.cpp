@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <copy_n.hpp>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <record_sort.hpp>
+#include <vector>
+
+#include "common_utils.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
+
+namespace {
+
+using Record = KeyedRecord<56>;
+
+std::vector<Record> sortRecords(const std::vector<Record>& values,
+                                RecordSortStrategy strategy, bool increasing) {
+  const std::string inFilename = "record_sort_in_file";
+  const std::string outFilename = "record_sort_out_file";
+  const std::string tmpDirectory = "record_sort_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  auto result = std::vector<Record>{};
+  {
+    auto tapePool = TapePool();
+    auto inTape = tapePool.createTape<Record>(inFilename, values.size());
+    copy_n(values.begin(), values.size(),
+           BasicRightWriteIterator<Record>(inTape));
+    inTape.seek(0);
+    RecordSort<56>(tapePool, inFilename, tmpDirectory, increasing,
+                   10 * sizeof(Record))
+        .perform(outFilename, strategy);
+
+    EXPECT_FALSE(std::filesystem::exists(outFilename + "_tags"));
+    EXPECT_FALSE(std::filesystem::exists(outFilename + "_sorted_tags"));
+    auto outTape = tapePool.openTape<Record>(outFilename);
+    copy_n(BasicRightReadIterator<Record>(outTape), values.size(),
+           std::back_inserter(result));
+  }
+  remove_all(inFilename, outFilename, tmpDirectory);
+  return result;
+}
+
+std::vector<Record> generateRecords(std::size_t size, std::uint32_t seed) {
+  auto generator = std::mt19937(seed);
+  auto values = std::vector<Record>(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i].key = static_cast<std::int64_t>(generator() % 50) - 25;
+    std::memcpy(values[i].payload.data(), &i, sizeof(i));
+  }
+  return values;
+}
+
+std::size_t getIndex(const Record& record) {
+  auto index = std::size_t{};
+  std::memcpy(&index, record.payload.data(), sizeof(index));
+  return index;
+}
+
+}  // namespace
+
+TEST(RecordSort, StrategiesKeepPayloads) {
+  const auto values = generateRecords(333, 42);
+  for (const bool increasing : {true, false}) {
+    for (const auto strategy :
+         {RecordSortStrategy::FullRecords, RecordSortStrategy::TagSort}) {
+      const auto result = sortRecords(values, strategy, increasing);
+      ASSERT_EQ(result.size(), values.size());
+      EXPECT_TRUE(increasing
+                      ? std::is_sorted(result.begin(), result.end())
+                      : std::is_sorted(result.rbegin(), result.rend()));
+      auto indices = std::vector<std::size_t>{};
+      for (const auto& record : result) {
+        EXPECT_EQ(record.key, values[getIndex(record)].key);
+        indices.push_back(getIndex(record));
+      }
+      std::sort(indices.begin(), indices.end());
+      EXPECT_TRUE(std::adjacent_find(indices.begin(), indices.end()) ==
+                  indices.end());
+    }
+  }
+}
+
+TEST(RecordSort, IncreasingTagSortIsStable) {
+  const auto values = generateRecords(200, 43);
+  const auto result =
+      sortRecords(values, RecordSortStrategy::TagSort, true);
+  auto expected = values;
+  std::stable_sort(expected.begin(), expected.end());
+  ASSERT_EQ(result.size(), expected.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(getIndex(result[i]), getIndex(expected[i]));
+  }
+}
+
+TEST(RecordSort, MemoryLimitMustFitRecord) {
+  auto tapePool = TapePool();
+  EXPECT_THROW(RecordSort<56>(tapePool, "record_sort_unused", "tmp", true,
+                              sizeof(Record) - 1),
+               std::invalid_argument);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <copy_n.hpp>
+#include <improved_merge_sort.hpp>
+#include <limits>
+#include <merge_sort.hpp>
+#include <random>
+#include <sort_planner.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common_utils.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
+
+namespace {
+
+constexpr auto unitTimes = SortPlanner::OperationTimes{1, 1, 1, 1, 1, 1, 1};
+
+struct SortPlannerTestParam {
+  std::size_t size;
+  std::size_t memoryLimit;
+};
+
+class SortPlannerTest : public testing::TestWithParam<SortPlannerTestParam> {
+};
+
+/**
+ * @brief Sort a tape which is closed before the sort and get statistics of
+ * the sort only.
+ */
+TapePool::IOStatistics sortAndGetStatistics(
+    SortPlanner::Algorithm algorithm, std::size_t size,
+    std::size_t memoryLimit) {
+  const std::string inFilename = "sort_planner_in_file";
+  const std::string outFilename = "sort_planner_out_file";
+  const std::string tmpDirectory = "sort_planner_tmp";
+  remove_all(inFilename, outFilename, tmpDirectory);
+  auto generator = std::mt19937(static_cast<std::uint32_t>(size));
+  auto tapePool = TapePool(TapeBackendType::File, TapeBackendType::Memory);
+  {
+    auto inTape = tapePool.createTape(inFilename, size);
+    for (std::size_t i = 0; i < size; ++i) {
+      if (i != 0) {
+        inTape.moveRight();
+      }
+      inTape.write(static_cast<std::int32_t>(generator()));
+    }
+    tapePool.closeTape(inFilename);
+  }
+  const auto before = tapePool.getStatistics();
+  if (algorithm == SortPlanner::Algorithm::MergeSort) {
+    MergeSort(tapePool, inFilename, tmpDirectory, true).perform(outFilename);
+  } else {
+    ImprovedMergeSortImproved(tapePool, inFilename, tmpDirectory, false,
+                              memoryLimit)
+        .perform(outFilename);
+  }
+  const auto after = tapePool.getStatistics();
+  remove_all(inFilename, outFilename, tmpDirectory);
+  auto stats = TapePool::IOStatistics{};
+  stats.readCnt = after.readCnt - before.readCnt;
+  stats.writeCnt = after.writeCnt - before.writeCnt;
+  stats.moveCnt = after.moveCnt - before.moveCnt;
+  stats.createCnt = after.createCnt - before.createCnt;
+  stats.openCnt = after.openCnt - before.openCnt;
+  stats.closeCnt = after.closeCnt - before.closeCnt;
+  stats.removeCnt = after.removeCnt - before.removeCnt;
+  return stats;
+}
+
+void expectEqualStatistics(const TapePool::IOStatistics& expected,
+                           const TapePool::IOStatistics& actual) {
+  EXPECT_EQ(expected.readCnt, actual.readCnt);
+  EXPECT_EQ(expected.writeCnt, actual.writeCnt);
+  EXPECT_EQ(expected.moveCnt, actual.moveCnt);
+  EXPECT_EQ(expected.createCnt, actual.createCnt);
+  EXPECT_EQ(expected.openCnt, actual.openCnt);
+  EXPECT_EQ(expected.closeCnt, actual.closeCnt);
+  EXPECT_EQ(expected.removeCnt, actual.removeCnt);
+}
+
+TEST_P(SortPlannerTest, PredictionsMatchRealRuns) {
+  const auto& params = GetParam();
+  const auto planner =
+      SortPlanner(params.size, params.memoryLimit, 6, unitTimes);
+  for (const auto& plan : planner.getPlans()) {
+    const auto actual =
+        sortAndGetStatistics(plan.algorithm, params.size, params.memoryLimit);
+    expectEqualStatistics(plan.statistics, actual);
+    EXPECT_EQ(plan.time, SortPlanner::calcTime(actual, unitTimes));
+  }
+}
+
+std::vector<SortPlannerTestParam> generateSortPlannerTestParams() {
+  auto params = std::vector<SortPlannerTestParam>{};
+  for (const std::size_t size :
+       {0, 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 31, 33, 100, 243, 1000}) {
+    for (const std::size_t memoryLimit : {1, 2, 3, 5, 16, 64}) {
+      params.push_back({size, memoryLimit});
+    }
+  }
+  return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SizesAndLimits, SortPlannerTest,
+    testing::ValuesIn(generateSortPlannerTestParams()),
+    [](const auto& paramInfo) {
+      return "size_" + std::to_string(paramInfo.param.size) + "_memory_" +
+             std::to_string(paramInfo.param.memoryLimit);
+    });
+
+}  // namespace
+
+TEST(SortPlanner, ChoosesImprovedMergeSortWithMemory) {
+  const auto planner = SortPlanner(1000, 64, 6, unitTimes);
+  ASSERT_EQ(planner.getPlans().size(), 2);
+  EXPECT_EQ(planner.choose().algorithm,
+            SortPlanner::Algorithm::ImprovedMergeSort);
+  EXPECT_LT(planner.choose().time, planner.getPlans().front().time);
+}
+
+TEST(SortPlanner, ChoosesMergeSortWithoutMemory) {
+  const auto planner = SortPlanner(1000, 0, 6, unitTimes);
+  ASSERT_EQ(planner.getPlans().size(), 1);
+  EXPECT_EQ(planner.choose().algorithm, SortPlanner::Algorithm::MergeSort);
+}
+
+TEST(SortPlanner, PrefersMergeSortOnTie) {
+  // A heap of a single element makes the same blocks as MergeSort.
+  const auto planner = SortPlanner(1000, 1, 6, unitTimes);
+  EXPECT_EQ(planner.getPlans()[0].time, planner.getPlans()[1].time);
+  EXPECT_EQ(planner.choose().algorithm, SortPlanner::Algorithm::MergeSort);
+}
+
+TEST(SortPlanner, TimesWeightOperations) {
+  const auto times = SortPlanner::OperationTimes{0, 0, 1, 0, 0, 0, 0};
+  const auto planner = SortPlanner(1000, 64, 6, times);
+  for (const auto& plan : planner.getPlans()) {
+    EXPECT_EQ(plan.time, plan.statistics.writeCnt);
+  }
+}
+
+TEST(SortPlanner, NeedsSixTapes) {
+  EXPECT_THROW(SortPlanner(1000, 64, 5, unitTimes),
+               SortPlanner::NotEnoughTapes);
+}
+
+TEST(SortPlanner, PredictionsMatchRealRunsOfAllSmallSizes) {
+  for (std::size_t size = 0; size <= 70; ++size) {
+    for (std::size_t memoryLimit = 1; memoryLimit <= 9; ++memoryLimit) {
+      const auto planner = SortPlanner(size, memoryLimit, 6, unitTimes);
+      for (const auto& plan : planner.getPlans()) {
+        SCOPED_TRACE(testing::Message()
+                     << "size " << size << ", memory " << memoryLimit << ", "
+                     << SortPlanner::getName(plan.algorithm));
+        expectEqualStatistics(
+            plan.statistics,
+            sortAndGetStatistics(plan.algorithm, size, memoryLimit));
+      }
+    }
+  }
+}
+
+TEST(SortPlanner, PredictsHugeInputs) {
+  // Four pebibytes of 32 bit elements.
+  constexpr std::size_t size = std::size_t{1} << 50;
+  const auto planner = SortPlanner(size, std::size_t{1} << 30, 6, unitTimes);
+  // Initial blocks, merge iterations while doubled blocks are shorter than
+  // the input and the last merge.
+  const auto& mergeSortPlan =
+      planner.getPlan(SortPlanner::Algorithm::MergeSort);
+  EXPECT_EQ(mergeSortPlan.statistics.readCnt, size * (1 + 49 + 1));
+  EXPECT_EQ(mergeSortPlan.statistics.writeCnt, size * (1 + 49 + 1));
+  const auto& improvedPlan =
+      planner.getPlan(SortPlanner::Algorithm::ImprovedMergeSort);
+  EXPECT_EQ(improvedPlan.statistics.readCnt, size * (1 + 19 + 1));
+  EXPECT_EQ(improvedPlan.statistics.createCnt, 5);
+  EXPECT_EQ(planner.choose().algorithm,
+            SortPlanner::Algorithm::ImprovedMergeSort);
+}
+
+TEST(SortPlanner, ReportsOverflow) {
+  EXPECT_THROW(SortPlanner(std::numeric_limits<std::size_t>::max(), 1, 6,
+                           unitTimes),
+               std::overflow_error);
+  constexpr auto slowTimes = SortPlanner::OperationTimes{
+      1, std::numeric_limits<std::size_t>::max() / 2, 1, 1, 1, 1, 1};
+  EXPECT_THROW(SortPlanner(1000, 1, 6, slowTimes), std::overflow_error);
+}
+
+TEST(SortPlanner, UnavailableSortHasNoPlan) {
+  const auto planner = SortPlanner(1000, 0, 6, unitTimes);
+  EXPECT_THROW(
+      std::ignore = planner.getPlan(SortPlanner::Algorithm::ImprovedMergeSort),
+      SortPlanner::NotAvailable);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
+// cppcoreguidelines-avoid-magic-numbers, cert-err58-cpp)
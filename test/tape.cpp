@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cassert>
 #include <filesystem>
+#include <fstream>
 #include <tape.hpp>
+#include <vector>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
 // cert-err58-cpp)
@@ -69,5 +72,514 @@ TEST(Tape, MovingRightOnceAfterLastBreaks) {
   std::filesystem::remove(filename);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, MmapConstructNew) {
+  constexpr auto filename = "mmap_new_constructed_tape";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = Tape(filename, 4, TapeBackendType::Mmap);
+    EXPECT_EQ(std::filesystem::file_size(filename), 16);
+    EXPECT_EQ(tape.getSize(), 4);
+  }
+  EXPECT_TRUE(std::filesystem::exists(filename));
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, MmapWriteAndReopen) {
+  constexpr auto filename = "mmap_write_and_reopen";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = Tape(filename, 3, TapeBackendType::Mmap);
+    tape.write(42);
+    tape.moveRight();
+    tape.write(-37);
+    tape.moveRight();
+    tape.write(73);
+    EXPECT_EQ(tape.read(), 73);
+    tape.moveLeft();
+    EXPECT_EQ(tape.read(), -37);
+  }
+  {
+    auto tape = Tape(filename);
+    EXPECT_EQ(tape.getSize(), 3);
+    EXPECT_EQ(tape.read(), 42);
+    tape.moveRight();
+    EXPECT_EQ(tape.read(), -37);
+    tape.moveRight();
+    EXPECT_EQ(tape.read(), 73);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, MmapMovingOutOfRangeBreaks) {
+  constexpr auto filename = "mmap_moving_out_of_range_breaks";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+
+  {
+    auto tape = Tape(filename, 2, TapeBackendType::Mmap);
+    EXPECT_THROW(tape.moveLeft(), Tape::LeftOutOfRange);
+    tape.moveRight();
+    EXPECT_THROW(tape.moveRight(), Tape::RightOutOfRange);
+  }
+
+  EXPECT_TRUE(std::filesystem::exists(filename));
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, MemoryTapeTouchesNoFile) {
+  constexpr auto filename = "memory_tape_touches_no_file";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = Tape(filename, 3, TapeBackendType::Memory);
+    EXPECT_FALSE(std::filesystem::exists(filename));
+    EXPECT_EQ(tape.getSize(), 3);
+    EXPECT_EQ(tape.read(), 0);
+    tape.write(42);
+    tape.moveRight();
+    tape.write(-37);
+    tape.moveLeft();
+    EXPECT_EQ(tape.read(), 42);
+    tape.moveRight();
+    EXPECT_EQ(tape.read(), -37);
+    tape.moveRight();
+    EXPECT_THROW(tape.moveRight(), Tape::RightOutOfRange);
+  }
+  EXPECT_FALSE(std::filesystem::exists(filename));
+  EXPECT_THROW(Tape(filename, std::nullopt, TapeBackendType::Memory),
+               std::invalid_argument);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, WriteToOpenedFileOverwritesCells) {
+  constexpr auto filename = "write_to_opened_file_overwrites_cells";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = Tape(filename, 2);
+    tape.write(1);
+    tape.moveRight();
+    tape.write(2);
+  }
+  {
+    auto tape = Tape(filename);
+    tape.write(42);
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), 8);
+  {
+    auto tape = Tape(filename);
+    EXPECT_EQ(tape.read(), 42);
+    tape.moveRight();
+    EXPECT_EQ(tape.read(), 2);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, ReadWindowServesSequentialScans) {
+  constexpr auto filename = "read_window_serves_sequential_scans";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+
+  {
+    auto tape = Tape(filename, 100, TapeBackendType::File, 16);
+    for (std::int32_t i = 0; i < 100; ++i) {
+      tape.write(i);
+      if (i != 99) {
+        tape.moveRight();
+      }
+    }
+    for (std::int32_t i = 99; i >= 0; --i) {
+      EXPECT_EQ(tape.read(), i);
+      if (i != 0) {
+        tape.moveLeft();
+      }
+    }
+    // The head came from the left, so the first window is [96, 100). Then
+    // leftward windows end on aligned borders: [80, 96), [64, 80) ... [0, 16).
+    EXPECT_EQ(tape.getCacheStatistics().missCnt, 7);
+    EXPECT_EQ(tape.getCacheStatistics().hitCnt, 93);
+
+    tape.write(-1);
+    EXPECT_EQ(tape.read(), -1);
+    for (std::int32_t i = 1; i < 100; ++i) {
+      tape.moveRight();
+      EXPECT_EQ(tape.read(), i);
+    }
+    EXPECT_EQ(tape.getCacheStatistics().missCnt, 13);
+  }
+
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, WriteBufferFlushesRunsInBothDirections) {
+  constexpr auto filename = "write_buffer_flushes_runs_in_both_directions";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+
+  {
+    auto tape = Tape(filename, 10, TapeBackendType::File, 0, 4);
+    for (std::int32_t i = 0; i < 10; ++i) {
+      tape.write(i);
+      if (i != 9) {
+        tape.moveRight();
+      }
+    }
+    EXPECT_EQ(tape.read(), 9);
+    tape.moveLeft();
+    tape.write(-8);
+    tape.moveLeft();
+    tape.write(-7);
+    EXPECT_EQ(tape.read(), -7);
+  }
+
+  {
+    auto file = std::ifstream(filename, std::ios_base::binary);
+    auto cells = std::array<std::int32_t, 10>{};
+    file.read(reinterpret_cast<char*>(cells.data()),  // NOLINT
+              sizeof(cells));
+    const auto expected =
+        std::array<std::int32_t, 10>{0, 1, 2, 3, 4, 5, 6, -7, -8, 9};
+    EXPECT_EQ(cells, expected);
+  }
+
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, BlocksInBothDirections) {
+  constexpr auto filename = "blocks_in_both_directions";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+
+  for (const auto backendType : {TapeBackendType::File, TapeBackendType::Mmap,
+                                 TapeBackendType::Memory}) {
+    auto tape = Tape(filename, 6, backendType, 4, 2);
+    const auto written = std::array<std::int32_t, 4>{1, 2, 3, 4};
+    tape.writeBlock(written, Direction::Right);
+    EXPECT_EQ(tape.getPosition(), 3);
+    EXPECT_EQ(tape.read(), 4);
+
+    tape.moveRight();
+    tape.moveRight();
+    const auto writtenLeft = std::array<std::int32_t, 3>{6, 5, 42};
+    tape.writeBlock(writtenLeft, Direction::Left);
+    EXPECT_EQ(tape.getPosition(), 3);
+
+    auto readLeft = std::array<std::int32_t, 4>{};
+    tape.moveRight();
+    tape.moveRight();
+    tape.readBlock(readLeft, Direction::Left);
+    EXPECT_EQ(readLeft, (std::array<std::int32_t, 4>{6, 5, 42, 3}));
+    EXPECT_EQ(tape.getPosition(), 2);
+
+    auto readRight = std::array<std::int32_t, 6>{};
+    tape.moveLeft();
+    tape.moveLeft();
+    tape.readBlock(readRight, Direction::Right);
+    EXPECT_EQ(readRight, (std::array<std::int32_t, 6>{1, 2, 3, 42, 5, 6}));
+    EXPECT_EQ(tape.getPosition(), 5);
+
+    EXPECT_THROW(tape.readBlock(readLeft, Direction::Right),
+                 Tape::RightOutOfRange);
+    while (tape.getPosition() != 0) {
+      tape.moveLeft();
+    }
+    EXPECT_THROW(tape.writeBlock(written, Direction::Left),
+                 Tape::LeftOutOfRange);
+    EXPECT_EQ(tape.getPosition(), 0);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, SequentialAccessSeeksOnce) {
+  constexpr auto filename = "sequential_access_seeks_once";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = Tape(filename, 8, TapeBackendType::File, 0, 0);
+    for (std::int32_t i = 0; i < 8; ++i) {
+      tape.write(i);
+      if (i != 7) {
+        tape.moveRight();
+      }
+    }
+    EXPECT_EQ(tape.getCacheStatistics().seekCnt, 1);
+
+    // Reading in place after a write needs a seek, reading on does not.
+    EXPECT_EQ(tape.read(), 7);
+    EXPECT_EQ(tape.getCacheStatistics().seekCnt, 2);
+    for (std::int32_t i = 6; i >= 0; --i) {
+      tape.moveLeft();
+      EXPECT_EQ(tape.read(), i);
+    }
+    EXPECT_EQ(tape.getCacheStatistics().seekCnt, 9);
+
+    tape.moveRight();
+    EXPECT_EQ(tape.read(), 1);
+    EXPECT_EQ(tape.getCacheStatistics().seekCnt, 9);
+    tape.moveRight();
+    EXPECT_EQ(tape.read(), 2);
+    EXPECT_EQ(tape.getCacheStatistics().seekCnt, 9);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, AsyncBackendKeepsCellsAcrossChunks) {
+  constexpr auto filename = "async_backend_keeps_cells_across_chunks";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  constexpr std::size_t size = 50;
+  auto expected = std::vector<std::int32_t>(size);
+  {
+    auto tape = Tape(filename, size, TapeBackendType::Async, 4);
+    for (std::size_t i = 0; i < size; ++i) {
+      expected[i] = static_cast<std::int32_t>(i * i);
+      tape.write(expected[i]);
+      if (i + 1 != size) {
+        tape.moveRight();
+      }
+    }
+    // Overwrite every third cell on the way back.
+    for (std::size_t i = size - 1; i > 0; --i) {
+      if (i % 3 == 0) {
+        expected[i] = -static_cast<std::int32_t>(i);
+        tape.write(expected[i]);
+      }
+      EXPECT_EQ(tape.read(), expected[i]);
+      tape.moveLeft();
+    }
+    tape.flush();
+    const auto stats = tape.getCacheStatistics();
+    EXPECT_GT(stats.hitCnt, 0);
+  }
+  {
+    auto tape = Tape(filename, std::nullopt, TapeBackendType::Async, 8);
+    EXPECT_EQ(tape.getSize(), size);
+    for (std::size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(tape.read(), expected[i]);
+      if (i + 1 != size) {
+        tape.moveRight();
+      }
+    }
+  }
+  {
+    auto tape = Tape(filename);
+    tape.seek(size - 1);
+    EXPECT_EQ(tape.read(), expected[size - 1]);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, DirectBackendKeepsExactFileSize) {
+  constexpr auto filename = "direct_backend_keeps_exact_file_size";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  constexpr std::size_t size = 3001;
+  {
+    auto tape = Tape(filename, size, TapeBackendType::Direct, 1024);
+    for (std::size_t i = 0; i < size; ++i) {
+      tape.write(static_cast<std::int32_t>(i));
+      if (i + 1 != size) {
+        tape.moveRight();
+      }
+    }
+    for (std::size_t i = size - 1; i > 0; --i) {
+      EXPECT_EQ(tape.read(), static_cast<std::int32_t>(i));
+      tape.moveLeft();
+    }
+    tape.write(-1);
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), size * Tape::cellSize);
+  {
+    auto tape = Tape(filename);
+    EXPECT_EQ(tape.read(), -1);
+    tape.seek(size - 1);
+    EXPECT_EQ(tape.read(), static_cast<std::int32_t>(size - 1));
+    tape.seek(1025);
+    EXPECT_EQ(tape.read(), 1025);
+  }
+  {
+    auto tape = Tape(filename, std::nullopt, TapeBackendType::Direct);
+    EXPECT_EQ(tape.getSize(), size);
+    tape.seek(2048);
+    EXPECT_EQ(tape.read(), 2048);
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), size * Tape::cellSize);
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, DirectBackendDoesNotResizeOpenedFile) {
+  constexpr auto filename = "direct_backend_does_not_resize_opened_file";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  constexpr std::size_t size = 1500;
+  {
+    auto tape = Tape(filename, size);
+    for (std::size_t i = 0; i + 1 < size; ++i) {
+      tape.write(static_cast<std::int32_t>(i));
+      tape.moveRight();
+    }
+    tape.write(static_cast<std::int32_t>(size - 1));
+  }
+  {
+    auto tape = Tape(filename, std::nullopt, TapeBackendType::Direct, 256);
+    EXPECT_EQ(std::filesystem::file_size(filename), size * Tape::cellSize);
+    tape.seek(size - 1);
+    EXPECT_EQ(tape.read(), static_cast<std::int32_t>(size - 1));
+    tape.write(-2);
+    tape.seek(0);
+    tape.write(-1);
+    tape.flush();
+    EXPECT_EQ(std::filesystem::file_size(filename), size * Tape::cellSize);
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), size * Tape::cellSize);
+  {
+    auto tape = Tape(filename);
+    EXPECT_EQ(tape.read(), -1);
+    tape.seek(1);
+    EXPECT_EQ(tape.read(), 1);
+    tape.seek(size - 1);
+    EXPECT_EQ(tape.read(), -2);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, HeaderKeepsMetadataAcrossReopen) {
+  constexpr auto filename = "header_keeps_metadata_across_reopen";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  for (const auto backendType :
+       {TapeBackendType::File, TapeBackendType::Mmap, TapeBackendType::Async,
+        TapeBackendType::Direct}) {
+    {
+      auto tape = Tape(filename, 4, backendType, Tape::defaultReadWindowSize,
+                       Tape::defaultWriteBufferSize, TapeFormat::WithHeader);
+      ASSERT_TRUE(tape.getMetadata().has_value());
+      EXPECT_EQ(tape.getMetadata()->order, TapeOrder::Unknown);
+      const auto values = std::array<std::int32_t, 4>{-3, 1, 5, 7};
+      tape.writeBlock(values, Direction::Right);
+      tape.markSorted(TapeOrder::Increasing);
+    }
+    EXPECT_EQ(std::filesystem::file_size(filename), 4096 + 4 * Tape::cellSize);
+    {
+      auto tape = Tape(filename, std::nullopt, backendType);
+      EXPECT_EQ(tape.getSize(), 4);
+      ASSERT_TRUE(tape.getMetadata().has_value());
+      EXPECT_EQ(tape.getMetadata()->elementsCnt, 4);
+      EXPECT_EQ(tape.getMetadata()->order, TapeOrder::Increasing);
+      EXPECT_EQ(tape.getMetadata()->min, -3);
+      EXPECT_EQ(tape.getMetadata()->max, 7);
+      EXPECT_EQ(tape.read(), -3);
+      tape.seek(3);
+      EXPECT_EQ(tape.read(), 7);
+      tape.write(0);
+      EXPECT_EQ(tape.getMetadata()->order, TapeOrder::Unknown);
+      EXPECT_FALSE(tape.getMetadata()->min.has_value());
+    }
+    {
+      auto tape = Tape(filename);
+      EXPECT_EQ(tape.getMetadata()->order, TapeOrder::Unknown);
+      tape.seek(3);
+      EXPECT_EQ(tape.read(), 0);
+    }
+    std::filesystem::remove(filename);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, RawTapeHasNoMetadata) {
+  constexpr auto filename = "raw_tape_has_no_metadata";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = Tape(filename, 2);
+    tape.markSorted(TapeOrder::Increasing);
+    EXPECT_FALSE(tape.getMetadata().has_value());
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), 2 * Tape::cellSize);
+  EXPECT_FALSE(Tape(filename).getMetadata().has_value());
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, TypedCellsRoundTrip) {
+  constexpr auto filename = "typed_cells_round_trip";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = BasicTape<double>(filename, 3);
+    EXPECT_EQ(std::filesystem::file_size(filename), 3 * sizeof(double));
+    tape.write(0.5);
+    tape.moveRight();
+    const auto values = std::array<double, 2>{-1.25, 1e300};
+    tape.writeBlock(values, Direction::Right);
+  }
+  {
+    auto tape = BasicTape<double>(filename);
+    auto values = std::array<double, 3>{};
+    tape.readBlock(values, Direction::Right);
+    EXPECT_EQ(values, (std::array<double, 3>{0.5, -1.25, 1e300}));
+  }
+  std::filesystem::remove(filename);
+
+  struct Record {
+    std::int64_t key;
+    std::array<char, 8> payload;
+  };
+  {
+    auto tape = BasicTape<Record>(filename, 2, TapeBackendType::Mmap);
+    tape.write({-7, {'a', 'b'}});
+    tape.moveRight();
+    tape.write({42, {'c'}});
+  }
+  EXPECT_EQ(std::filesystem::file_size(filename), 2 * sizeof(Record));
+  {
+    auto tape = BasicTape<Record>(filename);
+    EXPECT_EQ(tape.getCellSize(), sizeof(Record));
+    EXPECT_EQ(tape.read().key, -7);
+    EXPECT_EQ(tape.read().payload[1], 'b');
+    tape.moveRight();
+    EXPECT_EQ(tape.read().key, 42);
+  }
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(Tape, SignedInt64HeaderKeepsMinMax) {
+  constexpr auto filename = "signed_int64_header_keeps_min_max";
+  assert(!std::filesystem::remove(filename) &&
+         "File was not removed in previous test run.");
+  {
+    auto tape = BasicTape<std::int64_t>(
+        filename, 2, TapeBackendType::File, Tape::defaultReadWindowSize,
+        Tape::defaultWriteBufferSize, TapeFormat::WithHeader);
+    const auto values = std::array<std::int64_t, 2>{-(std::int64_t{1} << 40),
+                                                    std::int64_t{1} << 50};
+    tape.writeBlock(values, Direction::Right);
+    tape.markSorted(TapeOrder::Increasing);
+  }
+  {
+    const auto tape = BasicTape<std::int64_t>(filename);
+    ASSERT_TRUE(tape.getMetadata().has_value());
+    EXPECT_EQ(tape.getMetadata()->elementWidth, sizeof(std::int64_t));
+    EXPECT_EQ(tape.getMetadata()->min, -(std::int64_t{1} << 40));
+    EXPECT_EQ(tape.getMetadata()->max, std::int64_t{1} << 50);
+  }
+  std::filesystem::remove(filename);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
 // cert-err58-cpp)
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <array>
 #include <filesystem>
+#include <string>
 #include <tape_pool.hpp>
+#include <thread>
+#include <vector>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,
 // cert-err58-cpp)
@@ -213,5 +217,342 @@ TEST(TapePool, RemoveTape) {
   EXPECT_FALSE(std::filesystem::exists(filename));
 }
 
+TEST(TapePool, MemoryTapeByBackendHint) {
+  constexpr auto filename = "memory_tape_by_backend_hint";
+
+  assert(!std::filesystem::exists(filename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool();
+    auto tapeView =
+        tapePool.createTape(filename, 2, TapeBackendType::Memory);
+    EXPECT_FALSE(std::filesystem::exists(filename));
+
+    tapeView.write(42);
+    tapeView.moveRight();
+    tapeView.write(37);
+    tapeView.moveLeft();
+    EXPECT_EQ(tapeView.read(), 42);
+
+    EXPECT_THROW(tapePool.createTape(filename, 2, TapeBackendType::Memory),
+                 std::logic_error);
+    tapePool.removeTape(filename);
+
+    const auto stats = tapePool.getStatistics();
+
+    EXPECT_EQ(stats.readCnt, 1);
+    EXPECT_EQ(stats.writeCnt, 2);
+    EXPECT_EQ(stats.moveCnt, 2);
+    EXPECT_EQ(stats.removeCnt, 1);
+  }
+
+  EXPECT_FALSE(std::filesystem::exists(filename));
+}
+
+TEST(TapePool, BlocksCountAsSingleCellOperations) {
+  constexpr auto filename = "blocks_count_as_single_cell_operations";
+
+  assert(!std::filesystem::exists(filename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool();
+    auto tapeView = tapePool.createTape(filename, 5);
+
+    const auto written = std::array<std::int32_t, 5>{5, 4, 3, 2, 1};
+    tapeView.writeBlock(written, Direction::Right);
+    auto read = std::array<std::int32_t, 3>{};
+    tapeView.readBlock(read, Direction::Left);
+    EXPECT_EQ(read, (std::array<std::int32_t, 3>{1, 2, 3}));
+    tapeView.readBlock(std::span<std::int32_t>{}, Direction::Left);
+
+    const auto stats = tapePool.getStatistics();
+
+    EXPECT_EQ(stats.readCnt, 3);
+    EXPECT_EQ(stats.writeCnt, 5);
+    EXPECT_EQ(stats.moveCnt, 6);
+    EXPECT_EQ(tapeView.getPosition(), 2);
+    tapePool.removeTape(filename);
+  }
+
+  EXPECT_FALSE(std::filesystem::exists(filename));
+}
+
+TEST(TapePool, RepeatedMovesAndSeekCountSingleMoves) {
+  constexpr auto filename = "repeated_moves_and_seek_count_single_moves";
+
+  assert(!std::filesystem::exists(filename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool();
+    auto tapeView = tapePool.createTape(filename, 10);
+
+    tapeView.moveRightRepeated(9);
+    EXPECT_EQ(tapeView.getPosition(), 9);
+    tapeView.moveLeftRepeated(4);
+    EXPECT_EQ(tapeView.getPosition(), 5);
+    tapeView.seek(1);
+    EXPECT_EQ(tapeView.getPosition(), 1);
+    tapeView.seek(8);
+    EXPECT_EQ(tapeView.getPosition(), 8);
+    tapeView.seek(8);
+
+    EXPECT_THROW(tapeView.moveRightRepeated(2), Tape::RightOutOfRange);
+    EXPECT_THROW(tapeView.moveLeftRepeated(9), Tape::LeftOutOfRange);
+    EXPECT_THROW(tapeView.seek(10), Tape::RightOutOfRange);
+    EXPECT_EQ(tapeView.getPosition(), 8);
+
+    EXPECT_EQ(tapePool.getStatistics().moveCnt, 9 + 4 + 4 + 7);
+    tapePool.removeTape(filename);
+  }
+
+  EXPECT_FALSE(std::filesystem::exists(filename));
+}
+
+TEST(TapePool, MmapWriteCloseOpenRead) {
+  constexpr auto filename = "mmap_tape_write_close_open_read";
+
+  assert(!std::filesystem::exists(filename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool(TapeBackendType::Mmap);
+    auto writingView = tapePool.createTape(filename, 3);
+
+    writingView.write(42);
+    writingView.moveRight();
+    writingView.write(37);
+    writingView.moveRight();
+    writingView.write(73);
+    tapePool.closeTape(filename);
+
+    auto readingView = tapePool.openTape(filename);
+
+    EXPECT_EQ(readingView.read(), 42);
+    readingView.moveRight();
+    EXPECT_EQ(readingView.read(), 37);
+    readingView.moveRight();
+    EXPECT_EQ(readingView.read(), 73);
+
+    const auto stats = tapePool.getStatistics();
+
+    EXPECT_EQ(stats.readCnt, 3);
+    EXPECT_EQ(stats.writeCnt, 3);
+    EXPECT_EQ(stats.moveCnt, 4);
+    EXPECT_EQ(stats.createCnt, 1);
+    EXPECT_EQ(stats.openCnt, 1);
+    EXPECT_EQ(stats.closeCnt, 1);
+  }
+
+  std::filesystem::remove(filename);
+}
+
+TEST(TapePool, CacheStatisticsOfClosedTapesAreKept) {
+  constexpr auto filename = "cache_statistics_of_closed_tapes_are_kept";
+
+  assert(!std::filesystem::exists(filename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool(TapeBackendType::File, TapeBackendType::File, 2);
+    auto tapeView = tapePool.createTape(filename, 4);
+
+    tapeView.write(42);
+    tapeView.moveRight();
+    tapeView.write(37);
+
+    EXPECT_EQ(tapeView.read(), 37);
+    tapeView.moveLeft();
+    EXPECT_EQ(tapeView.read(), 42);
+
+    tapePool.closeTape(filename);
+
+    const auto stats = tapePool.getCacheStatistics();
+
+    EXPECT_EQ(stats.missCnt, 1);
+    EXPECT_EQ(stats.hitCnt, 1);
+  }
+
+  std::filesystem::remove(filename);
+}
+
+TEST(TapePool, BufferedWritesReachFileOnFlushAndClose) {
+  constexpr auto filename = "buffered_writes_reach_file_on_flush_and_close";
+
+  assert(!std::filesystem::exists(filename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool();
+    auto writingView = tapePool.createTape(filename, 2);
+    writingView.write(42);
+    writingView.flush();
+
+    EXPECT_EQ(TapePool().openTape(filename).read(), 42);
+
+    writingView.moveRight();
+    writingView.write(37);
+    tapePool.closeTape(filename);
+
+    auto readingView = tapePool.openTape(filename);
+    readingView.moveRight();
+    EXPECT_EQ(readingView.read(), 37);
+
+    const auto stats = tapePool.getStatistics();
+
+    EXPECT_EQ(stats.writeCnt, 2);
+    EXPECT_EQ(stats.readCnt, 1);
+  }
+
+  std::filesystem::remove(filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(TapePool, MixedElementTypes) {
+  constexpr auto intFilename = "mixed_element_types_int";
+  constexpr auto doubleFilename = "mixed_element_types_double";
+
+  assert(!std::filesystem::exists(intFilename) &&
+         !std::filesystem::exists(doubleFilename) &&
+         "Tape file was not removed on previous tests run.");
+
+  {
+    auto tapePool = TapePool();
+    auto intView = tapePool.createTape(intFilename, 1);
+    auto doubleView = tapePool.createTape<double>(doubleFilename, 1);
+    intView.write(3);
+    doubleView.write(2.5);
+
+    EXPECT_EQ(tapePool.getOpenedTape(intFilename).read(), 3);
+    EXPECT_EQ(tapePool.getOpenedTape<double>(doubleFilename).read(), 2.5);
+    EXPECT_THROW(tapePool.getOpenedTape(doubleFilename), std::logic_error);
+    EXPECT_THROW(tapePool.getOrOpenTape<std::int64_t>(intFilename),
+                 std::logic_error);
+
+    const auto stats = tapePool.getStatistics();
+    EXPECT_EQ(stats.writeCnt, 2);
+    EXPECT_EQ(stats.readCnt, 2);
+  }
+
+  std::filesystem::remove(intFilename);
+  std::filesystem::remove(doubleFilename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(TapePool, ConcurrentThreadsCountEveryOperation) {
+  // More threads than owned counters shards, so some share the last one.
+  constexpr std::size_t threadsCnt =
+      TapePoolStatisticsBase::countersShardsCnt + 8;
+  constexpr std::size_t tapesPerThread = 20;
+  constexpr std::size_t tapeSize = 50;
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  {
+    auto threads = std::vector<std::jthread>{};
+    for (std::size_t threadIdx = 0; threadIdx < threadsCnt; ++threadIdx) {
+      threads.emplace_back([&tapePool, threadIdx]() {
+        for (std::size_t i = 0; i < tapesPerThread; ++i) {
+          const auto filename = "concurrent_tape_" +
+                                std::to_string(threadIdx) + "_" +
+                                std::to_string(i);
+          auto tape = tapePool.createTape(filename, tapeSize);
+          for (std::size_t j = 0; j < tapeSize; ++j) {
+            tape.write(static_cast<std::int32_t>(j));
+            if (j + 1 != tapeSize) {
+              tape.moveRight();
+            }
+          }
+          auto sameTape = tapePool.getOpenedTape(filename);
+          EXPECT_EQ(sameTape.read(), tapeSize - 1);
+          tapePool.removeTape(filename);
+        }
+      });
+    }
+  }
+  const auto stats = tapePool.getStatistics();
+  const std::size_t tapesCnt = threadsCnt * tapesPerThread;
+  EXPECT_EQ(stats.createCnt, tapesCnt);
+  EXPECT_EQ(stats.removeCnt, tapesCnt);
+  EXPECT_EQ(stats.writeCnt, tapesCnt * tapeSize);
+  EXPECT_EQ(stats.moveCnt, tapesCnt * (tapeSize - 1));
+  EXPECT_EQ(stats.readCnt, tapesCnt);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(TapePool, HandleOfClosedTapeIsInvalid) {
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  const auto handle = tapePool.createTape("handle_tape", 3).getHandle();
+  ASSERT_EQ(tapePool.findTape("handle_tape"), handle);
+  EXPECT_TRUE(tapePool.isOpened(handle));
+  EXPECT_EQ(tapePool.getOpenedTape(handle).getSize(), 3);
+
+  tapePool.closeTape(handle);
+  EXPECT_FALSE(tapePool.isOpened(handle));
+  EXPECT_FALSE(tapePool.findTape("handle_tape").has_value());
+  EXPECT_THROW(tapePool.getOpenedTape(handle), std::logic_error);
+  EXPECT_THROW(tapePool.closeTape(handle), std::logic_error);
+
+  // The slot is reused by a new tape with another generation.
+  const auto newHandle = tapePool.createTape("handle_tape", 5).getHandle();
+  EXPECT_EQ(newHandle.index, handle.index);
+  EXPECT_NE(newHandle.generation, handle.generation);
+  EXPECT_FALSE(tapePool.isOpened(handle));
+  EXPECT_EQ(tapePool.getOpenedTape(newHandle).getSize(), 5);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(TapePool, RemoveTapeByHandle) {
+  constexpr auto filename = "remove_tape_by_handle";
+  std::filesystem::remove(filename);
+  auto tapePool = TapePool();
+  const auto handle = tapePool.createTape(filename, 4).getHandle();
+  ASSERT_TRUE(std::filesystem::exists(filename));
+  tapePool.removeTape(handle);
+  EXPECT_FALSE(std::filesystem::exists(filename));
+  EXPECT_EQ(tapePool.getStatistics().removeCnt, 1);
+  EXPECT_THROW(tapePool.removeTape(handle), std::logic_error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(TapePool, ThousandsOfTapesByHandles) {
+  constexpr std::size_t tapesCnt = 5000;
+  auto tapePool = TapePool(TapeBackendType::Memory, TapeBackendType::Memory);
+  auto handles = std::vector<TapeHandle>{};
+  for (std::size_t i = 0; i < tapesCnt; ++i) {
+    handles.push_back(
+        tapePool.createTape("many_tapes_" + std::to_string(i), 1)
+            .getHandle());
+  }
+  for (std::size_t i = 0; i < tapesCnt; ++i) {
+    tapePool.getOpenedTape(handles[i]).write(static_cast<std::int32_t>(i));
+  }
+  for (std::size_t i = 0; i < tapesCnt; ++i) {
+    EXPECT_EQ(tapePool.getOpenedTape(handles[i]).read(), i);
+    tapePool.removeTape(handles[i]);
+  }
+  const auto stats = tapePool.getStatistics();
+  EXPECT_EQ(stats.createCnt, tapesCnt);
+  EXPECT_EQ(stats.removeCnt, tapesCnt);
+  EXPECT_EQ(stats.writeCnt, tapesCnt);
+  EXPECT_EQ(stats.readCnt, tapesCnt);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST(TapePool, CloseReportsHeaderWriteError) {
+  constexpr auto filename = "close_reports_header_write_error";
+  std::filesystem::remove(filename);
+  auto tapePool = TapePool();
+  auto tape = tapePool.createTape(filename, 2, std::nullopt,
+                                  TapeFormat::WithHeader);
+  tape.markSorted(TapeOrder::Increasing);
+  std::filesystem::remove(filename);
+  EXPECT_THROW(tapePool.closeTape(tape.getHandle()), std::runtime_error);
+  // The tape stays opened and is destroyed without throwing.
+  EXPECT_TRUE(tapePool.isOpened(tape.getHandle()));
+  tapePool.removeTape(tape.getHandle());
+  EXPECT_FALSE(tapePool.isOpened(tape.getHandle()));
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,
 // cert-err58-cpp)